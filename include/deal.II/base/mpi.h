@@ -625,6 +625,33 @@ namespace Utilities
         const MPI_Comm &          mpi_communicator,
         const ArrayView<T> &      sums);
 
+    /**
+     * Like the previous function, but only start the summation by a
+     * non-blocking MPI_Iallreduce and return immediately. The contents of @p
+     * sums are only valid once @p request has been completed with
+     * wait_for_request(). This allows to overlap the global reduction with
+     * local work, e.g., a matrix-vector product in a pipelined Krylov solver.
+     *
+     * The arrays must not be modified or deallocated until the request has
+     * been completed. Input and output arrays may be the same. If MPI is not
+     * available or not initialized, the result is available immediately and
+     * @p request is set to MPI_REQUEST_NULL.
+     */
+    template <typename T>
+    void
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums,
+         MPI_Request &             request);
+
+    /**
+     * Complete the non-blocking operation identified by @p request, e.g.,
+     * one started by isum(). Does nothing if @p request equals
+     * MPI_REQUEST_NULL. Upon return, @p request is set to MPI_REQUEST_NULL.
+     */
+    void
+    wait_for_request(MPI_Request &request);
+
     /**
      * Perform an MPI sum of the entries of a symmetric tensor.
      *
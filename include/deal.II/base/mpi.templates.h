@@ -183,6 +183,39 @@ namespace Utilities
 
 
 
+    template <typename T>
+    void
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums,
+         MPI_Request &             request)
+    {
+      AssertDimension(values.size(), sums.size());
+#ifdef DEAL_II_WITH_MPI
+      if (job_supports_mpi())
+        {
+          const int ierr =
+            MPI_Iallreduce(values != sums ? values.data() : MPI_IN_PLACE,
+                           static_cast<void *>(sums.data()),
+                           static_cast<int>(values.size()),
+                           mpi_type_id_for_type<decltype(*values.data())>,
+                           MPI_SUM,
+                           mpi_communicator,
+                           &request);
+          AssertThrowMPI(ierr);
+        }
+      else
+#endif
+        {
+          (void)mpi_communicator;
+          if (values != sums)
+            std::copy(values.begin(), values.end(), sums.begin());
+          request = MPI_REQUEST_NULL;
+        }
+    }
+
+
+
     template <int rank, int dim, typename Number>
     Tensor<rank, dim, Number>
     sum(const Tensor<rank, dim, Number> &t, const MPI_Comm &mpi_communicator)
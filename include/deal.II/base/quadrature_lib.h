@@ -889,6 +889,40 @@ public:
                    const unsigned int     n_copies);
 };
 
+/**
+ * Conical product rule for simplex entities as described by A. H. Stroud,
+ * "Approximate calculation of multiple integrals", Prentice Hall, 1971.
+ *
+ * The reference simplex is mapped onto the unit hypercube by the collapsed
+ * coordinates (Duffy transformation) $x = a(1-b)(1-c)$, $y = b(1-c)$, $z = c$
+ * in 3D and $x = a(1-b)$, $y = b$ in 2D, with the collapsed vertex at the
+ * last unit vector. The quadrature points are the tensor product of
+ * `n_points_1D` points in each of the collapsed coordinates: Gauss points in
+ * $a$ and Gauss-Jacobi points for the weight functions $(1-b)$ and
+ * $(1-c)^2$ in the other directions, which absorb the Jacobian of the
+ * transformation. The formula integrates polynomials up to total degree
+ * $2n-1$ exactly with $n^d$ points, i.e., more points than QGaussSimplex for
+ * the same degree. In exchange, the points are numbered lexicographically in
+ * the collapsed coordinates with $a$ running fastest, which allows
+ * MatrixFree to evaluate derivatives of FE_SimplexP and FE_SimplexDGP with
+ * sum factorization.
+ *
+ * For 1D, the quadrature rule degenerates to a
+ * `dealii::QGauss<1>(n_points_1D)`.
+ *
+ * @ingroup simplex
+ */
+template <int dim>
+class QStroudSimplex : public QSimplex<dim>
+{
+public:
+  /**
+   * Constructor taking the number of quadrature points in each of the
+   * collapsed coordinates.
+   */
+  explicit QStroudSimplex(const unsigned int n_points_1D);
+};
+
 /**
  * Integration rule for wedge entities.
  */
@@ -904,6 +938,23 @@ public:
   explicit QGaussWedge(const unsigned int n_points_1D);
 };
 
+/**
+ * Integration rule for wedge entities, given by the tensor product of
+ * QStroudSimplex<2> on the triangle and QGauss<1> in the extruded direction.
+ * In contrast to QGaussWedge, the points form a tensor product in the
+ * collapsed coordinates of the wedge, see QStroudSimplex.
+ */
+template <int dim>
+class QStroudWedge : public Quadrature<dim>
+{
+public:
+  /**
+   * Constructor taking the number of quadrature points in each of the
+   * collapsed coordinates.
+   */
+  explicit QStroudWedge(const unsigned int n_points_1D);
+};
+
 /**
  * Integration rule for pyramid entities.
  */
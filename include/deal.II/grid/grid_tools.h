@@ -436,6 +436,50 @@ namespace GridTools
                              std::vector<unsigned int> &   considered_vertices,
                              const double                  tol = 1e-12);
 
+  /**
+   * Renumber the cells and the vertices of a coarse mesh description along a
+   * Hilbert space filling curve. Mesh generators and files written by them
+   * often list cells and vertices in an order that has little to do with
+   * their position in space, such that neighboring cells are far apart in
+   * the cell list and the vertices of a cell are far apart in the vertex
+   * list. Since the Triangulation class keeps the order of the coarse cells
+   * and vertices it is given, and since the cells of all finer levels, the
+   * active cell indices and the DoFHandler numbering follow the order of the
+   * coarse cells, loops over the cells of such a mesh access memory in an
+   * essentially random pattern. This function improves the locality of
+   * these accesses:
+   * - The cells are sorted by the index of their center (the average of
+   *   their vertices) along the Hilbert curve computed by
+   *   Utilities::inverse_Hilbert_space_filling_curve().
+   * - The vertices are numbered in the order in which the sorted cells
+   *   reference them for the first time, such that the vertices of
+   *   consecutive cells are close in memory as well.
+   *
+   * The vertex indices in @p subcelldata are renumbered accordingly, and
+   * all other data of the cells (material ids, manifold ids, and so on) are
+   * moved along with the cells. Vertices not referenced by any of the cells
+   * are kept and numbered after all used vertices, in their original order;
+   * call delete_unused_vertices() to remove them. The function can be used
+   * with the output of get_coarse_mesh_description() for a triangulation
+   * that has not been refined yet:
+   * @code
+   *   auto [vertices, cells, subcelldata] =
+   *     GridTools::get_coarse_mesh_description(triangulation);
+   *   GridTools::reorder_cells_and_vertices_hilbert(vertices,
+   *                                                 cells,
+   *                                                 subcelldata);
+   *   triangulation.clear();
+   *   triangulation.create_triangulation(vertices, cells, subcelldata);
+   * @endcode
+   * Note that Triangulation::clear() also removes all manifolds attached
+   * to the triangulation, which need to be set again afterwards.
+   */
+  template <int dim, int spacedim>
+  void
+  reorder_cells_and_vertices_hilbert(std::vector<Point<spacedim>> &vertices,
+                                     std::vector<CellData<dim>> &  cells,
+                                     SubCellData &                 subcelldata);
+
   /**
    * Grids generated by grid generators may have an orientation of cells which
    * is the inverse of the orientation required by deal.II.
@@ -1022,6 +1066,58 @@ namespace GridTools
       &cell_hint =
         typename Triangulation<dim, spacedim>::active_cell_iterator());
 
+  /**
+   * This function computes the same information as
+   * compute_point_locations_try_all(), but is designed for large sets of
+   * points. Rather than searching the cell around each point separately,
+   * which involves one call to Mapping::transform_real_to_unit_cell() per
+   * point and per cell tried, the function proceeds in batches:
+   * - For each point, the candidate cells are the cells whose bounding box,
+   *   as stored in GridTools::Cache::get_cell_bounding_boxes_rtree(),
+   *   contains the point. They are sorted by the distance between the point
+   *   and the center of the box.
+   * - In each round, the points that have not been found yet are grouped by
+   *   their next candidate cell, and all points of a group are transformed
+   *   to the reference cell with a single call to
+   *   Mapping::transform_points_real_to_unit_cell(). For MappingQ, this
+   *   call evaluates the geometry of the cell only once and runs the Newton
+   *   iteration for several points at a time using the lanes of
+   *   VectorizedArray. A point is assigned to the candidate cell if its
+   *   reference position lies inside the reference cell up to the given
+   *   @p tolerance.
+   * - The search for the candidate cells and the transformations of the
+   *   different groups are run in parallel using the task-based
+   *   parallelism of the library.
+   * - Points that are not found in any of their candidate cells, e.g.
+   *   because they lie outside of the bounding box of a cell described by a
+   *   curved high-order mapping or outside of the box only by less than
+   *   @p tolerance, are searched with find_active_cell_around_point() as a
+   *   fallback, again in parallel.
+   *
+   * The result has the same format as the one of
+   * compute_point_locations_try_all(). The cells are sorted by their
+   * active cell index, the points within each cell by their index in
+   * @p points, and the missing points are sorted by their index as well.
+   * For points that lie on the boundary between several cells, the cell
+   * chosen by this function may differ from the one chosen by
+   * compute_point_locations_try_all().
+   *
+   * @note This function is not implemented for the codimension one case (<tt>spacedim != dim</tt>).
+   */
+  template <int dim, int spacedim>
+#ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#else
+  return_type
+#endif
+  compute_point_locations_batched(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points,
+                                  const double tolerance = 1e-10);
+
   /**
    * Given a @p cache and a list of
    * @p local_points for each process, find the points lying on the locally
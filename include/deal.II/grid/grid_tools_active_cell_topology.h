@@ -0,0 +1,324 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_grid_grid_tools_active_cell_topology_h
+#define dealii_grid_grid_tools_active_cell_topology_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/std_cxx20/iota_view.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  /**
+   * A read-only snapshot of the topology of the active cells of a
+   * Triangulation, stored in flat arrays.
+   *
+   * Querying the vertices or neighbors of a cell through the accessor
+   * classes involves several indirections into the data structures of the
+   * Triangulation, which store the information per level and per object
+   * type (the neighbors as pairs of level and index, the faces of a cell by
+   * their index in the list of faces, and so on). For loops that visit all
+   * active cells many times without changing the mesh, e.g. in assembly,
+   * error estimation or the setup of graphs, this class collects the
+   * relevant information once into contiguous arrays that are indexed by
+   * CellAccessor::active_cell_index():
+   * - the global indices of the vertices of each cell,
+   * - the active cell indices of the neighbors behind each face, including
+   *   all the children of a neighbor that is more refined than the present
+   *   cell, and
+   * - the combined orientation flag of each face of each cell as returned
+   *   by TriaAccessor::combined_face_orientation().
+   *
+   * The data is stored in compressed-row format, so the class also works
+   * for meshes with different reference cells. A typical loop reads
+   * @code
+   *   const GridTools::ActiveCellTopology<dim> topology(triangulation);
+   *   for (const unsigned int cell : topology.cell_indices())
+   *     for (const unsigned int f : topology.face_indices(cell))
+   *       for (const unsigned int neighbor : topology.face_neighbors(cell, f))
+   *         ...
+   * @endcode
+   *
+   * The object is not updated when the triangulation changes. One needs to
+   * call reinit() after a change of the mesh, or use
+   * GridTools::Cache::get_active_cell_topology(), which rebuilds the object
+   * only when the triangulation has changed. The neighbors across periodic
+   * faces are not included, i.e., the function face_neighbors() returns an
+   * empty list for all faces for which CellAccessor::at_boundary() returns
+   * true.
+   */
+  template <int dim, int spacedim = dim>
+  class ActiveCellTopology : public Subscriptor
+  {
+  public:
+    /**
+     * Default constructor. Call reinit() before using the object.
+     */
+    ActiveCellTopology() = default;
+
+    /**
+     * Constructor. Calls reinit() with the given triangulation.
+     */
+    explicit ActiveCellTopology(const Triangulation<dim, spacedim> &tria);
+
+    /**
+     * Extract the topology of the active cells of the given triangulation.
+     * The triangulation must not be changed as long as this object is in
+     * use.
+     */
+    void
+    reinit(const Triangulation<dim, spacedim> &tria);
+
+    /**
+     * Return the number of active cells, which is the same as
+     * Triangulation::n_active_cells() at the time of the last call to
+     * reinit().
+     */
+    unsigned int
+    n_cells() const;
+
+    /**
+     * Return a range over the indices of all active cells, i.e., the numbers
+     * from zero to n_cells(). The indices coincide with
+     * CellAccessor::active_cell_index().
+     */
+    std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+    cell_indices() const;
+
+    /**
+     * Return an iterator to the active cell with the given index.
+     */
+    typename Triangulation<dim, spacedim>::active_cell_iterator
+    cell_iterator(const unsigned int cell) const;
+
+    /**
+     * Return the global indices of the vertices of the given cell, in the
+     * order of TriaAccessor::vertex_index().
+     */
+    ArrayView<const unsigned int>
+    vertex_indices(const unsigned int cell) const;
+
+    /**
+     * Return the number of faces of the given cell.
+     */
+    unsigned int
+    n_faces(const unsigned int cell) const;
+
+    /**
+     * Return a range over the face numbers of the given cell.
+     */
+    std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+    face_indices(const unsigned int cell) const;
+
+    /**
+     * Return the active cell indices of the cells behind the given face of a
+     * cell. The list is empty at the boundary, contains one entry if the
+     * neighbor is on the same or a coarser level, and one entry per child
+     * of the face if the neighbor is refined, in the order of
+     * CellAccessor::neighbor_child_on_subface().
+     */
+    ArrayView<const unsigned int>
+    face_neighbors(const unsigned int cell, const unsigned int face) const;
+
+    /**
+     * Return whether the given face of a cell is at the boundary.
+     */
+    bool
+    at_boundary(const unsigned int cell, const unsigned int face) const;
+
+    /**
+     * Return the combined orientation flag of the given face of a cell, as
+     * returned by TriaAccessor::combined_face_orientation().
+     */
+    unsigned char
+    combined_face_orientation(const unsigned int cell,
+                              const unsigned int face) const;
+
+    /**
+     * Return an estimate of the memory consumption of this object in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * A pointer to the Triangulation.
+     */
+    SmartPointer<const Triangulation<dim, spacedim>,
+                 ActiveCellTopology<dim, spacedim>>
+      tria;
+
+    /**
+     * The level and the index within the level of each active cell, used to
+     * construct iterators.
+     */
+    std::vector<std::pair<unsigned int, unsigned int>> cell_level_index;
+
+    /**
+     * The offsets into the vertex_indices_data field for each cell. The
+     * field has n_cells()+1 entries.
+     */
+    std::vector<unsigned int> vertex_offsets;
+
+    /**
+     * The global vertex indices of all cells.
+     */
+    std::vector<unsigned int> vertex_indices_data;
+
+    /**
+     * The offsets of the faces of each cell into the fields
+     * face_neighbor_offsets and face_orientations. The field has
+     * n_cells()+1 entries.
+     */
+    std::vector<unsigned int> face_offsets;
+
+    /**
+     * The offsets of each face into the face_neighbors_data field.
+     */
+    std::vector<unsigned int> face_neighbor_offsets;
+
+    /**
+     * The active cell indices of the neighbors behind all faces.
+     */
+    std::vector<unsigned int> face_neighbors_data;
+
+    /**
+     * The combined orientation flag of all faces of all cells.
+     */
+    std::vector<unsigned char> face_orientations;
+  };
+
+
+
+  // ------------------------------- inline functions ----------------------
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  ActiveCellTopology<dim, spacedim>::n_cells() const
+  {
+    return cell_level_index.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  ActiveCellTopology<dim, spacedim>::cell_indices() const
+  {
+    return {0U, n_cells()};
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline typename Triangulation<dim, spacedim>::active_cell_iterator
+  ActiveCellTopology<dim, spacedim>::cell_iterator(
+    const unsigned int cell) const
+  {
+    AssertIndexRange(cell, n_cells());
+    return typename Triangulation<dim, spacedim>::active_cell_iterator(
+      &*tria, cell_level_index[cell].first, cell_level_index[cell].second);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<const unsigned int>
+  ActiveCellTopology<dim, spacedim>::vertex_indices(
+    const unsigned int cell) const
+  {
+    AssertIndexRange(cell, n_cells());
+    return make_array_view(vertex_indices_data.data() + vertex_offsets[cell],
+                           vertex_indices_data.data() +
+                             vertex_offsets[cell + 1]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  ActiveCellTopology<dim, spacedim>::n_faces(const unsigned int cell) const
+  {
+    AssertIndexRange(cell, n_cells());
+    return face_offsets[cell + 1] - face_offsets[cell];
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  ActiveCellTopology<dim, spacedim>::face_indices(
+    const unsigned int cell) const
+  {
+    return {0U, n_faces(cell)};
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<const unsigned int>
+  ActiveCellTopology<dim, spacedim>::face_neighbors(
+    const unsigned int cell,
+    const unsigned int face) const
+  {
+    AssertIndexRange(face, n_faces(cell));
+    const unsigned int index = face_offsets[cell] + face;
+    return make_array_view(face_neighbors_data.data() +
+                             face_neighbor_offsets[index],
+                           face_neighbors_data.data() +
+                             face_neighbor_offsets[index + 1]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline bool
+  ActiveCellTopology<dim, spacedim>::at_boundary(const unsigned int cell,
+                                                 const unsigned int face) const
+  {
+    return face_neighbors(cell, face).size() == 0;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline unsigned char
+  ActiveCellTopology<dim, spacedim>::combined_face_orientation(
+    const unsigned int cell,
+    const unsigned int face) const
+  {
+    AssertIndexRange(face, n_faces(cell));
+    return face_orientations[face_offsets[cell] + face];
+  }
+} // namespace GridTools
+
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
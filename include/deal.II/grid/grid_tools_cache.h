@@ -25,6 +25,7 @@
 
 #include <deal.II/fe/mapping_q1.h>
 
+#include <deal.II/grid/grid_tools_active_cell_topology.h>
 #include <deal.II/grid/grid_tools_cache_update_flags.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
@@ -60,6 +61,25 @@ namespace GridTools
    * some vertex locations, then some of the structures in this class become
    * obsolete, and you will have to mark them as outdated, by calling the
    * method mark_for_update() manually.
+   *
+   * For triangulations that are not derived from
+   * parallel::TriangulationBase, the objects returned by
+   * get_vertex_to_cell_map(), get_used_vertices(), get_used_vertices_rtree()
+   * and get_cell_bounding_boxes_rtree() are not rebuilt from scratch after
+   * Triangulation::execute_coarsening_and_refinement(). Instead, the class
+   * listens to the Triangulation::Signals::pre_coarsening_on_cell and
+   * Triangulation::Signals::post_refinement_on_cell signals and, at the end
+   * of the refinement cycle, only removes the entries of the cells that are
+   * no longer active and inserts the entries of the new active cells (and
+   * of the vertices around them). The cost of this update is proportional
+   * to the number of cells that changed rather than to the size of the
+   * mesh, which pays off when only a small fraction of the cells is refined
+   * or coarsened in each cycle. Note that the R-trees are built with the
+   * packing algorithm, whose trees are somewhat faster to query than the
+   * ones obtained by inserting elements one by one, so the query speed of
+   * the trees can slowly deteriorate over many cycles; calling
+   * mark_for_update() with the corresponding flags rebuilds them. All other
+   * objects are rebuilt when they are requested next, as before.
    */
   template <int dim, int spacedim = dim>
   class Cache : public Subscriptor
@@ -163,6 +183,15 @@ namespace GridTools
     const std::vector<std::set<unsigned int>> &
     get_vertex_to_neighbor_subdomain() const;
 
+    /**
+     * Return the cached flat representation of the vertices, neighbors and
+     * face orientations of the active cells, see
+     * GridTools::ActiveCellTopology. The object is only rebuilt when the
+     * triangulation has changed.
+     */
+    const ActiveCellTopology<dim, spacedim> &
+    get_active_cell_topology() const;
+
     /**
      * Return a reference to the stored triangulation.
      */
@@ -208,6 +237,34 @@ namespace GridTools
     get_covering_rtree(const unsigned int level = 0) const;
 
   private:
+    /**
+     * Prepare the incremental update of the cached objects at the beginning
+     * of a refinement cycle of the triangulation.
+     */
+    void
+    pre_refinement();
+
+    /**
+     * Record that the children of the given cell are going to be removed.
+     */
+    void
+    pre_coarsening_on_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Record that the given cell has just been refined.
+     */
+    void
+    post_refinement_on_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Update the cached objects that support it with the changes recorded
+     * during the refinement cycle, and mark all others for update.
+     */
+    void
+    post_refinement();
+
     /**
      * Keep track of what needs to be updated next.
      */
@@ -287,10 +344,59 @@ namespace GridTools
      */
     mutable std::vector<std::set<unsigned int>> vertex_to_neighbor_subdomain;
 
+    /**
+     * Store the flat topology of the active cells.
+     */
+    mutable ActiveCellTopology<dim, spacedim> active_cell_topology;
+
+    /**
+     * The objects that are brought up to date incrementally during the
+     * present refinement cycle, or update_nothing outside of a refinement
+     * cycle.
+     */
+    CacheUpdateFlags incremental_update_flags;
+
+    /**
+     * Whether the next Triangulation::Signals::any_change signal is the one
+     * triggered at the end of a refinement cycle that has already been dealt
+     * with by post_refinement().
+     */
+    bool refinement_handled;
+
+    /**
+     * The cells that were active at the beginning of the refinement cycle
+     * but are no longer active at its end, together with their bounding
+     * boxes, which are only computed if the R-tree of the cell bounding
+     * boxes is updated incrementally.
+     */
+    std::vector<std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                          BoundingBox<spacedim>>>
+      removed_cells;
+
+    /**
+     * The cells that become active during the refinement cycle, namely the
+     * parents of coarsened cells and the children of refined cells. The
+     * latter are stored by their parent.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      coarsened_cells, refined_cells;
+
+    /**
+     * The vertices, including hanging vertices, of the cells in
+     * removed_cells, collected before these cells are deleted.
+     */
+    std::vector<unsigned int> affected_vertices;
+
     /**
      * Storage for the status of the triangulation signal.
      */
     boost::signals2::connection tria_signal;
+
+    /**
+     * Storage for the status of the signals used for the incremental update
+     * of the cached objects during refinement.
+     */
+    std::vector<boost::signals2::connection> refinement_signals;
   };
 
 
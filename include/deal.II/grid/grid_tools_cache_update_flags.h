@@ -84,6 +84,12 @@ namespace GridTools
      */
     update_vertex_to_neighbor_subdomain = 0x100,
 
+    /**
+     * Update the flat topology of the active cells, see
+     * GridTools::ActiveCellTopology.
+     */
+    update_active_cell_topology = 0x200,
+
     /**
      * Update all objects.
      */
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/subscriptor.h>
@@ -382,6 +383,14 @@ namespace internal
        */
       std::vector<number> vector_values;
 
+      /**
+       * The permutation that sorts the local indices of the last cell
+       * written by the batched variant of distribute_local_to_global(). It is
+       * kept from one cell to the next because cells with the same relative
+       * order of their indices can reuse it without sorting again.
+       */
+      std::vector<unsigned int> local_dof_permutation;
+
       /**
        * Data array for reorder row/column indices.
        */
@@ -392,6 +401,77 @@ namespace internal
        */
       GlobalRowsFromLocal<number> global_columns;
     };
+
+
+
+    /**
+     * The constraint lines of an AffineConstraints object in compressed row
+     * storage, i.e., with the constrained indices, the inhomogeneities, and
+     * the entries of all lines stored in contiguous arrays. This format is
+     * set up when closing the AffineConstraints object and allows to run
+     * through the constraints in distribute() and set_zero() with unit-stride
+     * access, rather than visiting a separately allocated list of entries for
+     * each line. Since the entries of the lines of a closed AffineConstraints
+     * object only refer to indices that are not constrained themselves, the
+     * lines can be processed independently of each other and hence in
+     * parallel.
+     */
+    template <typename number>
+    struct CompressedConstraintLines
+    {
+      /**
+       * Fill the arrays from the given list of constraint lines.
+       */
+      template <typename ConstraintLineType>
+      void
+      reinit(const std::vector<ConstraintLineType> &lines);
+
+      /**
+       * Clear all arrays.
+       */
+      void
+      clear();
+
+      /**
+       * Return the number of constraint lines.
+       */
+      size_type
+      size() const;
+
+      /**
+       * Return an estimate for the memory consumption in bytes.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * The index of the constrained degree of freedom of each line.
+       */
+      std::vector<size_type> constrained_indices;
+
+      /**
+       * The inhomogeneity of each line.
+       */
+      std::vector<number> inhomogeneities;
+
+      /**
+       * The start of the entries of each line within the arrays
+       * #column_indices and #weights. The entries of line @p i are located
+       * in the range <tt>[row_starts[i], row_starts[i+1])</tt>.
+       */
+      std::vector<std::size_t> row_starts;
+
+      /**
+       * The indices of the degrees of freedom that the lines are constrained
+       * to.
+       */
+      std::vector<size_type> column_indices;
+
+      /**
+       * The weights of the entries of the lines.
+       */
+      std::vector<number> weights;
+    };
   } // namespace AffineConstraints
 } // namespace internal
 
@@ -1464,6 +1544,47 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Like the previous function, but for a batch of cells at once, e.g., the
+   * cells of a chunk of WorkStream::run(). The i-th entries of @p
+   * local_matrices, @p local_vectors, and @p local_dof_indices describe the
+   * contributions of one cell. @p local_vectors may be empty if @p
+   * global_vector has size zero, in which case only the matrix is written.
+   *
+   * The contributions of cells none of whose indices are constrained (the
+   * common case for the interior of the domain) are written without going
+   * through the machinery that resolves the constraints: The indices are
+   * sorted once per cell and each local row is added to the global matrix
+   * with sorted column indices. The sorting permutation is reused for the
+   * next cell if the indices of that cell are in the same relative order,
+   * which is often the case for cells of the same type with a regular
+   * enumeration of the degrees of freedom. All other cells are written via
+   * the function above, giving the same result.
+   *
+   * The thread-safety considerations of the function above apply also to
+   * this function.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const Vector<number>> &         local_vectors,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                    global_matrix,
+    VectorType &                                    global_vector,
+    bool use_inhomogeneities_for_rhs = false) const;
+
+  /**
+   * Like the previous function, but only write the matrix contributions of a
+   * batch of cells.
+   */
+  template <typename MatrixType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                    global_matrix) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1933,6 +2054,14 @@ private:
    */
   bool sorted;
 
+  /**
+   * The content of #lines in compressed row storage, which is used by
+   * distribute() and set_zero(). This field is filled by close() and is only
+   * valid if #sorted is true.
+   */
+  internal::AffineConstraints::CompressedConstraintLines<number>
+    compressed_lines;
+
   mutable Threads::ThreadLocalStorage<
     internal::AffineConstraints::ScratchData<number>>
     scratch_data;
@@ -2034,6 +2163,66 @@ private:
 
 /* ---------------- template and inline functions ----------------- */
 
+namespace internal
+{
+  namespace AffineConstraints
+  {
+    template <typename number>
+    template <typename ConstraintLineType>
+    inline void
+    CompressedConstraintLines<number>::reinit(
+      const std::vector<ConstraintLineType> &lines)
+    {
+      constrained_indices.resize(lines.size());
+      inhomogeneities.resize(lines.size());
+      row_starts.resize(lines.size() + 1);
+      row_starts[0] = 0;
+      for (size_type i = 0; i < lines.size(); ++i)
+        {
+          constrained_indices[i] = lines[i].index;
+          inhomogeneities[i]     = lines[i].inhomogeneity;
+          row_starts[i + 1]      = row_starts[i] + lines[i].entries.size();
+        }
+
+      column_indices.resize(row_starts.back());
+      weights.resize(row_starts.back());
+      for (size_type i = 0; i < lines.size(); ++i)
+        {
+          std::size_t k = row_starts[i];
+          for (const auto &entry : lines[i].entries)
+            {
+              column_indices[k] = entry.first;
+              weights[k]        = entry.second;
+              ++k;
+            }
+        }
+    }
+
+
+
+    template <typename number>
+    inline void
+    CompressedConstraintLines<number>::clear()
+    {
+      constrained_indices.clear();
+      inhomogeneities.clear();
+      row_starts.clear();
+      column_indices.clear();
+      weights.clear();
+    }
+
+
+
+    template <typename number>
+    inline size_type
+    CompressedConstraintLines<number>::size() const
+    {
+      return constrained_indices.size();
+    }
+  } // namespace AffineConstraints
+} // namespace internal
+
+
 template <typename number>
 inline AffineConstraints<number>::AffineConstraints(
   const IndexSet &local_constraints)
@@ -2055,6 +2244,7 @@ inline AffineConstraints<number>::AffineConstraints(
   , lines_cache(affine_constraints.lines_cache)
   , local_lines(affine_constraints.local_lines)
   , sorted(affine_constraints.sorted)
+  , compressed_lines(affine_constraints.compressed_lines)
 {}
 
 template <typename number>
@@ -2144,6 +2334,11 @@ AffineConstraints<number>::set_inhomogeneity(
   Assert(lines_cache[line_index] < lines.size(), ExcInternalError());
   ConstraintLine *line_ptr = &lines[lines_cache[line_index]];
   line_ptr->inhomogeneity  = value;
+
+  // keep the compressed representation up to date, whose lines are in the
+  // same order as the ones in the sorted list of lines
+  if (sorted)
+    compressed_lines.inhomogeneities[lines_cache[line_index]] = value;
 }
 
 
@@ -2153,13 +2348,20 @@ template <class VectorType>
 inline void
 AffineConstraints<number>::set_zero(VectorType &vec) const
 {
-  // since lines is a private member, we cannot pass it to the functions
-  // above. therefore, copy the content which is cheap
-  std::vector<size_type> constrained_lines(lines.size());
-  for (unsigned int i = 0; i < lines.size(); ++i)
-    constrained_lines[i] = lines[i].index;
-  internal::AffineConstraintsImplementation::set_zero_all(constrained_lines,
-                                                          vec);
+  // if the object is closed, the indices of the constrained lines are
+  // available in contiguous storage. otherwise, copy the indices out of the
+  // lines, which is cheap
+  if (sorted)
+    internal::AffineConstraintsImplementation::set_zero_all(
+      compressed_lines.constrained_indices, vec);
+  else
+    {
+      std::vector<size_type> constrained_lines(lines.size());
+      for (unsigned int i = 0; i < lines.size(); ++i)
+        constrained_lines[i] = lines[i].index;
+      internal::AffineConstraintsImplementation::set_zero_all(
+        constrained_lines, vec);
+    }
 }
 
 template <typename number>
@@ -2508,6 +2710,10 @@ AffineConstraints<number>::copy_from(
   lines_cache = other.lines_cache;
   local_lines = other.local_lines;
   sorted      = other.sorted;
+  if (sorted)
+    compressed_lines.reinit(lines);
+  else
+    compressed_lines.clear();
 }
 
 
@@ -2537,6 +2743,27 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+template <typename number>
+template <typename MatrixType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                    global_matrix) const
+{
+  // create a dummy vector and hand on to the function actually implementing
+  // this feature in the cm.templates.h file.
+  Vector<typename MatrixType::value_type> dummy(0);
+  distribute_local_to_global(local_matrices,
+                             ArrayView<const Vector<number>>(),
+                             local_dof_indices,
+                             global_matrix,
+                             dummy,
+                             false);
+}
+
+
+
 template <typename number>
 template <typename MatrixType, typename VectorType>
 inline void
@@ -21,6 +21,7 @@
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -933,6 +934,8 @@ AffineConstraints<number>::close()
         }
 #endif
 
+  compressed_lines.reinit(lines);
+
   sorted = true;
 }
 
@@ -1099,6 +1102,25 @@ AffineConstraints<number>::merge(
 
 
 
+namespace internal
+{
+  namespace AffineConstraints
+  {
+    template <typename number>
+    std::size_t
+    CompressedConstraintLines<number>::memory_consumption() const
+    {
+      return (MemoryConsumption::memory_consumption(constrained_indices) +
+              MemoryConsumption::memory_consumption(inhomogeneities) +
+              MemoryConsumption::memory_consumption(row_starts) +
+              MemoryConsumption::memory_consumption(column_indices) +
+              MemoryConsumption::memory_consumption(weights));
+    }
+  } // namespace AffineConstraints
+} // namespace internal
+
+
+
 template <typename number>
 void
 AffineConstraints<number>::shift(const size_type offset)
@@ -1120,6 +1142,9 @@ AffineConstraints<number>::shift(const size_type offset)
         entry.first += offset;
     }
 
+  if (sorted)
+    compressed_lines.reinit(lines);
+
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
   // are still linked correctly
@@ -1146,6 +1171,8 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  compressed_lines.clear();
+
   sorted = false;
 }
 
@@ -1309,7 +1336,8 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          compressed_lines.memory_consumption());
 }
 
 
@@ -2585,6 +2613,70 @@ namespace internal
 
     output.collect_sizes();
   }
+
+  namespace AffineConstraintsImplementation
+  {
+    // a type trait that states whether the elements of a vector can be
+    // written from several threads at once, as long as each thread accesses
+    // different elements. this is the case for the vector classes that
+    // store their locally owned and ghost elements in plain memory, but not
+    // necessarily for the wrappers around external libraries
+    template <typename VectorType>
+    struct HasThreadSafeElementAccess
+      : std::integral_constant<bool,
+                               dealii::is_serial_vector<VectorType>::value>
+    {};
+
+    template <typename Number>
+    struct HasThreadSafeElementAccess<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+      : std::true_type
+    {};
+
+    template <typename Number>
+    struct HasThreadSafeElementAccess<
+      LinearAlgebra::distributed::BlockVector<Number>> : std::true_type
+    {};
+
+
+
+    // compute the values of the constrained entries in the given range of
+    // constraint lines from the values in @p source and write them into
+    // @p destination. if a filter for the locally owned elements is given,
+    // only the lines for locally owned indices are processed
+    template <typename number, typename VectorType>
+    void
+    distribute_on_subrange(
+      const dealii::internal::AffineConstraints::CompressedConstraintLines<
+        number> &         lines,
+      const VectorType &  source,
+      const IndexSet *    owned_elements,
+      VectorType &        destination,
+      const std::size_t   begin,
+      const std::size_t   end)
+    {
+      using value_type = typename VectorType::value_type;
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          const types::global_dof_index index = lines.constrained_indices[i];
+          if (owned_elements != nullptr &&
+              owned_elements->is_element(index) == false)
+            continue;
+
+          value_type new_value = lines.inhomogeneities[i];
+          for (std::size_t k = lines.row_starts[i]; k < lines.row_starts[i + 1];
+               ++k)
+            new_value += (static_cast<value_type>(
+                            internal::ElementAccess<VectorType>::get(
+                              source, lines.column_indices[k])) *
+                          lines.weights[k]);
+          AssertIsFinite(new_value);
+          internal::ElementAccess<VectorType>::set(new_value,
+                                                   index,
+                                                   destination);
+        }
+    }
+  } // namespace AffineConstraintsImplementation
 } // namespace internal
 
 template <typename number>
@@ -2638,21 +2730,29 @@ AffineConstraints<number>::distribute(VectorType &vec) const
         ghosted_vector,
         std::integral_constant<bool, IsBlockVector<VectorType>::value>());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          {
-            typename VectorType::value_type new_value = line.inhomogeneity;
-            for (const std::pair<size_type, number> &entry : line.entries)
-              new_value +=
-                (static_cast<typename VectorType::value_type>(
-                   internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                            entry.first)) *
-                 entry.second);
-            AssertIsFinite(new_value);
-            internal::ElementAccess<VectorType>::set(new_value,
-                                                     line.index,
-                                                     vec);
-          }
+      // the entries of the lines of a closed object are never constrained
+      // themselves, so the lines can be processed independently of each
+      // other. only use several threads if the vector allows concurrent
+      // writes to different elements
+      const auto distribute_range = [&](const std::size_t begin,
+                                        const std::size_t end) {
+        internal::AffineConstraintsImplementation::distribute_on_subrange(
+          compressed_lines,
+          ghosted_vector,
+          &vec_owned_elements,
+          vec,
+          begin,
+          end);
+      };
+      if (internal::AffineConstraintsImplementation::
+            HasThreadSafeElementAccess<VectorType>::value)
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          std::size_t(compressed_lines.size()),
+          distribute_range,
+          internal::VectorImplementation::minimum_parallel_grain_size);
+      else
+        distribute_range(0, compressed_lines.size());
 
       // now compress to communicate the entries that we added to
       // and that weren't to local processors to the owner
@@ -2666,24 +2766,22 @@ AffineConstraints<number>::distribute(VectorType &vec) const
     // support anything else or because it's completely stored
     // locally)
     {
-      for (const ConstraintLine &next_constraint : lines)
-        {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
-          AssertIsFinite(new_value);
-          internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
-                                                   vec);
-        }
+      // fill the entry of each constrained index by adding the different
+      // contributions. since the entries of the lines are not constrained
+      // themselves, we can work on chunks of lines in parallel
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        std::size_t(compressed_lines.size()),
+        [&](const std::size_t begin, const std::size_t end) {
+          internal::AffineConstraintsImplementation::distribute_on_subrange(
+            compressed_lines,
+            vec,
+            static_cast<const IndexSet *>(nullptr),
+            vec,
+            begin,
+            end);
+        },
+        internal::VectorImplementation::minimum_parallel_grain_size);
     }
 }
 
@@ -4054,6 +4152,141 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+// batched version of distribute_local_to_global: write the cells without
+// constrained indices directly, and all others through the functions above
+template <typename number>
+template <typename MatrixType, typename VectorType>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const Vector<number>> &         local_vectors,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                    global_matrix,
+  VectorType &                                    global_vector,
+  const bool use_inhomogeneities_for_rhs) const
+{
+  const bool use_vectors =
+    (local_vectors.size() == 0 && global_vector.size() == 0) ? false : true;
+
+  AssertDimension(local_matrices.size(), local_dof_indices.size());
+  if (use_vectors == true)
+    AssertDimension(local_vectors.size(), local_dof_indices.size());
+  Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
+
+  const Vector<number> dummy_vector;
+
+  for (unsigned int c = 0; c < local_dof_indices.size(); ++c)
+    {
+      const std::vector<size_type> &indices      = local_dof_indices[c];
+      const FullMatrix<number> &    local_matrix = local_matrices[c];
+      const Vector<number> &        local_vector =
+        use_vectors ? local_vectors[c] : dummy_vector;
+      const unsigned int n_local_dofs = indices.size();
+
+      AssertDimension(local_matrix.m(), n_local_dofs);
+      AssertDimension(local_matrix.n(), n_local_dofs);
+      if (use_vectors == true)
+        AssertDimension(local_vector.size(), n_local_dofs);
+
+      bool is_unconstrained = true;
+      if (lines.empty() == false)
+        for (const size_type index : indices)
+          if (is_constrained(index))
+            {
+              is_unconstrained = false;
+              break;
+            }
+
+      if (is_unconstrained)
+        {
+          typename internal::AffineConstraints::ScratchDataAccessor<number>
+            scratch_data(this->scratch_data);
+
+          // check whether the permutation of the previous cell also sorts
+          // the indices of this cell, otherwise sort them again
+          std::vector<unsigned int> &permutation =
+            scratch_data->local_dof_permutation;
+          const auto is_sorted_by_permutation = [&]() {
+            for (unsigned int i = 1; i < n_local_dofs; ++i)
+              if (indices[permutation[i - 1]] >= indices[permutation[i]])
+                return false;
+            return true;
+          };
+          if (permutation.size() != n_local_dofs ||
+              is_sorted_by_permutation() == false)
+            {
+              permutation.resize(n_local_dofs);
+              std::iota(permutation.begin(), permutation.end(), 0U);
+              std::sort(permutation.begin(),
+                        permutation.end(),
+                        [&](const unsigned int a, const unsigned int b) {
+                          return indices[a] < indices[b];
+                        });
+
+              // the same index appears more than once on this cell, which
+              // the slower path below takes care of
+              if (is_sorted_by_permutation() == false)
+                is_unconstrained = false;
+            }
+
+          if (is_unconstrained)
+            {
+              std::vector<size_type> &cols = scratch_data->columns;
+              std::vector<number> &   vals = scratch_data->values;
+              cols.resize(n_local_dofs);
+              vals.resize(n_local_dofs);
+              for (unsigned int j = 0; j < n_local_dofs; ++j)
+                cols[j] = indices[permutation[j]];
+
+              for (unsigned int i = 0; i < n_local_dofs; ++i)
+                {
+                  const unsigned int local_row = permutation[i];
+                  for (unsigned int j = 0; j < n_local_dofs; ++j)
+                    vals[j] = local_matrix(local_row, permutation[j]);
+                  global_matrix.add(cols[i],
+                                    n_local_dofs,
+                                    cols.data(),
+                                    vals.data(),
+                                    false,
+                                    true);
+                }
+
+              if (use_vectors == true)
+                {
+                  if (std::is_same<typename VectorType::value_type,
+                                   number>::value)
+                    {
+                      for (unsigned int j = 0; j < n_local_dofs; ++j)
+                        vals[j] = local_vector(permutation[j]);
+                      global_vector.add(
+                        cols,
+                        *reinterpret_cast<
+                          std::vector<typename VectorType::value_type> *>(
+                          &vals));
+                    }
+                  else
+                    for (unsigned int j = 0; j < n_local_dofs; ++j)
+                      global_vector(cols[j]) +=
+                        static_cast<typename VectorType::value_type>(
+                          local_vector(permutation[j]));
+                }
+            }
+        }
+
+      // the scratch data has been released at this point, so we can go to
+      // the general function
+      if (is_unconstrained == false)
+        distribute_local_to_global(local_matrix,
+                                   local_vector,
+                                   indices,
+                                   global_matrix,
+                                   global_vector,
+                                   use_inhomogeneities_for_rhs);
+    }
+}
+
+
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
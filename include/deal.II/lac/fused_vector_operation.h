@@ -0,0 +1,618 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fused_vector_operation_h
+#define dealii_fused_vector_operation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+#endif
+
+
+namespace LinearAlgebra
+{
+  /*! @addtogroup Vectors
+   *@{
+   */
+
+  /**
+   * A small expression that collects several vector updates of the form
+   * @f[
+   *   \mathbf{x} \leftarrow s\,\mathbf{x} + a\,\mathbf{v} + b\,\mathbf{w}
+   * @f]
+   * and a few inner products that are to be computed after these updates,
+   * and executes all of them in one go. The typical use case are Krylov
+   * solvers such as SolverCG, SolverBicgstab, or SolverMinRes, which
+   * otherwise call add(), sadd() and operator* in separate passes, each
+   * streaming the full vectors through memory:
+   * @code
+   *   LinearAlgebra::FusedVectorOperation<VectorType> operation;
+   *   operation.add(x, alpha, d);
+   *   operation.add(r, -alpha, h);
+   *   operation.dot(r, r);
+   *   const auto results = operation.apply();
+   *   const double residual_norm = std::sqrt(results[0]);
+   * @endcode
+   *
+   * For LinearAlgebra::distributed::Vector with MemorySpace::Host, apply()
+   * performs all updates and inner products in a single sweep through the
+   * locally owned range of the vectors, followed by a single reduction over
+   * the MPI communicator for all inner products together. The sweep works on
+   * small blocks of vector entries that stay in cache between the updates
+   * and the inner products, so a vector written by an update and read again
+   * by a later update or inner product is only transferred once from main
+   * memory. The summation order of the inner products, and hence their
+   * rounding, differs from the one of the inner products of the vector
+   * class. For all other vector types, apply() executes the operations one
+   * after the other using the usual member functions of the vector class,
+   * merging the last update with the first inner product into a call to
+   * add_and_dot() where possible.
+   *
+   * The operations are executed in the order in which they are registered,
+   * i.e., an update may use the result of a previous update as input, and
+   * all inner products are computed with the updated vectors.
+   */
+  template <typename VectorType>
+  class FusedVectorOperation
+  {
+  public:
+    /**
+     * The type of the vector entries.
+     */
+    using value_type = typename VectorType::value_type;
+
+    /**
+     * The maximal number of updates that can be combined into one operation.
+     */
+    static constexpr unsigned int max_n_updates = 4;
+
+    /**
+     * The maximal number of inner products that can be combined into one
+     * operation.
+     */
+    static constexpr unsigned int max_n_dots = 4;
+
+    /**
+     * A single update $\mathbf{x} \leftarrow s\,\mathbf{x} + a\,\mathbf{v} +
+     * b\,\mathbf{w}$. If `w` is a `nullptr`, the last term is omitted. If
+     * $s=0$, the old content of $\mathbf{x}$ is not read.
+     */
+    struct Update
+    {
+      VectorType *      x;
+      value_type        s;
+      value_type        a;
+      const VectorType *v;
+      value_type        b;
+      const VectorType *w;
+    };
+
+    /**
+     * An inner product $\mathbf{u}\cdot\mathbf{w}$, with the same convention
+     * regarding complex conjugation as <tt>u * w</tt>.
+     */
+    struct Dot
+    {
+      const VectorType *u;
+      const VectorType *w;
+    };
+
+    /**
+     * Constructor. Sets up an empty list of operations.
+     */
+    FusedVectorOperation();
+
+    /**
+     * Register the update $\mathbf{x} \leftarrow \mathbf{x} + a\,\mathbf{v}$.
+     */
+    void
+    add(VectorType &x, const value_type a, const VectorType &v);
+
+    /**
+     * Register the update $\mathbf{x} \leftarrow \mathbf{x} + a\,\mathbf{v} +
+     * b\,\mathbf{w}$.
+     */
+    void
+    add(VectorType &      x,
+        const value_type  a,
+        const VectorType &v,
+        const value_type  b,
+        const VectorType &w);
+
+    /**
+     * Register the update $\mathbf{x} \leftarrow s\,\mathbf{x} +
+     * a\,\mathbf{v}$. For $s=0$, this corresponds to VectorType::equ().
+     */
+    void
+    sadd(VectorType &      x,
+         const value_type  s,
+         const value_type  a,
+         const VectorType &v);
+
+    /**
+     * Register the update $\mathbf{x} \leftarrow s\,\mathbf{x} +
+     * a\,\mathbf{v} + b\,\mathbf{w}$.
+     */
+    void
+    sadd(VectorType &      x,
+         const value_type  s,
+         const value_type  a,
+         const VectorType &v,
+         const value_type  b,
+         const VectorType &w);
+
+    /**
+     * Register the inner product $\mathbf{u}\cdot\mathbf{w}$, evaluated after
+     * all updates have been applied. Returns the position of the result in
+     * the array returned by apply().
+     */
+    unsigned int
+    dot(const VectorType &u, const VectorType &w);
+
+    /**
+     * Execute all registered updates and inner products and return the
+     * values of the inner products in the order in which they were
+     * registered. Afterwards, the list of operations is empty again, so the
+     * object can be reused.
+     */
+    std::array<value_type, max_n_dots>
+    apply();
+
+    /**
+     * Return the number of registered updates.
+     */
+    unsigned int
+    n_updates() const;
+
+    /**
+     * Return the number of registered inner products.
+     */
+    unsigned int
+    n_dots() const;
+
+  private:
+    /**
+     * The registered updates.
+     */
+    std::array<Update, max_n_updates> updates;
+
+    /**
+     * The registered inner products.
+     */
+    std::array<Dot, max_n_dots> dots;
+
+    /**
+     * The number of valid entries in @p updates.
+     */
+    unsigned int n_registered_updates;
+
+    /**
+     * The number of valid entries in @p dots.
+     */
+    unsigned int n_registered_dots;
+  };
+
+  /*@}*/
+} // namespace LinearAlgebra
+
+
+
+/* ---------------------------- inline functions ------------------------- */
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace FusedVectorOperationImplementation
+  {
+    /**
+     * Execute the operations one after the other, using only the interface
+     * that the solver classes require from general vector classes.
+     */
+    template <typename VectorType>
+    struct Executor
+    {
+      using Update =
+        typename LinearAlgebra::FusedVectorOperation<VectorType>::Update;
+      using Dot = typename LinearAlgebra::FusedVectorOperation<VectorType>::Dot;
+      using value_type = typename VectorType::value_type;
+
+      static void
+      apply(const ArrayView<const Update> &updates,
+            const ArrayView<const Dot> &   dots,
+            const ArrayView<value_type> &  results)
+      {
+        unsigned int first_dot = 0;
+        for (unsigned int u = 0; u < updates.size(); ++u)
+          {
+            const Update &update = updates[u];
+
+            // merge the last update with the first inner product if the
+            // vector class provides this operation
+            if (u + 1 == updates.size() && dots.size() > 0 &&
+                dots[0].u == update.x && update.s == value_type(1.) &&
+                update.w == nullptr)
+              {
+                results[0] = update.x->add_and_dot(update.a,
+                                                   *update.v,
+                                                   *dots[0].w);
+                first_dot  = 1;
+              }
+            else
+              {
+                // use the same vector operations as the solvers did before
+                // they were rewritten in terms of this class, so that the
+                // results do not change
+                if (update.s == value_type(1.) && update.w != nullptr)
+                  update.x->add(update.a, *update.v, update.b, *update.w);
+                else
+                  {
+                    if (update.s == value_type(1.))
+                      update.x->add(update.a, *update.v);
+                    else if (update.s == value_type())
+                      update.x->equ(update.a, *update.v);
+                    else
+                      update.x->sadd(update.s, update.a, *update.v);
+                    if (update.w != nullptr)
+                      update.x->add(update.b, *update.w);
+                  }
+              }
+          }
+
+        for (unsigned int d = first_dot; d < dots.size(); ++d)
+          results[d] = *dots[d].u * *dots[d].w;
+      }
+    };
+
+
+
+    /**
+     * Execute the operations for LinearAlgebra::distributed::Vector in one
+     * sweep through the locally owned entries. The range is split into a
+     * fixed number of chunks that only depends on the vector size and the
+     * number of threads, in order to make the inner products reproducible.
+     * Each chunk is processed in blocks that fit into the level-1 cache, and
+     * all updates and inner products are applied to one block before
+     * moving on to the next one.
+     */
+    template <typename Number>
+    struct Executor<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+      using Update =
+        typename LinearAlgebra::FusedVectorOperation<VectorType>::Update;
+      using Dot = typename LinearAlgebra::FusedVectorOperation<VectorType>::Dot;
+      static constexpr unsigned int max_n_dots =
+        LinearAlgebra::FusedVectorOperation<VectorType>::max_n_dots;
+
+      /**
+       * Number of vector entries processed at once by all operations.
+       */
+      static constexpr std::size_t block_size = 256;
+
+      static void
+      apply(const ArrayView<const Update> &updates,
+            const ArrayView<const Dot> &   dots,
+            const ArrayView<Number> &      results)
+      {
+        const VectorType &first_vector =
+          updates.size() > 0 ? *updates[0].x : *dots[0].u;
+        const std::size_t size = first_vector.locally_owned_size();
+#  ifdef DEBUG
+        for (const Update &update : updates)
+          {
+            AssertDimension(update.x->locally_owned_size(), size);
+            AssertDimension(update.v->locally_owned_size(), size);
+            Assert(update.w == nullptr ||
+                     update.w->locally_owned_size() == size,
+                   ExcDimensionMismatch(update.w->locally_owned_size(), size));
+          }
+        for (const Dot &dot : dots)
+          {
+            AssertDimension(dot.u->locally_owned_size(), size);
+            AssertDimension(dot.w->locally_owned_size(), size);
+          }
+#  endif
+
+        const std::size_t grain_size =
+          internal::VectorImplementation::minimum_parallel_grain_size;
+        const std::size_t n_blocks = (size + block_size - 1) / block_size;
+        const std::size_t n_chunks = std::max<std::size_t>(
+          1,
+          std::min<std::size_t>(4 * MultithreadInfo::n_threads(),
+                                size / grain_size));
+        const std::size_t chunk_size =
+          ((n_blocks + n_chunks - 1) / n_chunks) * block_size;
+
+        std::vector<std::array<Number, max_n_dots>> chunk_results(n_chunks);
+        dealii::parallel::apply_to_subranges(
+          std::size_t(0),
+          n_chunks,
+          [&](const std::size_t chunk_begin, const std::size_t chunk_end) {
+            for (std::size_t c = chunk_begin; c < chunk_end; ++c)
+              chunk_results[c] =
+                apply_to_range(updates,
+                               dots,
+                               std::min(size, c * chunk_size),
+                               std::min(size, (c + 1) * chunk_size));
+          },
+          1);
+
+        for (unsigned int d = 0; d < dots.size(); ++d)
+          {
+            results[d] = Number();
+            for (std::size_t c = 0; c < n_chunks; ++c)
+              results[d] += chunk_results[c][d];
+          }
+
+        if (dots.size() > 0)
+          Utilities::MPI::sum(ArrayView<const Number>(results.data(),
+                                                      dots.size()),
+                              first_vector.get_mpi_communicator(),
+                              ArrayView<Number>(results.data(), dots.size()));
+
+        for (const Update &update : updates)
+          if (update.x->has_ghost_elements())
+            update.x->update_ghost_values();
+      }
+
+      static std::array<Number, max_n_dots>
+      apply_to_range(const ArrayView<const Update> &updates,
+                     const ArrayView<const Dot> &   dots,
+                     const std::size_t              begin,
+                     const std::size_t              end)
+      {
+        std::array<Number, max_n_dots> sums;
+        std::fill(sums.begin(), sums.end(), Number());
+
+        for (std::size_t start = begin; start < end; start += block_size)
+          {
+            const std::size_t stop = std::min(start + block_size, end);
+            for (const Update &update : updates)
+              {
+                Number *const       x = update.x->begin();
+                const Number *const v = update.v->begin();
+                const Number        s = update.s;
+                const Number        a = update.a;
+                const Number        b = update.b;
+                if (update.w == nullptr)
+                  {
+                    if (s == Number(1.))
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] += a * v[i];
+                      }
+                    else if (s == Number())
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] = a * v[i];
+                      }
+                    else
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] = s * x[i] + a * v[i];
+                      }
+                  }
+                else
+                  {
+                    const Number *const w = update.w->begin();
+                    if (s == Number(1.))
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] += a * v[i] + b * w[i];
+                      }
+                    else if (s == Number())
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] = a * v[i] + b * w[i];
+                      }
+                    else
+                      {
+                        DEAL_II_OPENMP_SIMD_PRAGMA
+                        for (std::size_t i = start; i < stop; ++i)
+                          x[i] = s * x[i] + a * v[i] + b * w[i];
+                      }
+                  }
+              }
+
+            for (unsigned int d = 0; d < dots.size(); ++d)
+              {
+                const Number *const u = dots[d].u->begin();
+                const Number *const w = dots[d].w->begin();
+
+                // use four independent partial sums to break the dependency
+                // chain of the additions
+                Number      r0 = Number(), r1 = Number(), r2 = Number(),
+                       r3 = Number();
+                std::size_t i = start;
+                for (; i + 3 < stop; i += 4)
+                  {
+                    r0 += u[i] * numbers::NumberTraits<Number>::conjugate(w[i]);
+                    r1 += u[i + 1] *
+                          numbers::NumberTraits<Number>::conjugate(w[i + 1]);
+                    r2 += u[i + 2] *
+                          numbers::NumberTraits<Number>::conjugate(w[i + 2]);
+                    r3 += u[i + 3] *
+                          numbers::NumberTraits<Number>::conjugate(w[i + 3]);
+                  }
+                for (; i < stop; ++i)
+                  r0 += u[i] * numbers::NumberTraits<Number>::conjugate(w[i]);
+                sums[d] += (r0 + r1) + (r2 + r3);
+              }
+          }
+
+        return sums;
+      }
+    };
+  } // namespace FusedVectorOperationImplementation
+} // namespace internal
+
+
+
+namespace LinearAlgebra
+{
+  template <typename VectorType>
+  inline FusedVectorOperation<VectorType>::FusedVectorOperation()
+    : n_registered_updates(0)
+    , n_registered_dots(0)
+  {}
+
+
+
+  template <typename VectorType>
+  inline void
+  FusedVectorOperation<VectorType>::add(VectorType &      x,
+                                        const value_type  a,
+                                        const VectorType &v)
+  {
+    sadd(x, value_type(1.), a, v);
+  }
+
+
+
+  template <typename VectorType>
+  inline void
+  FusedVectorOperation<VectorType>::add(VectorType &      x,
+                                        const value_type  a,
+                                        const VectorType &v,
+                                        const value_type  b,
+                                        const VectorType &w)
+  {
+    sadd(x, value_type(1.), a, v, b, w);
+  }
+
+
+
+  template <typename VectorType>
+  inline void
+  FusedVectorOperation<VectorType>::sadd(VectorType &      x,
+                                         const value_type  s,
+                                         const value_type  a,
+                                         const VectorType &v)
+  {
+    AssertIndexRange(n_registered_updates, max_n_updates);
+    AssertIsFinite(s);
+    AssertIsFinite(a);
+    updates[n_registered_updates++] = {&x, s, a, &v, value_type(), nullptr};
+  }
+
+
+
+  template <typename VectorType>
+  inline void
+  FusedVectorOperation<VectorType>::sadd(VectorType &      x,
+                                         const value_type  s,
+                                         const value_type  a,
+                                         const VectorType &v,
+                                         const value_type  b,
+                                         const VectorType &w)
+  {
+    AssertIndexRange(n_registered_updates, max_n_updates);
+    AssertIsFinite(s);
+    AssertIsFinite(a);
+    AssertIsFinite(b);
+    updates[n_registered_updates++] = {&x, s, a, &v, b, &w};
+  }
+
+
+
+  template <typename VectorType>
+  inline unsigned int
+  FusedVectorOperation<VectorType>::dot(const VectorType &u,
+                                        const VectorType &w)
+  {
+    AssertIndexRange(n_registered_dots, max_n_dots);
+    dots[n_registered_dots] = {&u, &w};
+    return n_registered_dots++;
+  }
+
+
+
+  template <typename VectorType>
+  inline std::array<typename FusedVectorOperation<VectorType>::value_type,
+                    FusedVectorOperation<VectorType>::max_n_dots>
+  FusedVectorOperation<VectorType>::apply()
+  {
+    std::array<value_type, max_n_dots> results;
+    std::fill(results.begin(), results.end(), value_type());
+
+    if (n_registered_updates > 0 || n_registered_dots > 0)
+      internal::FusedVectorOperationImplementation::Executor<VectorType>::apply(
+        ArrayView<const Update>(updates.data(), n_registered_updates),
+        ArrayView<const Dot>(dots.data(), n_registered_dots),
+        ArrayView<value_type>(results.data(), n_registered_dots));
+
+    n_registered_updates = 0;
+    n_registered_dots    = 0;
+
+    return results;
+  }
+
+
+
+  template <typename VectorType>
+  inline unsigned int
+  FusedVectorOperation<VectorType>::n_updates() const
+  {
+    return n_registered_updates;
+  }
+
+
+
+  template <typename VectorType>
+  inline unsigned int
+  FusedVectorOperation<VectorType>::n_dots() const
+  {
+    return n_registered_dots;
+  }
+} // namespace LinearAlgebra
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -29,6 +29,7 @@
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/block_vector_base.h>
 #include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/fused_vector_operation.h>
 #include <deal.II/lac/identity_matrix.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/vector_memory.h>
@@ -1579,6 +1580,15 @@ public:
  * set `dst` to zero, whereas the operation after the loop performs the
  * iteration leading to $x^{n+1}$ described above, modifying the `dst` and
  * `src` vectors.
+ *
+ * The operators derived from MatrixFreeOperators::Base provide this
+ * function, including the treatment of constrained entries, so that a
+ * PreconditionChebyshev around, e.g., MatrixFreeOperators::LaplaceOperator
+ * with the inverse diagonal from
+ * MatrixFreeOperators::Base::get_matrix_diagonal_inverse() as
+ * `PreconditionerType` automatically merges the vector updates into the cell
+ * loop. Derived classes with their own cell loop need to override
+ * MatrixFreeOperators::Base::apply_add_with_pre_post() to benefit from this.
  */
 template <typename MatrixType         = SparseMatrix<double>,
           typename VectorType         = Vector<double>,
@@ -2312,8 +2322,14 @@ namespace internal
           preconditioner.vmult(temp_vector2, temp_vector1);
 
           // compute x^{n+1} = x^{n} + f_1 * (x^{n}-x^{n-1}) + f_2 * t
-          solution_old.sadd(-factor1, factor2, temp_vector2);
-          solution_old.add(1 + factor1, solution);
+          LinearAlgebra::FusedVectorOperation<VectorType> update;
+          update.sadd(solution_old,
+                      -factor1,
+                      factor2,
+                      temp_vector2,
+                      1 + factor1,
+                      solution);
+          update.apply();
         }
 
       solution.swap(solution_old);
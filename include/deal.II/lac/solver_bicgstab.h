@@ -23,6 +23,7 @@
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/fused_vector_operation.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 
@@ -382,11 +383,15 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
   rbar         = r;
   bool startup = true;
 
+  // the inner product of r and rbar is computed together with the update of
+  // r at the end of the previous iteration
+  double r_times_rbar = r * rbar;
+
   do
     {
       ++step;
 
-      rhobar = r * rbar;
+      rhobar = r_times_rbar;
       if (std::fabs(rhobar) < additional_data.breakdown)
         {
           return IterationResult(true, state, step, res);
@@ -400,8 +405,9 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
         }
       else
         {
-          p.sadd(beta, 1., r);
-          p.add(-beta * omega, v);
+          LinearAlgebra::FusedVectorOperation<VectorType> update;
+          update.sadd(p, beta, 1., r, -beta * omega, v);
+          update.apply();
         }
 
       preconditioner.vmult(y, p);
@@ -431,22 +437,39 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
 
       preconditioner.vmult(z, r);
       A.vmult(t, z);
-      rhobar         = t * r;
-      auto t_squared = t * t;
+      LinearAlgebra::FusedVectorOperation<VectorType> products;
+      products.dot(t, r);
+      products.dot(t, t);
+      const auto t_products = products.apply();
+      rhobar                = t_products[0];
+      const auto t_squared  = t_products[1];
       if (t_squared < additional_data.breakdown)
         {
           return IterationResult(true, state, step, res);
         }
-      omega = rhobar / (t * t);
-      Vx->add(alpha, y, omega, z);
+      omega = rhobar / t_squared;
 
       if (additional_data.exact_residual)
         {
+          Vx->add(alpha, y, omega, z);
           r.add(-omega, t);
-          res = criterion(A, *Vx, *Vb);
+          res          = criterion(A, *Vx, *Vb);
+          r_times_rbar = r * rbar;
         }
       else
-        res = std::sqrt(r.add_and_dot(-omega, t, r));
+        {
+          // update the solution and the residual and compute the inner
+          // products needed for the convergence check and the next iteration
+          // in one sweep
+          LinearAlgebra::FusedVectorOperation<VectorType> update;
+          update.add(*Vx, alpha, y, omega, z);
+          update.add(r, -omega, t);
+          update.dot(r, r);
+          update.dot(r, rbar);
+          const auto r_products = update.apply();
+          res                   = std::sqrt(r_products[0]);
+          r_times_rbar          = r_products[1];
+        }
 
       state = this->iteration_status(step, res, *Vx);
       print_vectors(step, *Vx, r, y);
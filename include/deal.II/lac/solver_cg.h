@@ -19,14 +19,20 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
 
+#include <deal.II/lac/fused_vector_operation.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 
+#include <array>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -34,6 +40,14 @@ DEAL_II_NAMESPACE_OPEN
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
 #endif
 
 
@@ -231,6 +245,94 @@ protected:
     all_eigenvalues_signal;
 };
 
+
+
+
+/**
+ * This class implements a pipelined variant of the preconditioned Conjugate
+ * Gradients method, following P. Ghysels and W. Vanroose: "Hiding global
+ * synchronization latency in the preconditioned Conjugate Gradient
+ * algorithm", Parallel Computing 40 (2014), pp. 224-238.
+ *
+ * The classical CG method as implemented in SolverCG needs two global
+ * reductions per iteration whose results are needed immediately, namely the
+ * inner products for the step length and for the new search direction. On
+ * large parallel machines, the latency of these reductions limits the
+ * scalability of the solver. The pipelined variant rearranges the recurrences
+ * such that all three scalar products of one iteration (including the
+ * residual norm needed for the convergence check) are computed in a single
+ * reduction. This reduction is started before the application of the
+ * preconditioner and the matrix-vector product and completed afterwards, such
+ * that the communication is overlapped with these operations. In exact
+ * arithmetic, the iterates are the same as the ones of SolverCG.
+ *
+ * The price to pay are additional vector updates (eight instead of three per
+ * iteration) and six additional auxiliary vectors, so the method is only
+ * advantageous when the latency of the global reductions dominates, e.g., in
+ * strong-scaling limit on many MPI ranks. Furthermore, the recurrences are
+ * somewhat less stable numerically than the ones of the classical method,
+ * which may lead to a slightly higher iteration count for tight tolerances.
+ *
+ * The overlap of the reduction with the preconditioner and matrix-vector
+ * product is implemented for LinearAlgebra::distributed::Vector, using a
+ * non-blocking reduction from Utilities::MPI::isum(). For all other vector
+ * types, the scalar products are computed one after the other with the
+ * usual blocking operations after the matrix-vector product, which gives the
+ * same iterates but without the communication hiding.
+ *
+ * Note that the residual reported to the SolverControl object in iteration
+ * @p k is the one of the iterate $x_k$, but it only becomes available after
+ * the preconditioner and the matrix-vector product of the next iteration have
+ * been applied. Thus, the method does one more application of these
+ * operators than SolverCG for the same number of iterations.
+ *
+ * This class derives from SolverCG and provides the same signals for the CG
+ * coefficients, eigenvalue estimates and condition number estimates.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * An alias for the solver-specific additional data.
+   */
+  using AdditionalData = typename SolverCG<VectorType>::AdditionalData;
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipelinedCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+};
+
 /*@}*/
 
 /*------------------------- Implementation ----------------------------*/
@@ -421,8 +523,13 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
       Assert(std::abs(alpha) != 0., ExcDivideByZero());
       alpha = gh / alpha;
 
-      x.add(alpha, d);
-      res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      // update the solution and the residual and compute the norm of the
+      // new residual with a single sweep through the vectors
+      LinearAlgebra::FusedVectorOperation<VectorType> update;
+      update.add(x, alpha, d);
+      update.add(g, alpha, h);
+      update.dot(g, g);
+      res = std::sqrt(std::abs(update.apply()[0]));
 
       print_vectors(it, x, g, d);
 
@@ -459,6 +566,318 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
 
 
+namespace internal
+{
+  namespace SolverCGImplementation
+  {
+    /**
+     * Compute the three inner products $(r,u)$, $(w,u)$, and $(r,r)$ needed
+     * in one iteration of SolverPipelinedCG. The computation is started by
+     * start() and the results are returned by finish(), allowing to overlap
+     * communication with other work in between. This general implementation
+     * computes all inner products in finish().
+     */
+    template <typename VectorType>
+    class PipelinedInnerProducts
+    {
+    public:
+      using value_type = typename VectorType::value_type;
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        this->r = &r;
+        this->u = &u;
+        this->w = &w;
+      }
+
+      std::array<value_type, 3>
+      finish()
+      {
+        return {{*r * *u, *w * *u, *r * *r}};
+      }
+
+    private:
+      const VectorType *r;
+      const VectorType *u;
+      const VectorType *w;
+    };
+
+
+
+    /**
+     * Specialization for LinearAlgebra::distributed::Vector, which computes
+     * the local parts of the inner products in a single sweep through the
+     * vectors and starts a non-blocking reduction over the MPI communicator
+     * of the vectors.
+     */
+    template <typename Number>
+    class PipelinedInnerProducts<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using value_type = Number;
+
+      void
+      start(
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r,
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &u,
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+          &w)
+      {
+        AssertDimension(r.locally_owned_size(), u.locally_owned_size());
+        AssertDimension(r.locally_owned_size(), w.locally_owned_size());
+
+        const Number *     r_ptr = r.begin();
+        const Number *     u_ptr = u.begin();
+        const Number *     w_ptr = w.begin();
+        const unsigned int size  = r.locally_owned_size();
+        Number             ru = Number(), wu = Number(), rr = Number();
+        unsigned int       i  = 0;
+
+        // accumulate the sums of real numbers in the lanes of a
+        // VectorizedArray, like the inner products of the vector class do,
+        // and add up the lanes and the remainder afterwards
+        constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+        if (n_lanes > 1)
+          {
+            VectorizedArray<Number> ru_lanes = Number(), wu_lanes = Number(),
+                                    rr_lanes = Number();
+            for (; i + n_lanes <= size; i += n_lanes)
+              {
+                VectorizedArray<Number> r_i, u_i, w_i;
+                r_i.load(r_ptr + i);
+                u_i.load(u_ptr + i);
+                w_i.load(w_ptr + i);
+                ru_lanes += r_i * u_i;
+                wu_lanes += w_i * u_i;
+                rr_lanes += r_i * r_i;
+              }
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                ru += ru_lanes[v];
+                wu += wu_lanes[v];
+                rr += rr_lanes[v];
+              }
+          }
+        for (; i < size; ++i)
+          {
+            const Number u_conj =
+              numbers::NumberTraits<Number>::conjugate(u_ptr[i]);
+            ru += r_ptr[i] * u_conj;
+            wu += w_ptr[i] * u_conj;
+            rr +=
+              r_ptr[i] * numbers::NumberTraits<Number>::conjugate(r_ptr[i]);
+          }
+        local_sums = {{ru, wu, rr}};
+        Utilities::MPI::isum(ArrayView<const Number>(local_sums.data(), 3),
+                             r.get_mpi_communicator(),
+                             ArrayView<Number>(global_sums.data(), 3),
+                             request);
+      }
+
+      std::array<Number, 3>
+      finish()
+      {
+        Utilities::MPI::wait_for_request(request);
+        return global_sums;
+      }
+
+    private:
+      std::array<Number, 3> local_sums;
+      std::array<Number, 3> global_sums;
+      MPI_Request           request = MPI_REQUEST_NULL;
+    };
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &           cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, mem, data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &       cn,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  // Memory allocation. the notation follows the paper by Ghysels and
+  // Vanroose: r is the residual, u the preconditioned residual, w = A u, and
+  // m = P w and n = A m are the results of the preconditioner and the
+  // matrix-vector product that are computed while the reduction is in
+  // flight. p is the search direction and s = A p, q = P s, z = A q the
+  // auxiliary vectors of the recurrences.
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues = !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<typename VectorType::value_type> diagonal;
+  std::vector<typename VectorType::value_type> offdiagonal;
+
+  typename VectorType::value_type eigen_beta_alpha = 0;
+
+  // resize the vectors, but do not set the values since they'd be overwritten
+  // soon anyway.
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  // the vectors of the recurrences start from zero
+  p.reinit(x);
+  s.reinit(x);
+  q.reinit(x);
+  z.reinit(x);
+
+  int    it        = 0;
+  number gamma     = number();
+  number old_gamma = number();
+  number beta      = number();
+  number alpha     = number();
+  number old_alpha = number();
+  double res       = 0.;
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r.equ(1., b);
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverCGImplementation::PipelinedInnerProducts<VectorType>
+    inner_products;
+
+  while (conv == SolverControl::iterate)
+    {
+      // start the reduction for the inner products and overlap it with the
+      // preconditioner and the matrix-vector product
+      inner_products.start(r, u, w);
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+      const std::array<number, 3> products = inner_products.finish();
+
+      old_gamma = gamma;
+      gamma     = products[0];
+      res       = std::sqrt(std::abs(products[2]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      ++it;
+      old_alpha = alpha;
+
+      const number delta = products[1];
+      if (it > 1)
+        {
+          Assert(std::abs(old_gamma) != 0., ExcDivideByZero());
+          beta = gamma / old_gamma;
+          Assert(std::abs(old_alpha) != 0., ExcDivideByZero());
+          alpha = delta - beta * gamma / old_alpha;
+        }
+      else
+        {
+          beta  = number();
+          alpha = delta;
+        }
+      Assert(std::abs(alpha) != 0., ExcDivideByZero());
+      alpha = gamma / alpha;
+
+      z.sadd(beta, 1., n);
+      q.sadd(beta, 1., m);
+      s.sadd(beta, 1., w);
+      p.sadd(beta, 1., u);
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      this->print_vectors(it, x, r, p);
+
+      if (it > 1)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+        }
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 SolverCG<VectorType>::connect_coefficients_slot(
@@ -21,6 +21,8 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/full_matrix.h>
@@ -37,6 +39,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -150,6 +164,31 @@ namespace internal
  * off between memory consumption and convergence speed, since a longer basis
  * means minimization over a larger space.
  *
+ *
+ * <h3>s-step variant</h3>
+ *
+ * The modified Gram-Schmidt orthogonalization of the Arnoldi process computes
+ * one inner product after the other, which for parallel vectors means one
+ * global reduction per inner product. If AdditionalData::s_step_size is set
+ * to a value $s>1$, the solver instead generates $s$ new basis vectors at
+ * once by applying the (preconditioned) matrix $s$ times in a row to the
+ * last basis vector (monomial basis). The block of new vectors is then
+ * orthogonalized against the previous basis and among itself by two passes
+ * of block classical Gram-Schmidt with a Cholesky QR factorization
+ * (BCGS2/CholQR2). Each pass computes all needed inner products in one
+ * go, which for LinearAlgebra::distributed::Vector is done with a single
+ * global reduction. The Hessenberg matrix of the Arnoldi process is then
+ * recovered from the triangular factors, and the residual is checked for
+ * each of the $s$ steps as in the classical variant. Thus, the number of
+ * global reductions is reduced by roughly a factor of $s$.
+ *
+ * The monomial basis becomes ill-conditioned quickly as $s$ grows, in
+ * particular for badly conditioned systems, so values of $s$ between 2 and
+ * 5 are recommended. If the Cholesky factorization detects that the new
+ * block of vectors is numerically rank-deficient, the solver falls back to a
+ * single step of the classical algorithm for the next basis vector. The
+ * s-step variant requires AdditionalData::use_default_residual to be set.
+ *
  * For the requirements on matrices and vectors in order to work with this
  * class, see the documentation of the Solver base class.
  *
@@ -190,7 +229,8 @@ public:
     explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
                             const bool         right_preconditioning = false,
                             const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+                            const bool force_re_orthogonalization    = false,
+                            const unsigned int s_step_size           = 1);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -221,6 +261,15 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Number of basis vectors that are generated and orthogonalized as a
+     * block in the s-step variant of the Arnoldi process, see the section on
+     * the s-step variant in the class documentation. The default value of
+     * one selects the classical algorithm with modified Gram-Schmidt
+     * orthogonalization.
+     */
+    unsigned int s_step_size;
   };
 
   /**
@@ -528,6 +577,156 @@ namespace internal
 {
   namespace SolverGMRESImplementation
   {
+    /**
+     * Compute the inner products of the @p n_new vectors starting at index
+     * @p first_new in @p vectors with all vectors before them (stored in @p
+     * projections) and among each other (stored in @p gram_matrix). This is
+     * the general implementation that calls the inner product of the vector
+     * class for each entry.
+     */
+    template <typename VectorType>
+    void
+    block_inner_products(const TmpVectors<VectorType> &vectors,
+                         const unsigned int            first_new,
+                         const unsigned int            n_new,
+                         FullMatrix<double> &          projections,
+                         FullMatrix<double> &          gram_matrix)
+    {
+      for (unsigned int j = 0; j < n_new; ++j)
+        {
+          const VectorType &w = vectors[first_new + j];
+          for (unsigned int i = 0; i < first_new; ++i)
+            projections(i, j) = w * vectors[i];
+          for (unsigned int i = 0; i <= j; ++i)
+            gram_matrix(i, j) = gram_matrix(j, i) =
+              w * vectors[first_new + i];
+        }
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::Vector, which computes the local parts of
+     * all inner products first and then sums them over all MPI processes in a
+     * single reduction.
+     */
+    template <typename Number>
+    void
+    block_inner_products(
+      const TmpVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &                vectors,
+      const unsigned int first_new,
+      const unsigned int n_new,
+      FullMatrix<double> &projections,
+      FullMatrix<double> &gram_matrix)
+    {
+      const unsigned int n_rows = first_new + n_new;
+      const unsigned int size   = vectors[0].locally_owned_size();
+      std::vector<double> products(n_rows * n_new);
+      for (unsigned int j = 0; j < n_new; ++j)
+        {
+          const Number *w = vectors[first_new + j].begin();
+          for (unsigned int i = 0; i <= first_new + j; ++i)
+            {
+              const Number *v = vectors[i].begin();
+
+              // accumulate in several independent partial sums, which the
+              // compiler can keep in vector registers, and add them up
+              // afterwards
+              constexpr unsigned int n_sums       = 8;
+              double                 sums[n_sums] = {};
+              unsigned int           k            = 0;
+              for (; k + n_sums <= size; k += n_sums)
+                for (unsigned int l = 0; l < n_sums; ++l)
+                  sums[l] += static_cast<double>(w[k + l]) * v[k + l];
+              double sum = 0;
+              for (unsigned int l = 0; l < n_sums; ++l)
+                sum += sums[l];
+              for (; k < size; ++k)
+                sum += static_cast<double>(w[k]) * v[k];
+              products[j * n_rows + i] = sum;
+            }
+        }
+      Utilities::MPI::sum(products,
+                          vectors[0].get_mpi_communicator(),
+                          products);
+
+      for (unsigned int j = 0; j < n_new; ++j)
+        {
+          for (unsigned int i = 0; i < first_new; ++i)
+            projections(i, j) = products[j * n_rows + i];
+          for (unsigned int i = 0; i <= j; ++i)
+            gram_matrix(i, j) = gram_matrix(j, i) =
+              products[j * n_rows + first_new + i];
+        }
+    }
+
+
+
+    /**
+     * Orthogonalize the @p n_new vectors starting at index @p first_new in @p
+     * vectors against the orthonormal vectors before them and among each
+     * other by one pass of block classical Gram-Schmidt with a Cholesky QR
+     * factorization. On exit, the new vectors are orthonormal and satisfy
+     * <tt>W_old = V C + W_new R</tt> with the coefficients $C$ stored in @p
+     * projections and the upper triangular factor $R$ stored in @p
+     * triangular_factor. Return false if the Cholesky factorization detects
+     * that the block is numerically rank-deficient, in which case the vectors
+     * are left untouched.
+     */
+    template <typename VectorType>
+    bool
+    block_orthogonalize(const TmpVectors<VectorType> &vectors,
+                        const unsigned int            first_new,
+                        const unsigned int            n_new,
+                        FullMatrix<double> &          projections,
+                        FullMatrix<double> &          triangular_factor)
+    {
+      FullMatrix<double> gram_matrix(n_new, n_new);
+      projections.reinit(first_new, n_new);
+      block_inner_products(
+        vectors, first_new, n_new, projections, gram_matrix);
+
+      // the Gram matrix of the new vectors after projection, computed by the
+      // Pythagorean theorem G - C^T C, and its Cholesky factor R^T R
+      triangular_factor.reinit(n_new, n_new);
+      for (unsigned int j = 0; j < n_new; ++j)
+        for (unsigned int i = 0; i <= j; ++i)
+          {
+            double entry = gram_matrix(i, j);
+            for (unsigned int k = 0; k < first_new; ++k)
+              entry -= projections(k, i) * projections(k, j);
+            for (unsigned int k = 0; k < i; ++k)
+              entry -= triangular_factor(k, i) * triangular_factor(k, j);
+            if (i < j)
+              triangular_factor(i, j) = entry / triangular_factor(i, i);
+            else
+              {
+                // the new vector is (almost) in the span of the previous
+                // ones, so the relation can not be recovered accurately
+                if (!(entry > 1e4 * std::numeric_limits<double>::epsilon() *
+                                gram_matrix(j, j)))
+                  return false;
+                triangular_factor(j, j) = std::sqrt(entry);
+              }
+          }
+
+      for (unsigned int j = 0; j < n_new; ++j)
+        {
+          VectorType &w = vectors[first_new + j];
+          for (unsigned int i = 0; i < first_new; ++i)
+            w.add(-projections(i, j), vectors[i]);
+          for (unsigned int i = 0; i < j; ++i)
+            w.add(-triangular_factor(i, j), vectors[first_new + i]);
+          w *= 1. / triangular_factor(j, j);
+        }
+      return true;
+    }
+
+
+
     template <class VectorType>
     inline TmpVectors<VectorType>::TmpVectors(const unsigned int max_size,
                                               VectorMemory<VectorType> &vmem)
@@ -592,15 +791,19 @@ inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_n_tmp_vectors,
   const bool         right_preconditioning,
   const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const bool         force_re_orthogonalization,
+  const unsigned int s_step_size)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , s_step_size(s_step_size)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
                     "temporary vectors."));
+  Assert(s_step_size > 0,
+         ExcMessage("The s-step size must be at least one."));
 }
 
 
@@ -809,10 +1012,17 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
     !condition_number_signal.empty() || !all_condition_numbers_signal.empty() ||
     !eigenvalues_signal.empty() || !all_eigenvalues_signal.empty() ||
     !hessenberg_signal.empty() || !all_hessenberg_signal.empty();
+
+  const unsigned int s_step_size = additional_data.s_step_size;
+  Assert(s_step_size == 1 || additional_data.use_default_residual,
+         ExcMessage("The s-step variant of SolverGMRES requires the default "
+                    "residual as stopping criterion."));
+
   // for eigenvalue computation, need to collect the Hessenberg matrix (before
-  // applying Givens rotations)
+  // applying Givens rotations). the s-step variant needs it for recovering
+  // the Hessenberg matrix from the block orthogonalization
   FullMatrix<double> H_orig;
-  if (do_eigenvalues)
+  if (do_eigenvalues || s_step_size > 1)
     H_orig.reinit(n_tmp_vectors, n_tmp_vectors - 1);
 
   // matrix used for the orthogonalization process later
@@ -926,6 +1136,94 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
             (iteration_state == SolverControl::iterate));
            ++inner_iteration)
         {
+          // s-step variant: generate a block of new basis vectors by
+          // repeated application of the operator to the last basis vector
+          // and orthogonalize them as a block
+          const unsigned int n_block =
+            std::min(s_step_size, n_tmp_vectors - 2 - inner_iteration);
+          if (n_block > 1)
+            {
+              const unsigned int first_new = inner_iteration + 1;
+              for (unsigned int j = 0; j < n_block; ++j)
+                {
+                  VectorType &w = tmp_vectors(first_new + j, x);
+                  if (left_precondition)
+                    {
+                      A.vmult(p, tmp_vectors[inner_iteration + j]);
+                      preconditioner.vmult(w, p);
+                    }
+                  else
+                    {
+                      preconditioner.vmult(p, tmp_vectors[inner_iteration + j]);
+                      A.vmult(w, p);
+                    }
+                }
+
+              // two passes of block Gram-Schmidt: W = V (C1 + C2 R1) + Q R2 R1
+              FullMatrix<double> C1, R1, C2, R2;
+              if (internal::SolverGMRESImplementation::block_orthogonalize(
+                    tmp_vectors, first_new, n_block, C1, R1) &&
+                  internal::SolverGMRESImplementation::block_orthogonalize(
+                    tmp_vectors, first_new, n_block, C2, R2))
+                {
+                  // the upper triangular matrix R_hat with [V W] = [V Q]
+                  // R_hat, where the leading block for V is the identity
+                  const unsigned int n_vectors = first_new + n_block;
+                  FullMatrix<double> R_hat(n_vectors, n_vectors);
+                  for (unsigned int i = 0; i < first_new; ++i)
+                    R_hat(i, i) = 1.;
+                  for (unsigned int j = 0; j < n_block; ++j)
+                    for (unsigned int k = 0; k <= j; ++k)
+                      {
+                        for (unsigned int i = 0; i < first_new; ++i)
+                          R_hat(i, first_new + j) +=
+                            (k == 0 ? C1(i, j) : 0.) + C2(i, k) * R1(k, j);
+                        for (unsigned int i = 0; i <= k; ++i)
+                          R_hat(first_new + i, first_new + j) +=
+                            R2(i, k) * R1(k, j);
+                      }
+
+                  // recover the columns of the Hessenberg matrix from the
+                  // relation op(z_c) = z_{c+1} of the monomial basis, and
+                  // proceed with the Givens rotations and the convergence
+                  // check column by column like for the classical variant
+                  for (unsigned int c = inner_iteration;
+                       c < inner_iteration + n_block &&
+                       iteration_state == SolverControl::iterate;
+                       ++c)
+                    {
+                      ++accumulated_iterations;
+                      h.reinit(n_tmp_vectors - 1);
+                      for (unsigned int i = 0; i <= c + 1; ++i)
+                        {
+                          double entry = R_hat(i, c + 1);
+                          for (unsigned int k = 0; k < c; ++k)
+                            entry -= R_hat(k, c) * H_orig(i, k);
+                          h(i) = entry / R_hat(c, c);
+                        }
+                      for (unsigned int i = 0; i <= c + 1; ++i)
+                        H_orig(i, c) = h(i);
+
+                      dim = c + 1;
+                      givens_rotation(h, gamma, ci, si, c);
+                      for (unsigned int i = 0; i < dim; ++i)
+                        H(i, c) = h(i);
+
+                      rho      = std::fabs(gamma(dim));
+                      last_res = rho;
+                      iteration_state =
+                        this->iteration_status(accumulated_iterations, rho, x);
+                    }
+
+                  inner_iteration = dim - 1;
+                  continue;
+                }
+
+              // the block was numerically rank-deficient: compute the next
+              // basis vector with the classical algorithm below and try
+              // again with a block in the next step
+            }
+
           ++accumulated_iterations;
           // yet another alias
           VectorType &vv = tmp_vectors(inner_iteration + 1, x);
@@ -959,7 +1257,7 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           // for eigenvalues, get the resulting coefficients from the
           // orthogonalization process
-          if (do_eigenvalues)
+          if (do_eigenvalues || s_step_size > 1)
             for (unsigned int i = 0; i < dim + 1; ++i)
               H_orig(i, inner_iteration) = h(i);
 
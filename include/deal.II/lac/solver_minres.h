@@ -23,6 +23,7 @@
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/fused_vector_operation.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 
@@ -147,6 +148,108 @@ protected:
 
 #ifndef DOXYGEN
 
+namespace internal
+{
+  namespace SolverMinResImplementation
+  {
+    /**
+     * Compute $u = u + a w$ and return the inner product $u \cdot v$.
+     */
+    template <typename VectorType>
+    double
+    add_and_dot(VectorType &      u,
+                const double      a,
+                const VectorType &w,
+                const VectorType &v)
+    {
+      u.add(a, w);
+      return u * v;
+    }
+
+
+
+    /**
+     * Compute the new search direction $m_0 = (m_0 - e m_1 - f m_2) / d$ and
+     * add $\tau m_0$ to the solution $x$. The term with $m_2$ is skipped if
+     * @p f is zero.
+     */
+    template <typename VectorType>
+    void
+    update_direction_and_solution(VectorType &      m0,
+                                  const double      d,
+                                  const double      e,
+                                  const VectorType &m1,
+                                  const double      f,
+                                  const VectorType &m2,
+                                  const double      tau,
+                                  VectorType &      x)
+    {
+      m0.add(-e, m1);
+      if (f != 0.)
+        m0.add(-f, m2);
+      m0 *= 1. / d;
+      x.add(tau, m0);
+    }
+
+
+
+    /**
+     * Same as the general add_and_dot() for
+     * LinearAlgebra::distributed::Vector, where the update and the inner
+     * product are done in a single sweep through the vectors by
+     * LinearAlgebra::FusedVectorOperation. This changes the summation
+     * order of the inner product compared to the general version.
+     */
+    template <typename Number>
+    double
+    add_and_dot(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      u,
+      const double                                                         a,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &w,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &v)
+    {
+      LinearAlgebra::FusedVectorOperation<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        update;
+      update.add(u, a, w);
+      update.dot(u, v);
+      return update.apply()[0];
+    }
+
+
+
+    /**
+     * Same as the general update_direction_and_solution() for
+     * LinearAlgebra::distributed::Vector, where the direction and the
+     * solution are updated in a single sweep through the vectors.
+     */
+    template <typename Number>
+    void
+    update_direction_and_solution(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      m0,
+      const double                                                         d,
+      const double                                                         e,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &m1,
+      const double                                                         f,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &m2,
+      const double                                                         tau,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      x)
+    {
+      LinearAlgebra::FusedVectorOperation<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        update;
+      if (f != 0.)
+        update.sadd(m0, 1. / d, -e / d, m1, -f / d, m2);
+      else
+        update.sadd(m0, 1. / d, -e / d, m1);
+      update.add(x, tau, m0);
+      update.apply();
+    }
+  } // namespace SolverMinResImplementation
+} // namespace internal
+
+
+
 template <class VectorType>
 SolverMinRes<VectorType>::SolverMinRes(SolverControl &           cn,
                                        VectorMemory<VectorType> &mem,
@@ -271,9 +374,10 @@ SolverMinRes<VectorType>::solve(const MatrixType &        A,
         v.reinit(b);
 
       A.vmult(*u[2], v);
-      u[2]->add(-std::sqrt(delta[1] / delta[0]), *u[0]);
 
-      const double gamma = *u[2] * v;
+      const double gamma = internal::SolverMinResImplementation::add_and_dot(
+        *u[2], -std::sqrt(delta[1] / delta[0]), *u[0], v);
+
       u[2]->add(-gamma / std::sqrt(delta[1]), *u[1]);
       *m[0] = v;
 
@@ -311,11 +415,8 @@ SolverMinRes<VectorType>::solve(const MatrixType &        A,
       if (j == 1)
         tau = r0 * c;
 
-      m[0]->add(-e[0], *m[1]);
-      if (j > 1)
-        m[0]->add(-f[0], *m[2]);
-      *m[0] *= 1. / d;
-      x.add(tau, *m[0]);
+      internal::SolverMinResImplementation::update_direction_and_solution(
+        *m[0], d, e[0], *m[1], j > 1 ? f[0] : 0., *m[2], tau, x);
       r_l2 *= std::fabs(s);
 
       conv = this->iteration_status(j, r_l2, x);
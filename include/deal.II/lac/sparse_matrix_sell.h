@@ -0,0 +1,1042 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A sparse matrix stored in the SELL-C-$\sigma$ format (sliced ELLPACK with
+ * local row sorting), see M. Kreutzer, G. Hager, G. Wellein, H. Fehske, A. R.
+ * Bishop, "A unified sparse matrix data format for efficient general sparse
+ * matrix-vector multiplication on modern processors with wide SIMD units",
+ * SIAM J. Sci. Comput. 36(5), C401-C423, 2014.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ rows, where $C$ is
+ * the number of lanes of VectorizedArray<number>. Within each chunk, the
+ * entries are stored column-major, i.e., the first entry of all $C$ rows,
+ * then the second entry of all rows, and so on, padded with zeros up to the
+ * length of the longest row in the chunk. This allows to perform the
+ * matrix-vector product with one SIMD lane per row and contiguous loads of
+ * the matrix entries, such that the inner loop of vmult() is fully
+ * vectorized. In order to keep the amount of padding small, rows are sorted
+ * by their length within windows of $\sigma$ consecutive rows before they are
+ * assigned to chunks. The permutation is only an internal detail of this
+ * class; all functions take and return vectors in the original numbering.
+ *
+ * The class is not meant to be assembled into. Rather, it is built from an
+ * existing SparsityPattern with reinit() and filled with the entries of a
+ * SparseMatrix using copy_from(), which can be called repeatedly as long as
+ * the sparsity pattern does not change. The class provides the interface
+ * needed by SolverCG and the other iterative solvers, by PreconditionJacobi
+ * (through precondition_Jacobi()) and by PreconditionChebyshev (through el()
+ * for extracting the diagonal).
+ *
+ * Since the vectorized gather in vmult() works on 32-bit offsets, the
+ * number of columns of the matrix is restricted to the range of <tt>unsigned
+ * int</tt>.
+ *
+ * <h3>Mixed-precision storage</h3>
+ *
+ * The matrix-vector product is memory bound, and the amount of data to be
+ * loaded per nonzero entry is the size of the value plus the size of the
+ * column index. Both can be reduced with this class:
+ * <ul>
+ * <li> The value type @p number of the matrix can differ from the value type
+ * of the vectors. In particular, a SparseMatrixSELL<float> can be applied to
+ * vectors of type Vector<double>. In that case, the matrix entries are
+ * converted to the vector's number type before the multiplication, and the
+ * product is accumulated in the vector's precision. This is the typical
+ * setting of smoothers and preconditioners in multigrid methods, where the
+ * accuracy of the matrix entries is not critical but the outer iteration
+ * needs double precision.
+ * <li> If AdditionalData::compress_column_indices is set, the column indices
+ * of each chunk are stored as 16-bit offsets relative to the smallest column
+ * in the chunk whenever all columns of the chunk lie within a range of
+ * 65536 columns, which is the case for most chunks of matrices from finite
+ * element discretizations with a bandwidth-reducing numbering such as
+ * DoFRenumbering::Cuthill_McKee(). The remaining chunks keep their 32-bit
+ * indices.
+ * </ul>
+ * Combining both options, a single-precision matrix needs six bytes per
+ * nonzero entry as opposed to twelve bytes for a SparseMatrix<double> with
+ * 32-bit indices.
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * Collection of options for the setup of the storage layout.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const unsigned int sigma = 32 * VectorizedArray<number>::size(),
+      const bool         compress_column_indices = false);
+
+    /**
+     * The size of the window within which rows are sorted by their number of
+     * entries. A value of one disables sorting. The value is rounded up to a
+     * multiple of the chunk size VectorizedArray<number>::size(). Large
+     * values reduce the amount of padding in the chunks but make the access
+     * into the source and destination vectors of vmult() less local.
+     */
+    unsigned int sigma;
+
+    /**
+     * If set to true, store the column indices of those chunks whose columns
+     * span less than 65536 entries as 16-bit offsets relative to the first
+     * column in the chunk, reducing the memory traffic in vmult().
+     */
+    bool compress_column_indices;
+  };
+
+  /**
+   * Constructor. Initialize an empty matrix.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor. Set up the storage layout for the given sparsity pattern
+   * and copy the entries of the given matrix, which must be based on
+   * the same sparsity pattern.
+   */
+  template <typename number2>
+  explicit SparseMatrixSELL(
+    const SparseMatrix<number2> &matrix,
+    const AdditionalData &       additional_data = AdditionalData());
+
+  /**
+   * Set up the storage layout for the given sparsity pattern. All entries
+   * are set to zero. The sparsity pattern is not needed any more after this
+   * call, but subsequent calls to copy_from() must pass matrices based on a
+   * pattern with the same structure.
+   */
+  void
+  reinit(const SparsityPattern &sparsity,
+         const AdditionalData & additional_data = AdditionalData());
+
+  /**
+   * Set up the storage layout for the sparsity pattern of the given matrix
+   * and copy its entries.
+   */
+  template <typename number2>
+  void
+  reinit(const SparseMatrix<number2> &matrix,
+         const AdditionalData &       additional_data = AdditionalData());
+
+  /**
+   * Copy the entries of the given matrix into the storage of this object.
+   * The sparsity pattern of @p matrix must have the same structure as the
+   * one passed to reinit().
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Reset the object to the state of the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the object is empty.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return the number of rows of this matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of this matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the matrix, not counting the
+   * padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries that are actually stored, including the
+   * zeros padded into the chunks. The ratio between this number and
+   * n_nonzero_elements() measures the overhead of the storage format.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Return the value of the entry (<i>i,j</i>), or zero if the entry is not
+   * part of the sparsity pattern. This function searches the row and is
+   * hence slow; it is meant for the setup of preconditioners and for
+   * debugging.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Return the diagonal entry in row @p i.
+   */
+  number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst = M*src</i>. The vector types
+   * must provide contiguous access to their (locally owned) elements via
+   * <tt>begin()</tt>, which is the case for Vector and
+   * LinearAlgebra::distributed::Vector on a single process.
+   */
+  template <class VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Matrix-vector multiplication with the transposed matrix: let <i>dst =
+   * M<sup>T</sup>*src</i>. This operation is not vectorized and runs on a
+   * single thread because the columns of the matrix are scattered.
+   */
+  template <class VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: let <i>dst += M*src</i>.
+   */
+  template <class VectorType>
+  void
+  vmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding transposed matrix-vector multiplication: let <i>dst +=
+   * M<sup>T</sup>*src</i>.
+   */
+  template <class VectorType>
+  void
+  Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * @p src vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor @p omega.
+   */
+  template <class VectorType>
+  void
+  precondition_Jacobi(VectorType &      dst,
+                      const VectorType &src,
+                      const number      omega = 1.) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcTooManyColumns,
+                   "The SELL-C-sigma format uses 32-bit column indices, but "
+                   "the matrix has more columns than can be represented.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+
+  //@}
+
+private:
+  /**
+   * Return the column index of the entry stored in lane @p lane of position
+   * @p k within the arrays of chunk @p chunk, where @p k runs from
+   * <tt>chunk_start[chunk]</tt> to <tt>chunk_start[chunk+1]</tt>.
+   */
+  unsigned int
+  column(const unsigned int chunk,
+         const std::size_t  k,
+         const unsigned int lane) const;
+
+  /**
+   * Perform the matrix-vector product on the chunks in the half-open range
+   * [@p begin_chunk, @p end_chunk).
+   */
+  template <typename Number2>
+  void
+  vmult_on_subrange(const unsigned int begin_chunk,
+                    const unsigned int end_chunk,
+                    const Number2 *    src,
+                    Number2 *          dst,
+                    const bool         add) const;
+
+  /**
+   * The number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * The number of nonzero entries in the matrix without the padding.
+   */
+  std::size_t n_nonzeros;
+
+  /**
+   * The start of each chunk within the array #values. The entries of chunk
+   * @p c are located in the range <tt>[chunk_start[c], chunk_start[c+1])</tt>,
+   * with the width of the chunk being the difference between the two.
+   */
+  std::vector<std::size_t> chunk_start;
+
+  /**
+   * The start of the column indices of each chunk within either #colnums or
+   * #compressed_colnums (divided by the chunk size), depending on whether
+   * the indices of the chunk are compressed.
+   */
+  std::vector<std::size_t> colnum_start;
+
+  /**
+   * For chunks with compressed column indices, the column that the 16-bit
+   * offsets in #compressed_colnums refer to. For other chunks, the value is
+   * numbers::invalid_unsigned_int.
+   */
+  std::vector<unsigned int> chunk_first_column;
+
+  /**
+   * The matrix entries, one VectorizedArray per chunk and position within
+   * the rows of the chunk.
+   */
+  AlignedVector<VectorizedArray<number>> values;
+
+  /**
+   * The column indices of the chunks without compression, stored as
+   * VectorizedArray<number>::size() indices per entry in #values. Padded
+   * entries refer to column zero.
+   */
+  std::vector<unsigned int> colnums;
+
+  /**
+   * The column indices of the compressed chunks as offsets to
+   * #chunk_first_column. Padded entries have offset zero.
+   */
+  std::vector<std::uint16_t> compressed_colnums;
+
+  /**
+   * For each lane of each chunk, the row of the matrix it represents, or
+   * numbers::invalid_unsigned_int for the lanes of the last chunk that
+   * exceed the number of rows.
+   */
+  std::vector<unsigned int> chunk_rows;
+
+  /**
+   * For each row of the matrix, the index of the lane in #chunk_rows that
+   * holds the row.
+   */
+  std::vector<unsigned int> row_to_lane;
+
+  /**
+   * The number of entries in each row of the matrix.
+   */
+  std::vector<unsigned int> row_lengths;
+
+  /**
+   * The diagonal of the matrix, extracted during copy_from() for fast access
+   * in precondition_Jacobi(). Empty for non-square matrices.
+   */
+  AlignedVector<number> diagonal;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+namespace internal
+{
+  namespace SparseMatrixSELLImplementation
+  {
+    /**
+     * Compute the product of the @p width entries of a chunk starting at
+     * @p values with the entries of @p src at the column indices given by
+     * @p indices, and write the VectorizedArray<number>::size() results into
+     * @p result. This is the general variant for a vector number type
+     * different from the matrix number type, which converts the matrix
+     * entries to @p Number2 and accumulates in the precision of the vector.
+     */
+    template <typename number, typename Number2, typename IndexType>
+    inline void
+    chunk_vmult(const VectorizedArray<number> *values,
+                const IndexType *              indices,
+                const std::size_t              width,
+                const Number2 *                src,
+                Number2 *                      result)
+    {
+      constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        result[v] = Number2();
+      for (std::size_t k = 0; k < width; ++k)
+        {
+          const number *   val_ptr = &values[k][0];
+          const IndexType *col_ptr = indices + k * n_lanes;
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            result[v] += static_cast<Number2>(val_ptr[v]) * src[col_ptr[v]];
+        }
+    }
+
+
+
+    /**
+     * Same as above, but for matrix and vector entries of the same type,
+     * where the product is computed with a vectorized gather of the source
+     * vector entries.
+     */
+    template <typename number, typename IndexType>
+    inline void
+    chunk_vmult(const VectorizedArray<number> *values,
+                const IndexType *              indices,
+                const std::size_t              width,
+                const number *                 src,
+                number *                       result)
+    {
+      constexpr unsigned int  n_lanes = VectorizedArray<number>::size();
+      VectorizedArray<number> sum     = number();
+      for (std::size_t k = 0; k < width; ++k)
+        {
+          unsigned int offsets[n_lanes];
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            offsets[v] = indices[k * n_lanes + v];
+          VectorizedArray<number> src_values;
+          src_values.gather(src, offsets);
+          sum += values[k] * src_values;
+        }
+      sum.store(result);
+    }
+  } // namespace SparseMatrixSELLImplementation
+} // namespace internal
+
+
+
+template <typename number>
+inline SparseMatrixSELL<number>::AdditionalData::AdditionalData(
+  const unsigned int sigma,
+  const bool         compress_column_indices)
+  : sigma(sigma)
+  , compress_column_indices(compress_column_indices)
+{}
+
+
+
+template <typename number>
+inline SparseMatrixSELL<number>::SparseMatrixSELL()
+  : n_rows(0)
+  , n_cols(0)
+  , n_nonzeros(0)
+{}
+
+
+
+template <typename number>
+template <typename number2>
+inline SparseMatrixSELL<number>::SparseMatrixSELL(
+  const SparseMatrix<number2> &matrix,
+  const AdditionalData &       additional_data)
+  : SparseMatrixSELL()
+{
+  reinit(matrix, additional_data);
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::reinit(const SparsityPattern &sparsity,
+                                 const AdditionalData & additional_data)
+{
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  const size_type max_index = std::numeric_limits<unsigned int>::max();
+  AssertThrow(sparsity.n_cols() <= max_index, ExcTooManyColumns());
+  AssertThrow(sparsity.n_rows() < max_index, ExcTooManyColumns());
+
+  n_rows     = sparsity.n_rows();
+  n_cols     = sparsity.n_cols();
+  n_nonzeros = sparsity.n_nonzero_elements();
+
+  row_lengths.resize(n_rows);
+  for (size_type row = 0; row < n_rows; ++row)
+    row_lengths[row] = sparsity.row_length(row);
+
+  // sort the rows by decreasing length within each window of sigma rows,
+  // with sigma rounded up to a multiple of the chunk size. Use a stable sort
+  // in order to preserve the order of rows with the same length, which
+  // keeps the access to the vectors as local as possible.
+  const unsigned int sigma =
+    std::max(1U, (additional_data.sigma + n_lanes - 1) / n_lanes) * n_lanes;
+  const unsigned int n_chunks = (n_rows + n_lanes - 1) / n_lanes;
+  chunk_rows.resize(n_chunks * n_lanes);
+  std::iota(chunk_rows.begin(), chunk_rows.begin() + n_rows, 0U);
+  std::fill(chunk_rows.begin() + n_rows,
+            chunk_rows.end(),
+            numbers::invalid_unsigned_int);
+  if (additional_data.sigma > 1)
+    for (unsigned int start = 0; start < n_rows; start += sigma)
+      std::stable_sort(chunk_rows.begin() + start,
+                       chunk_rows.begin() +
+                         std::min<std::size_t>(start + sigma, n_rows),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return row_lengths[a] > row_lengths[b];
+                       });
+
+  row_to_lane.resize(n_rows);
+  for (unsigned int lane = 0; lane < n_rows; ++lane)
+    row_to_lane[chunk_rows[lane]] = lane;
+
+  chunk_start.resize(n_chunks + 1);
+  chunk_start[0] = 0;
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    {
+      unsigned int width = 0;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        if (chunk_rows[c * n_lanes + v] != numbers::invalid_unsigned_int)
+          width = std::max(width, row_lengths[chunk_rows[c * n_lanes + v]]);
+      chunk_start[c + 1] = chunk_start[c] + width;
+    }
+
+  const unsigned int grain_size = std::max<unsigned int>(
+    1U,
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      n_lanes);
+
+  // determine which chunks can store their column indices as 16-bit offsets
+  // relative to the smallest column in the chunk
+  chunk_first_column.clear();
+  chunk_first_column.resize(n_chunks, numbers::invalid_unsigned_int);
+  if (additional_data.compress_column_indices)
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            unsigned int min_column = numbers::invalid_unsigned_int;
+            unsigned int max_column = 0;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                const unsigned int row = chunk_rows[c * n_lanes + v];
+                if (row != numbers::invalid_unsigned_int)
+                  for (auto it = sparsity.begin(row); it != sparsity.end(row);
+                       ++it)
+                    {
+                      const unsigned int col = it->column();
+                      min_column             = std::min(min_column, col);
+                      max_column             = std::max(max_column, col);
+                    }
+              }
+            if (min_column == numbers::invalid_unsigned_int)
+              chunk_first_column[c] = 0;
+            else if (max_column - min_column <=
+                     std::numeric_limits<std::uint16_t>::max())
+              chunk_first_column[c] = min_column;
+          }
+      },
+      grain_size);
+
+  colnum_start.resize(n_chunks + 1);
+  std::size_t n_compressed = 0, n_uncompressed = 0;
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    {
+      const std::size_t width = chunk_start[c + 1] - chunk_start[c];
+      if (chunk_first_column[c] == numbers::invalid_unsigned_int)
+        {
+          colnum_start[c] = n_uncompressed;
+          n_uncompressed += width;
+        }
+      else
+        {
+          colnum_start[c] = n_compressed;
+          n_compressed += width;
+        }
+    }
+
+  values.resize_fast(chunk_start.back());
+  colnums.resize(n_uncompressed * n_lanes);
+  compressed_colnums.resize(n_compressed * n_lanes);
+
+  // fill the column indices and zero the values. Lanes beyond the length of
+  // the respective row refer to the first column of the chunk with value
+  // zero, so that vmult() does not need to distinguish them.
+  parallel::apply_to_subranges(
+    0U,
+    n_chunks,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          const std::size_t  width = chunk_start[c + 1] - chunk_start[c];
+          const unsigned int first_column = chunk_first_column[c];
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const unsigned int row = chunk_rows[c * n_lanes + v];
+              std::size_t        k   = 0;
+              if (first_column == numbers::invalid_unsigned_int)
+                {
+                  unsigned int *col_ptr =
+                    colnums.data() + colnum_start[c] * n_lanes + v;
+                  if (row != numbers::invalid_unsigned_int)
+                    for (auto it = sparsity.begin(row);
+                         it != sparsity.end(row);
+                         ++it, ++k)
+                      col_ptr[k * n_lanes] = it->column();
+                  for (; k < width; ++k)
+                    col_ptr[k * n_lanes] = 0;
+                }
+              else
+                {
+                  std::uint16_t *col_ptr =
+                    compressed_colnums.data() + colnum_start[c] * n_lanes + v;
+                  if (row != numbers::invalid_unsigned_int)
+                    for (auto it = sparsity.begin(row);
+                         it != sparsity.end(row);
+                         ++it, ++k)
+                      col_ptr[k * n_lanes] = it->column() - first_column;
+                  for (; k < width; ++k)
+                    col_ptr[k * n_lanes] = 0;
+                }
+            }
+        }
+      for (std::size_t k = chunk_start[begin]; k < chunk_start[end]; ++k)
+        values[k] = number();
+    },
+    grain_size);
+
+  diagonal.clear();
+  if (n_rows == n_cols)
+    diagonal.resize(n_rows, number());
+}
+
+
+
+template <typename number>
+template <typename number2>
+inline void
+SparseMatrixSELL<number>::reinit(const SparseMatrix<number2> &matrix,
+                                 const AdditionalData &       additional_data)
+{
+  reinit(matrix.get_sparsity_pattern(), additional_data);
+  copy_from(matrix);
+}
+
+
+
+template <typename number>
+template <typename number2>
+inline void
+SparseMatrixSELL<number>::copy_from(const SparseMatrix<number2> &matrix)
+{
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  AssertDimension(matrix.m(), n_rows);
+  AssertDimension(matrix.n(), n_cols);
+  AssertDimension(matrix.n_nonzero_elements(), n_nonzeros);
+
+  const unsigned int n_chunks = chunk_start.size() - 1;
+  parallel::apply_to_subranges(
+    0U,
+    n_chunks,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int c = begin; c < end; ++c)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            const unsigned int row = chunk_rows[c * n_lanes + v];
+            if (row == numbers::invalid_unsigned_int)
+              continue;
+            AssertDimension(matrix.get_row_length(row), row_lengths[row]);
+            std::size_t k = chunk_start[c];
+            for (auto it = matrix.begin(row); it != matrix.end(row); ++it, ++k)
+              {
+                Assert(column(c, k, v) == it->column(),
+                       ExcMessage("The sparsity pattern of the matrix does "
+                                  "not match the one given to reinit()."));
+                values[k][v] = static_cast<number>(it->value());
+              }
+            if (diagonal.size() > 0)
+              diagonal[row] = static_cast<number>(matrix.diag_element(row));
+          }
+    },
+    std::max<unsigned int>(
+      1U,
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        n_lanes));
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::clear()
+{
+  n_rows     = 0;
+  n_cols     = 0;
+  n_nonzeros = 0;
+  chunk_start.clear();
+  colnum_start.clear();
+  chunk_first_column.clear();
+  values.clear();
+  colnums.clear();
+  compressed_colnums.clear();
+  chunk_rows.clear();
+  row_to_lane.clear();
+  row_lengths.clear();
+  diagonal.clear();
+}
+
+
+
+template <typename number>
+inline bool
+SparseMatrixSELL<number>::empty() const
+{
+  return n_rows == 0 || n_cols == 0;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  return n_nonzeros;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size() * VectorizedArray<number>::size();
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::el(const size_type i, const size_type j) const
+{
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_cols);
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  const unsigned int lane  = row_to_lane[i];
+  const unsigned int chunk = lane / n_lanes;
+  const unsigned int v     = lane % n_lanes;
+  for (std::size_t k = chunk_start[chunk];
+       k < chunk_start[chunk] + row_lengths[i];
+       ++k)
+    if (column(chunk, k, v) == j)
+      return values[k][v];
+  return number();
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::diag_element(const size_type i) const
+{
+  Assert(diagonal.size() == n_rows, ExcNotQuadratic());
+  AssertIndexRange(i, n_rows);
+  return diagonal[i];
+}
+
+
+
+template <typename number>
+inline unsigned int
+SparseMatrixSELL<number>::column(const unsigned int chunk,
+                                 const std::size_t  k,
+                                 const unsigned int lane) const
+{
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+  const std::size_t      index =
+    (colnum_start[chunk] + k - chunk_start[chunk]) * n_lanes + lane;
+  if (chunk_first_column[chunk] == numbers::invalid_unsigned_int)
+    return colnums[index];
+  else
+    return chunk_first_column[chunk] + compressed_colnums[index];
+}
+
+
+
+template <typename number>
+template <typename Number2>
+inline void
+SparseMatrixSELL<number>::vmult_on_subrange(const unsigned int begin_chunk,
+                                            const unsigned int end_chunk,
+                                            const Number2 *    src,
+                                            Number2 *          dst,
+                                            const bool         add) const
+{
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  for (unsigned int c = begin_chunk; c < end_chunk; ++c)
+    {
+      const std::size_t width        = chunk_start[c + 1] - chunk_start[c];
+      const unsigned int first_column = chunk_first_column[c];
+      Number2           sum[n_lanes];
+      if (first_column == numbers::invalid_unsigned_int)
+        internal::SparseMatrixSELLImplementation::chunk_vmult(
+          values.begin() + chunk_start[c],
+          colnums.data() + colnum_start[c] * n_lanes,
+          width,
+          src,
+          sum);
+      else
+        internal::SparseMatrixSELLImplementation::chunk_vmult(
+          values.begin() + chunk_start[c],
+          compressed_colnums.data() + colnum_start[c] * n_lanes,
+          width,
+          src + first_column,
+          sum);
+
+      const unsigned int *rows = chunk_rows.data() + c * n_lanes;
+      if (add)
+        {
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            if (rows[v] != numbers::invalid_unsigned_int)
+              dst[rows[v]] += sum[v];
+        }
+      else
+        {
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            if (rows[v] != numbers::invalid_unsigned_int)
+              dst[rows[v]] = sum[v];
+        }
+    }
+}
+
+
+
+template <typename number>
+template <class VectorType>
+inline void
+SparseMatrixSELL<number>::vmult(VectorType &dst, const VectorType &src) const
+{
+  AssertDimension(dst.size(), n_rows);
+  AssertDimension(src.size(), n_cols);
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_subrange(begin, end, src.begin(), dst.begin(), false);
+    },
+    std::max<unsigned int>(
+      1U,
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        VectorizedArray<number>::size()));
+}
+
+
+
+template <typename number>
+template <class VectorType>
+inline void
+SparseMatrixSELL<number>::vmult_add(VectorType &      dst,
+                                    const VectorType &src) const
+{
+  AssertDimension(dst.size(), n_rows);
+  AssertDimension(src.size(), n_cols);
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_subrange(begin, end, src.begin(), dst.begin(), true);
+    },
+    std::max<unsigned int>(
+      1U,
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        VectorizedArray<number>::size()));
+}
+
+
+
+template <typename number>
+template <class VectorType>
+inline void
+SparseMatrixSELL<number>::Tvmult(VectorType &dst, const VectorType &src) const
+{
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <class VectorType>
+inline void
+SparseMatrixSELL<number>::Tvmult_add(VectorType &      dst,
+                                     const VectorType &src) const
+{
+  AssertDimension(dst.size(), n_cols);
+  AssertDimension(src.size(), n_rows);
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+  constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  using Number2 = typename VectorType::value_type;
+  const Number2 *src_ptr = src.begin();
+  Number2 *      dst_ptr = dst.begin();
+  for (unsigned int c = 0; c + 1 < chunk_start.size(); ++c)
+    for (unsigned int v = 0; v < n_lanes; ++v)
+      {
+        const unsigned int row = chunk_rows[c * n_lanes + v];
+        if (row == numbers::invalid_unsigned_int)
+          continue;
+        const Number2 src_value = src_ptr[row];
+        const std::size_t end = chunk_start[c] + row_lengths[row];
+        for (std::size_t k = chunk_start[c]; k < end; ++k)
+          dst_ptr[column(c, k, v)] +=
+            static_cast<Number2>(values[k][v]) * src_value;
+      }
+}
+
+
+
+template <typename number>
+template <class VectorType>
+inline void
+SparseMatrixSELL<number>::precondition_Jacobi(VectorType &      dst,
+                                              const VectorType &src,
+                                              const number      omega) const
+{
+  Assert(diagonal.size() == n_rows, ExcNotQuadratic());
+  AssertDimension(dst.size(), n_rows);
+  AssertDimension(src.size(), n_rows);
+
+  using Number2          = typename VectorType::value_type;
+  const Number2 *src_ptr = src.begin();
+  Number2 *      dst_ptr = dst.begin();
+  for (size_type i = 0; i < n_rows; ++i)
+    {
+      Assert(diagonal[i] != number(), ExcDivideByZero());
+      dst_ptr[i] = static_cast<Number2>(omega) * src_ptr[i] /
+                   static_cast<Number2>(diagonal[i]);
+    }
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_start) +
+         MemoryConsumption::memory_consumption(colnum_start) +
+         MemoryConsumption::memory_consumption(chunk_first_column) +
+         MemoryConsumption::memory_consumption(values) +
+         MemoryConsumption::memory_consumption(colnums) +
+         MemoryConsumption::memory_consumption(compressed_colnums) +
+         MemoryConsumption::memory_consumption(chunk_rows) +
+         MemoryConsumption::memory_consumption(row_to_lane) +
+         MemoryConsumption::memory_consumption(row_lengths) +
+         MemoryConsumption::memory_consumption(diagonal);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -1053,6 +1053,12 @@ public:
    *
    * SparseMatrix objects require the SparsityPattern objects they are
    * initialized with to be compressed, to reduce memory requirements.
+   *
+   * The rows are processed in parallel on the threads of the task scheduler,
+   * using the same subranges of rows as SparseMatrix::vmult(). Since the
+   * new arrays are first written by the threads that own the respective
+   * rows, the memory is placed close to the threads working on these rows
+   * later on systems with first-touch memory policy (NUMA).
    */
   void
   compress();
@@ -1144,6 +1150,10 @@ public:
   /**
    * Copy data from a DynamicSparsityPattern. Previous content of this object
    * is lost, and the sparsity pattern is in compressed mode afterwards.
+   *
+   * Like compress(), this function works on subranges of rows in parallel
+   * and lets the thread working on a range be the first one to write the
+   * respective entries of the arrays of this object.
    */
   void
   copy_from(const DynamicSparsityPattern &dsp);
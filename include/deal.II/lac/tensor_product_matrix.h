@@ -121,6 +121,19 @@ public:
   apply_inverse(const ArrayView<Number> &      dst,
                 const ArrayView<const Number> &src) const;
 
+  /**
+   * Same as above, but using the array @p tmp with at least m() entries for
+   * intermediate results instead of the temporary array stored in this
+   * class. As this function does not need to acquire the mutex guarding the
+   * internal array, it can be called concurrently from several threads on
+   * the same object, e.g. when a matrix is shared between many cells in a
+   * parallel loop.
+   */
+  void
+  apply_inverse(const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src,
+                const ArrayView<Number> &      tmp) const;
+
 protected:
   /**
    * Default constructor.
@@ -553,12 +566,28 @@ inline void
 TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
   const ArrayView<Number> &      dst_view,
   const ArrayView<const Number> &src_view) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  tmp_array.resize_fast(this->m());
+  apply_inverse(dst_view,
+                src_view,
+                make_array_view(tmp_array.begin(), tmp_array.end()));
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
+  const ArrayView<Number> &      dst_view,
+  const ArrayView<const Number> &src_view,
+  const ArrayView<Number> &      tmp_view) const
 {
   AssertDimension(dst_view.size(), this->n());
   AssertDimension(src_view.size(), this->m());
-  std::lock_guard<std::mutex> lock(this->mutex);
+  Assert(tmp_view.size() >= this->m(),
+         ExcDimensionMismatch(tmp_view.size(), this->m()));
   const unsigned int n = n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size();
-  tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
   constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
   internal::EvaluatorTensorProduct<internal::evaluate_general,
                                    dim,
@@ -570,7 +599,7 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
          AlignedVector<Number>(),
          mass_matrix[0].n_rows(),
          mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
+  Number *      t   = tmp_view.data();
   const Number *src = src_view.data();
   Number *      dst = dst_view.data();
 
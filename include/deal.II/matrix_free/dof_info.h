@@ -271,6 +271,18 @@ namespace internal
       compute_face_index_compression(
         const std::vector<FaceToCellTopology<length>> &faces);
 
+      /**
+       * Spread the data of each cell batch to @p n_lanes SIMD lanes, keeping
+       * the cells in the lanes they had before and leaving the additional
+       * lanes empty, and compute the index compression of the cells again.
+       * This is used by MatrixFree::copy_from() to convert to an object with
+       * a wider SIMD array. The compression of the face indices must be
+       * computed afterwards by compute_face_index_compression() with the
+       * faces for the new vectorization length.
+       */
+      void
+      increase_vectorization_length(const unsigned int n_lanes);
+
       /**
        * This function computes the connectivity of the currently stored
        * indices in terms of connections between the individual cells and
@@ -782,6 +794,118 @@ namespace internal
     };
 
 
+
+    /**
+     * A vector of DoFInfo objects, one for each DoFHandler in a MatrixFree
+     * object, whose content can be shared between several MatrixFree
+     * objects. This is used for objects that work on the same DoFHandler
+     * with different number types, e.g. a float and a double variant of an
+     * operator, which then only keep a single copy of the index data.
+     *
+     * Copies of this class refer to the same data. Read access is done on
+     * the shared data, whereas write access first creates a private copy of
+     * the data in case it is shared with another object (copy-on-write).
+     * This way, the re-initialization of one MatrixFree object does not
+     * affect the others.
+     *
+     * @ingroup matrixfree
+     */
+    class DoFInfoCollection
+    {
+    public:
+      /**
+       * Constructor, creating an empty collection.
+       */
+      DoFInfoCollection();
+
+      /**
+       * Return the number of DoFInfo objects.
+       */
+      std::size_t
+      size() const;
+
+      /**
+       * Set the number of DoFInfo objects.
+       */
+      void
+      resize(const std::size_t n);
+
+      /**
+       * Release all data of this object. Other objects sharing the data are
+       * not affected.
+       */
+      void
+      clear();
+
+      /**
+       * Read access to the DoFInfo object with index @p i.
+       */
+      const DoFInfo &operator[](const std::size_t i) const;
+
+      /**
+       * Write access to the DoFInfo object with index @p i.
+       */
+      DoFInfo &operator[](const std::size_t i);
+
+      /**
+       * Iterator to the first DoFInfo object for read access.
+       */
+      std::vector<DoFInfo>::const_iterator
+      begin() const;
+
+      /**
+       * Iterator past the last DoFInfo object for read access.
+       */
+      std::vector<DoFInfo>::const_iterator
+      end() const;
+
+      /**
+       * Iterator to the first DoFInfo object for write access.
+       */
+      std::vector<DoFInfo>::iterator
+      begin();
+
+      /**
+       * Iterator past the last DoFInfo object for write access.
+       */
+      std::vector<DoFInfo>::iterator
+      end();
+
+      /**
+       * Return a reference to the underlying vector for write access, e.g.
+       * to fill it in setup functions.
+       */
+      std::vector<DoFInfo> &
+      get_vector();
+
+      /**
+       * Return whether the data of this object is shared with @p other.
+       */
+      bool
+      is_shared_with(const DoFInfoCollection &other) const;
+
+      /**
+       * Return the memory consumption of this class in bytes. The shared
+       * data is accounted for in all objects that use it.
+       */
+      std::size_t
+      memory_consumption() const;
+
+    private:
+      /**
+       * Create a private copy of the data if it is shared with other
+       * objects.
+       */
+      void
+      make_unique();
+
+      /**
+       * The actual data.
+       */
+      std::shared_ptr<std::vector<DoFInfo>> data;
+    };
+
+
     /*-------------------------- Inline functions ---------------------------*/
 
 #ifndef DOXYGEN
@@ -800,6 +924,116 @@ namespace internal
       return numbers::invalid_unsigned_int;
     }
 
+
+
+    inline DoFInfoCollection::DoFInfoCollection()
+      : data(std::make_shared<std::vector<DoFInfo>>())
+    {}
+
+
+
+    inline std::size_t
+    DoFInfoCollection::size() const
+    {
+      return data->size();
+    }
+
+
+
+    inline void
+    DoFInfoCollection::resize(const std::size_t n)
+    {
+      make_unique();
+      data->resize(n);
+    }
+
+
+
+    inline void
+    DoFInfoCollection::clear()
+    {
+      data = std::make_shared<std::vector<DoFInfo>>();
+    }
+
+
+
+    inline const DoFInfo &
+    DoFInfoCollection::operator[](const std::size_t i) const
+    {
+      AssertIndexRange(i, data->size());
+      return (*data)[i];
+    }
+
+
+
+    inline DoFInfo &
+    DoFInfoCollection::operator[](const std::size_t i)
+    {
+      AssertIndexRange(i, data->size());
+      make_unique();
+      return (*data)[i];
+    }
+
+
+
+    inline std::vector<DoFInfo>::const_iterator
+    DoFInfoCollection::begin() const
+    {
+      return data->cbegin();
+    }
+
+
+
+    inline std::vector<DoFInfo>::const_iterator
+    DoFInfoCollection::end() const
+    {
+      return data->cend();
+    }
+
+
+
+    inline std::vector<DoFInfo>::iterator
+    DoFInfoCollection::begin()
+    {
+      make_unique();
+      return data->begin();
+    }
+
+
+
+    inline std::vector<DoFInfo>::iterator
+    DoFInfoCollection::end()
+    {
+      make_unique();
+      return data->end();
+    }
+
+
+
+    inline std::vector<DoFInfo> &
+    DoFInfoCollection::get_vector()
+    {
+      make_unique();
+      return *data;
+    }
+
+
+
+    inline bool
+    DoFInfoCollection::is_shared_with(const DoFInfoCollection &other) const
+    {
+      return data == other.data;
+    }
+
+
+
+    inline void
+    DoFInfoCollection::make_unique()
+    {
+      if (data.use_count() > 1)
+        data = std::make_shared<std::vector<DoFInfo>>(*data);
+    }
+
 #endif // ifndef DOXYGEN
 
   } // end of namespace MatrixFreeFunctions
@@ -111,8 +111,13 @@ namespace internal
             typename Number>
   struct FEEvaluationImpl
   {
+    // the sizes are only known at run time for fe_degree == -1, in which
+    // case the even-odd decomposition is always at least as cheap as the
+    // plain variant for symmetric elements
     static const EvaluatorVariant variant =
-      EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant;
+      EvaluatorSelector<type,
+                        (fe_degree + n_q_points_1d > 4 ||
+                         fe_degree == -1)>::variant;
 
     using Eval = EvaluatorTensorProduct<variant,
                                         dim,
@@ -178,6 +183,35 @@ namespace internal
               Number *                               values_dofs_actual,
               FEEvaluationData<dim, Number, false> & fe_eval,
               const bool                             add_into_values_array);
+
+    /**
+     * Compute the gradients at the quadrature points from the values at the
+     * quadrature points for quadrature formulas that are tensor products in
+     * the collapsed coordinates of the cell, see
+     * MatrixFreeFunctions::ShapeInfo::n_q_points_1d_collapsed. The
+     * derivatives are computed with one-dimensional collocation derivatives
+     * in the collapsed coordinates and transformed to the reference
+     * coordinates by the chain rule.
+     */
+    static void
+    evaluate_gradients_collapsed(
+      const unsigned int                     n_components,
+      const EvaluationFlags::EvaluationFlags evaluation_flag,
+      const Number *                         values_dofs_actual,
+      FEEvaluationData<dim, Number, false> & fe_eval);
+
+    /**
+     * Transpose operation of evaluate_gradients_collapsed() that sums the
+     * test with the gradients into the values at the quadrature points and
+     * then performs the integration of the values.
+     */
+    static void
+    integrate_collapsed(
+      const unsigned int                     n_components,
+      const EvaluationFlags::EvaluationFlags integration_flag,
+      Number *                               values_dofs_actual,
+      FEEvaluationData<dim, Number, false> & fe_eval,
+      const bool                             add_into_values_array);
   };
 
 
@@ -807,7 +841,13 @@ namespace internal
           }
       }
 
-    if (evaluation_flag & EvaluationFlags::gradients)
+    if ((evaluation_flag & EvaluationFlags::gradients) &&
+        fe_eval.get_shape_info().n_q_points_1d_collapsed > 0)
+      evaluate_gradients_collapsed(n_components,
+                                   evaluation_flag,
+                                   values_dofs_actual,
+                                   fe_eval);
+    else if (evaluation_flag & EvaluationFlags::gradients)
       {
         const auto shape_gradients = shape_data.front().shape_gradients.data();
         auto       gradients_quad_ptr     = fe_eval.begin_gradients();
@@ -855,6 +895,17 @@ namespace internal
     AssertThrow(!(integration_flag & EvaluationFlags::hessians),
                 ExcNotImplemented());
 
+    if ((integration_flag & EvaluationFlags::gradients) &&
+        fe_eval.get_shape_info().n_q_points_1d_collapsed > 0)
+      {
+        integrate_collapsed(n_components,
+                            integration_flag,
+                            values_dofs_actual,
+                            fe_eval,
+                            add_into_values_array);
+        return;
+      }
+
     const std::size_t n_dofs =
       fe_eval.get_shape_info().dofs_per_component_on_cell;
     const std::size_t n_q_points = fe_eval.get_shape_info().n_q_points;
@@ -919,6 +970,175 @@ namespace internal
 
 
 
+  template <int dim, int fe_degree, int n_q_points_1d, typename Number>
+  inline void
+  FEEvaluationImpl<MatrixFreeFunctions::tensor_none,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   Number>::
+    evaluate_gradients_collapsed(
+      const unsigned int                     n_components,
+      const EvaluationFlags::EvaluationFlags evaluation_flag,
+      const Number *                         values_dofs_actual,
+      FEEvaluationData<dim, Number, false> & fe_eval)
+  {
+    const auto &       shape_info  = fe_eval.get_shape_info();
+    const std::size_t  n_dofs      = shape_info.dofs_per_component_on_cell;
+    const std::size_t  n_q_points  = shape_info.n_q_points;
+    const unsigned int n_points_1d = shape_info.n_q_points_1d_collapsed;
+    const auto &matrices = shape_info.shape_gradients_collocation_collapsed;
+    const Number *transformation =
+      shape_info.collapsed_coordinate_transformation.data();
+    AssertDimension(Utilities::fixed_power<dim>(n_points_1d), n_q_points);
+
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>;
+    Eval eval0(nullptr, matrices[0].data(), nullptr, n_points_1d, n_points_1d);
+    Eval eval1(nullptr, matrices[1].data(), nullptr, n_points_1d, n_points_1d);
+    Eval eval2(nullptr, matrices[2].data(), nullptr, n_points_1d, n_points_1d);
+
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        // the gradients are computed from the values in the quadrature
+        // points; if the values are not requested, interpolate them into
+        // the scratch data
+        const Number *values_quad = fe_eval.begin_values() + c * n_q_points;
+        if (!(evaluation_flag & EvaluationFlags::values))
+          {
+            Number *temp = fe_eval.get_scratch_data().begin();
+            EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>
+              eval(shape_info.data.front().shape_values.data(),
+                   nullptr,
+                   nullptr,
+                   n_dofs,
+                   n_q_points);
+            eval.template values<0, true, false>(values_dofs_actual +
+                                                   c * n_dofs,
+                                                 temp);
+            values_quad = temp;
+          }
+
+        Number *gradients_quad =
+          fe_eval.begin_gradients() + c * dim * n_q_points;
+        eval0.template gradients<0, true, false>(values_quad, gradients_quad);
+        if (dim > 1)
+          eval1.template gradients<1, true, false>(values_quad,
+                                                   gradients_quad + n_q_points);
+        if (dim > 2)
+          eval2.template gradients<2, true, false>(values_quad,
+                                                   gradients_quad +
+                                                     2 * n_q_points);
+
+        // apply the chain rule; the transformation is lower triangular, so
+        // we can work in place starting from the last component
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const Number *transformation_q = transformation + q * dim * dim;
+            for (int e = dim - 1; e >= 0; --e)
+              {
+                Number sum = transformation_q[e * dim + e] *
+                             gradients_quad[e * n_q_points + q];
+                for (int d = 0; d < e; ++d)
+                  sum += transformation_q[e * dim + d] *
+                         gradients_quad[d * n_q_points + q];
+                gradients_quad[e * n_q_points + q] = sum;
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_q_points_1d, typename Number>
+  inline void
+  FEEvaluationImpl<MatrixFreeFunctions::tensor_none,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   Number>::
+    integrate_collapsed(
+      const unsigned int                     n_components,
+      const EvaluationFlags::EvaluationFlags integration_flag,
+      Number *                               values_dofs_actual,
+      FEEvaluationData<dim, Number, false> & fe_eval,
+      const bool                             add_into_values_array)
+  {
+    const auto &       shape_info  = fe_eval.get_shape_info();
+    const std::size_t  n_dofs      = shape_info.dofs_per_component_on_cell;
+    const std::size_t  n_q_points  = shape_info.n_q_points;
+    const unsigned int n_points_1d = shape_info.n_q_points_1d_collapsed;
+    const auto &matrices = shape_info.shape_gradients_collocation_collapsed;
+    const Number *transformation =
+      shape_info.collapsed_coordinate_transformation.data();
+    AssertDimension(Utilities::fixed_power<dim>(n_points_1d), n_q_points);
+
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>;
+    Eval eval0(nullptr, matrices[0].data(), nullptr, n_points_1d, n_points_1d);
+    Eval eval1(nullptr, matrices[1].data(), nullptr, n_points_1d, n_points_1d);
+    Eval eval2(nullptr, matrices[2].data(), nullptr, n_points_1d, n_points_1d);
+
+    EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>
+      eval_values(shape_info.data.front().shape_values.data(),
+                  nullptr,
+                  nullptr,
+                  n_dofs,
+                  n_q_points);
+
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        // transpose of the chain rule, working in place starting from the
+        // first component
+        Number *gradients_quad =
+          fe_eval.begin_gradients() + c * dim * n_q_points;
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const Number *transformation_q = transformation + q * dim * dim;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                Number sum = transformation_q[d * dim + d] *
+                             gradients_quad[d * n_q_points + q];
+                for (unsigned int e = d + 1; e < dim; ++e)
+                  sum += transformation_q[e * dim + d] *
+                         gradients_quad[e * n_q_points + q];
+                gradients_quad[d * n_q_points + q] = sum;
+              }
+          }
+
+        // sum the contributions of the collapsed derivatives into the values
+        // in the quadrature points, using the scratch data if no values were
+        // submitted
+        Number *values_quad = fe_eval.begin_values() + c * n_q_points;
+        if (integration_flag & EvaluationFlags::values)
+          eval0.template gradients<0, false, true>(gradients_quad, values_quad);
+        else
+          {
+            values_quad = fe_eval.get_scratch_data().begin();
+            eval0.template gradients<0, false, false>(gradients_quad,
+                                                      values_quad);
+          }
+        if (dim > 1)
+          eval1.template gradients<1, false, true>(gradients_quad + n_q_points,
+                                                   values_quad);
+        if (dim > 2)
+          eval2.template gradients<2, false, true>(gradients_quad +
+                                                     2 * n_q_points,
+                                                   values_quad);
+
+        if (add_into_values_array == false)
+          eval_values.template values<0, false, false>(values_quad,
+                                                       values_dofs_actual +
+                                                         c * n_dofs);
+        else
+          eval_values.template values<0, false, true>(values_quad,
+                                                      values_dofs_actual +
+                                                        c * n_dofs);
+      }
+  }
+
+
+
   /**
    * This struct implements the change between two different bases. This is an
    * ingredient in the FEEvaluationImplTransformToCollocation class where we
@@ -1803,7 +2023,7 @@ namespace internal
                               values_dofs,
                               fe_eval);
         }
-      else if (fe_degree >= 0 && element_type <= ElementType::tensor_symmetric)
+      else if (element_type <= ElementType::tensor_symmetric)
         {
           FEEvaluationImpl<ElementType::tensor_symmetric,
                            dim,
@@ -1925,7 +2145,7 @@ namespace internal
                                fe_eval,
                                sum_into_values_array);
         }
-      else if (fe_degree >= 0 && element_type <= ElementType::tensor_symmetric)
+      else if (element_type <= ElementType::tensor_symmetric)
         {
           FEEvaluationImpl<ElementType::tensor_symmetric,
                            dim,
@@ -2949,8 +3169,7 @@ namespace internal
       constexpr unsigned int n_q_points_1d_actual =
         fe_degree > -1 ? n_q_points_1d : 0;
 
-      if (fe_degree > -1 &&
-          subface_index >= GeometryInfo<dim>::max_children_per_cell &&
+      if (subface_index >= GeometryInfo<dim>::max_children_per_cell &&
           shape_info.element_type <= MatrixFreeFunctions::tensor_symmetric)
         FEFaceEvaluationImpl<true,
                              dim,
@@ -3107,8 +3326,7 @@ namespace internal
         fe_degree > -1 ? n_q_points_1d : 0;
       const unsigned int subface_index = fe_eval.get_subface_index();
 
-      if (fe_degree > -1 &&
-          fe_eval.get_subface_index() >=
+      if (fe_eval.get_subface_index() >=
             GeometryInfo<dim - 1>::max_children_per_cell &&
           shape_info.element_type <= MatrixFreeFunctions::tensor_symmetric)
         FEFaceEvaluationImpl<
@@ -3736,7 +3954,7 @@ namespace internal
     {
       Assert(fe_degree > -1, ExcInternalError());
       Assert(fe_eval.get_shape_info().element_type <=
-               MatrixFreeFunctions::tensor_symmetric,
+               MatrixFreeFunctions::tensor_general,
              ExcInternalError());
 
       const unsigned int dofs_per_face = Utilities::pow(fe_degree + 1, dim - 1);
@@ -3745,20 +3963,38 @@ namespace internal
       VectorizedArrayType *scratch_data =
         temp + 3 * n_components * dofs_per_face;
 
-      Processor<fe_degree> p;
+      const bool is_ecl_exterior_face =
+        fe_eval.get_dof_access_index() ==
+          MatrixFreeFunctions::DoFInfo::dof_access_cell &&
+        fe_eval.is_interior_face() == false;
 
-      if (fe_eval.get_dof_access_index() ==
-            MatrixFreeFunctions::DoFInfo::dof_access_cell &&
-          fe_eval.is_interior_face() == false)
-        fe_face_evaluation_process_and_io<VectorizedArrayType::size()>(
-          p, n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+      if (fe_eval.get_shape_info().data.front().nodal_at_cell_boundaries ==
+          false)
+        {
+          if (is_ecl_exterior_face)
+            gather_normal_lines<fe_degree, VectorizedArrayType::size()>(
+              n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+          else
+            gather_normal_lines<fe_degree, 1>(
+              n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+        }
       else
-        fe_face_evaluation_process_and_io<1>(
-          p, n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+        {
+          Processor<fe_degree> p;
+
+          if (is_ecl_exterior_face)
+            fe_face_evaluation_process_and_io<VectorizedArrayType::size()>(
+              p, n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+          else
+            fe_face_evaluation_process_and_io<1>(
+              p, n_components, evaluation_flag, src_ptr, sm_ptr, fe_eval, temp);
+        }
 
       const unsigned int subface_index = fe_eval.get_subface_index();
 
-      if (subface_index >= GeometryInfo<dim>::max_children_per_cell)
+      if (subface_index >= GeometryInfo<dim>::max_children_per_cell &&
+          fe_eval.get_shape_info().element_type <=
+            MatrixFreeFunctions::tensor_symmetric)
         FEFaceEvaluationImpl<true,
                              dim,
                              fe_degree,
@@ -3789,8 +4025,14 @@ namespace internal
                            scratch_data,
                            subface_index);
 
-      // re-orientation for cases not possible with above algorithm
-      if (subface_index < GeometryInfo<dim>::max_children_per_cell)
+      // re-orientation for cases not possible with above algorithm; the
+      // bases without nodes at the cell boundaries are always re-oriented
+      // at the quadrature points, as a permutation of the face coefficients
+      // does not describe the reflection of a non-symmetric 1D basis such
+      // as the Legendre polynomials
+      if (subface_index < GeometryInfo<dim>::max_children_per_cell ||
+          fe_eval.get_shape_info().data.front().nodal_at_cell_boundaries ==
+            false)
         {
           if (fe_eval.get_dof_access_index() ==
                 MatrixFreeFunctions::DoFInfo::dof_access_cell &&
@@ -3847,17 +4089,28 @@ namespace internal
       MatrixFreeFunctions::DoFInfo::IndexStorageVariants         storage)
     {
       const unsigned int fe_degree = shape_info.data.front().fe_degree;
-      if (fe_degree < 1 || !shape_info.data.front().nodal_at_cell_boundaries ||
-          (evaluation_flag & EvaluationFlags::gradients &&
+      if (fe_degree < 1 || vector_ptr == nullptr ||
+          storage <
+            MatrixFreeFunctions::DoFInfo::IndexStorageVariants::contiguous)
+        return false;
+
+      // bases without nodes at the cell boundaries are interpolated to the
+      // face while reading the vector entries, see gather_normal_lines().
+      // With contiguous indices, the transposed read of the whole cell in
+      // read_dof_values() is faster, so this is only done for the indices
+      // interleaved between the cells of a batch
+      if (shape_info.data.front().nodal_at_cell_boundaries == false)
+        return storage >= MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
+                            interleaved_contiguous &&
+               shape_info.element_type <= MatrixFreeFunctions::tensor_general;
+
+      if ((evaluation_flag & EvaluationFlags::gradients &&
            (fe_degree < 2 ||
             shape_info.data.front().element_type !=
               MatrixFreeFunctions::tensor_symmetric_hermite)) ||
           (evaluation_flag & EvaluationFlags::hessians) ||
-          vector_ptr == nullptr ||
           shape_info.data.front().element_type >
-            MatrixFreeFunctions::tensor_symmetric ||
-          storage <
-            MatrixFreeFunctions::DoFInfo::IndexStorageVariants::contiguous)
+            MatrixFreeFunctions::tensor_symmetric)
         return false;
       else
         return true;
@@ -3937,6 +4190,318 @@ namespace internal
         temp = src_ptr;
       }
     };
+
+    /**
+     * Compute the values and the derivatives in face-normal direction on
+     * the face for a basis that is not nodal at the cell boundaries, e.g.
+     * FE_DGQLegendre or FE_DGQArbitraryNodes with Gauss points. All
+     * degrees of freedom along a line normal to the face contribute, so the
+     * 1D interpolation matrices in @p shape_data_on_face are applied to the
+     * strided entries returned by @p load directly, rather than first
+     * copying all degrees of freedom of the cell to a local array and
+     * interpolating to the face from there.
+     */
+    template <int fe_degree,
+              int n_derivatives,
+              typename Number3,
+              typename LoadFunction,
+              typename StoreFunction>
+    static void
+    interpolate_normal_lines(const unsigned int *       face_to_cell_index,
+                             const unsigned int         normal_stride,
+                             const VectorizedArrayType *shape_data_on_face,
+                             const LoadFunction &       load,
+                             const StoreFunction &      store)
+    {
+      constexpr unsigned int n_dofs_1d = fe_degree + 1;
+      constexpr unsigned int dofs_per_face =
+        Utilities::pow(fe_degree + 1, dim - 1);
+
+      for (unsigned int i = 0; i < dofs_per_face; ++i)
+        {
+          Number3 result[n_derivatives + 1];
+          for (unsigned int d = 0; d <= n_derivatives; ++d)
+            result[d] = Number3();
+
+          const unsigned int index = face_to_cell_index[i];
+          for (unsigned int j = 0; j < n_dofs_1d; ++j)
+            {
+              const Number3 value = load(index + j * normal_stride);
+              for (unsigned int d = 0; d <= n_derivatives; ++d)
+                result[d] += shape_data_on_face[d * n_dofs_1d + j][0] * value;
+            }
+
+          for (unsigned int d = 0; d <= n_derivatives; ++d)
+            store(i + d * dofs_per_face, result[d]);
+        }
+    }
+
+    template <int fe_degree,
+              typename Number3,
+              typename LoadFunction,
+              typename StoreFunction>
+    static void
+    interpolate_normal_lines(const unsigned int         n_derivatives,
+                             const unsigned int *       face_to_cell_index,
+                             const unsigned int         normal_stride,
+                             const VectorizedArrayType *shape_data_on_face,
+                             const LoadFunction &       load,
+                             const StoreFunction &      store)
+    {
+      if (n_derivatives == 2)
+        interpolate_normal_lines<fe_degree, 2, Number3>(face_to_cell_index,
+                                                        normal_stride,
+                                                        shape_data_on_face,
+                                                        load,
+                                                        store);
+      else if (n_derivatives == 1)
+        interpolate_normal_lines<fe_degree, 1, Number3>(face_to_cell_index,
+                                                        normal_stride,
+                                                        shape_data_on_face,
+                                                        load,
+                                                        store);
+      else
+        interpolate_normal_lines<fe_degree, 0, Number3>(face_to_cell_index,
+                                                        normal_stride,
+                                                        shape_data_on_face,
+                                                        load,
+                                                        store);
+    }
+
+    /**
+     * Read the vector entries of a basis that is not nodal at the cell
+     * boundaries and interpolate them to the face, filling the values, the
+     * normal derivatives and, if requested, the second normal derivatives
+     * in @p temp in the same layout as FEFaceNormalEvaluationImpl. When all
+     * lanes refer to the same face and the storage allows it, the entries
+     * are read with vectorized loads or gathers; otherwise, the lanes are
+     * processed one at a time.
+     */
+    template <int fe_degree, int n_face_orientations>
+    static void
+    gather_normal_lines(
+      const unsigned int                                      n_components,
+      const EvaluationFlags::EvaluationFlags                  evaluation_flag,
+      const Number2 *                                         src_ptr,
+      const std::vector<ArrayView<const Number2>> *           sm_ptr,
+      const FEEvaluationData<dim, VectorizedArrayType, true> &fe_eval,
+      VectorizedArrayType *                                   temp)
+    {
+      constexpr unsigned int n_lanes = VectorizedArrayType::size();
+      constexpr unsigned int dofs_per_face =
+        Utilities::pow(fe_degree + 1, dim - 1);
+      constexpr unsigned int dofs_per_component =
+        Utilities::pow(fe_degree + 1, dim);
+
+      using IndexStorageVariants =
+        MatrixFreeFunctions::DoFInfo::IndexStorageVariants;
+
+      const auto &       shape_info = fe_eval.get_shape_info();
+      const auto &       dof_info   = fe_eval.get_dof_info();
+      const unsigned int cell       = fe_eval.get_cell_or_face_batch_id();
+      const MatrixFreeFunctions::DoFInfo::DoFAccessIndex dof_access_index =
+        fe_eval.get_dof_access_index();
+      AssertIndexRange(cell,
+                       dof_info.index_storage_variants[dof_access_index].size());
+      const IndexStorageVariants storage =
+        dof_info.index_storage_variants[dof_access_index][cell];
+      const unsigned int n_filled_lanes =
+        dof_info.n_vectorization_lanes_filled[dof_access_index][cell];
+      const std::size_t component_offset =
+        dof_info.component_dof_indices_offset[fe_eval.get_active_fe_index()]
+                                             [fe_eval
+                                                .get_first_selected_component()];
+
+      const unsigned int n_derivatives =
+        (evaluation_flag & EvaluationFlags::hessians) ?
+          2 :
+          ((evaluation_flag & EvaluationFlags::gradients) ? 1 : 0);
+
+      const auto &cell_ids = fe_eval.get_cell_ids();
+
+      // in the ECL loop, the exterior cells are accessed through the cell
+      // indices, with the stride of the cell batch the neighbor belongs to
+      bool all_faces_are_same = n_filled_lanes == n_lanes;
+      if (n_face_orientations == n_lanes)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          if (cell_ids[v] == numbers::invalid_unsigned_int ||
+              fe_eval.get_face_no(v) != fe_eval.get_face_no(0) ||
+              dof_info.dof_indices_interleave_strides[dof_access_index]
+                                                     [cell_ids[v]] != 1)
+            {
+              all_faces_are_same = false;
+              break;
+            }
+
+      const bool is_contiguous = n_face_orientations > 1 ||
+                                 storage == IndexStorageVariants::contiguous;
+
+      const unsigned int *dof_indices =
+        &dof_info.dof_indices_contiguous[dof_access_index][cell * n_lanes];
+      std::array<unsigned int, n_lanes> reordered_indices;
+      if (n_face_orientations == n_lanes && all_faces_are_same)
+        {
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            reordered_indices[v] =
+              dof_info.dof_indices_contiguous[dof_access_index][cell_ids[v]];
+          dof_indices = reordered_indices.data();
+        }
+
+      if (all_faces_are_same &&
+          ((is_contiguous && sm_ptr == nullptr) ||
+           storage == IndexStorageVariants::interleaved_contiguous ||
+           storage == IndexStorageVariants::interleaved_contiguous_strided))
+        {
+          const unsigned int face_no = fe_eval.get_face_no(0);
+          const unsigned int *face_to_cell_index =
+            &shape_info.face_to_cell_index_normal_lines(face_no, 0);
+          const unsigned int normal_stride =
+            Utilities::pow(fe_degree + 1, face_no / 2);
+          const VectorizedArrayType *shape_data_on_face =
+            shape_info.data.front().shape_data_on_face[face_no % 2].begin();
+
+          const auto store = [&](const unsigned int         i,
+                                 const VectorizedArrayType &value) {
+            temp[i] = value;
+          };
+
+          for (unsigned int c = 0; c < n_components; ++c)
+            {
+              const std::size_t offset =
+                component_offset + c * dofs_per_component;
+
+              if (is_contiguous)
+                {
+                  const Number2 *ptr = src_ptr + offset;
+                  interpolate_normal_lines<fe_degree, VectorizedArrayType>(
+                    n_derivatives,
+                    face_to_cell_index,
+                    normal_stride,
+                    shape_data_on_face,
+                    [&](const unsigned int i) {
+                      VectorizedArrayType value;
+                      do_vectorized_gather(ptr + i, dof_indices, value);
+                      return value;
+                    },
+                    store);
+                }
+              else if (storage == IndexStorageVariants::interleaved_contiguous)
+                {
+                  const Number2 *ptr =
+                    src_ptr + dof_indices[0] + offset * n_lanes;
+                  interpolate_normal_lines<fe_degree, VectorizedArrayType>(
+                    n_derivatives,
+                    face_to_cell_index,
+                    normal_stride,
+                    shape_data_on_face,
+                    [&](const unsigned int i) {
+                      VectorizedArrayType value;
+                      do_vectorized_read(ptr + i * n_lanes, value);
+                      return value;
+                    },
+                    store);
+                }
+              else
+                {
+                  const Number2 *ptr = src_ptr + offset * n_lanes;
+                  interpolate_normal_lines<fe_degree, VectorizedArrayType>(
+                    n_derivatives,
+                    face_to_cell_index,
+                    normal_stride,
+                    shape_data_on_face,
+                    [&](const unsigned int i) {
+                      VectorizedArrayType value;
+                      do_vectorized_gather(ptr + i * n_lanes,
+                                           dof_indices,
+                                           value);
+                      return value;
+                    },
+                    store);
+                }
+              temp += 3 * dofs_per_face;
+            }
+          return;
+        }
+
+      // general case: go through the lanes one by one
+      for (unsigned int i = 0; i < 3 * n_components * dofs_per_face; ++i)
+        temp[i] = VectorizedArrayType();
+
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          if (n_face_orientations == 1 ?
+                v >= n_filled_lanes :
+                cell_ids[v] == numbers::invalid_unsigned_int)
+            continue;
+
+          // pointer to the first entry of the cell in the vector and the
+          // stride between the degrees of freedom of the cell
+          const Number2 *ptr    = nullptr;
+          unsigned int   stride = 1;
+          if (is_contiguous)
+            {
+              const unsigned int index =
+                n_face_orientations == 1 ? cell * n_lanes + v : cell_ids[v];
+              if (n_face_orientations > 1)
+                stride =
+                  dof_info.dof_indices_interleave_strides[dof_access_index]
+                                                         [index];
+              if (sm_ptr == nullptr)
+                ptr = src_ptr +
+                      dof_info.dof_indices_contiguous[dof_access_index][index];
+              else
+                {
+                  const auto &sm_index =
+                    dof_info.dof_indices_contiguous_sm[dof_access_index][index];
+                  ptr = sm_ptr->operator[](sm_index.first).data() +
+                        sm_index.second;
+                }
+            }
+          else if (storage == IndexStorageVariants::interleaved_contiguous)
+            {
+              ptr    = src_ptr + dof_indices[0] + v;
+              stride = n_lanes;
+            }
+          else if (storage ==
+                   IndexStorageVariants::interleaved_contiguous_strided)
+            {
+              ptr    = src_ptr + dof_indices[v];
+              stride = n_lanes;
+            }
+          else
+            {
+              Assert(storage == IndexStorageVariants::
+                                  interleaved_contiguous_mixed_strides,
+                     ExcInternalError());
+              ptr = src_ptr + dof_indices[v];
+              stride =
+                dof_info.dof_indices_interleave_strides[dof_access_index]
+                                                       [cell * n_lanes + v];
+            }
+
+          const unsigned int lane    = n_face_orientations == 1 ? 0 : v;
+          const unsigned int face_no = fe_eval.get_face_no(lane);
+
+          VectorizedArrayType *temp_component = temp;
+          for (unsigned int c = 0; c < n_components; ++c)
+            {
+              const Number2 *ptr_component =
+                ptr + (component_offset + c * dofs_per_component) * stride;
+              interpolate_normal_lines<fe_degree, Number>(
+                n_derivatives,
+                &shape_info.face_to_cell_index_normal_lines(face_no, 0),
+                Utilities::pow(fe_degree + 1, face_no / 2),
+                shape_info.data.front().shape_data_on_face[face_no % 2].begin(),
+                [&](const unsigned int i) {
+                  return static_cast<Number>(ptr_component[i * stride]);
+                },
+                [&](const unsigned int i, const Number value) {
+                  temp_component[i][v] = value;
+                });
+              temp_component += 3 * dofs_per_face;
+            }
+        }
+    }
   };
 
 
@@ -0,0 +1,624 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_fast_diagonalization_smoother_h
+#define dealii_matrix_free_fast_diagonalization_smoother_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeOperators
+{
+  /**
+   * A cell-wise Schwarz smoother for matrix-free operators based on the fast
+   * diagonalization method. On each cell $K$, the operator
+   * @f[
+   *   a_K(u,v) = \mu\, (u, v)_K + \kappa\, (\nabla u, \nabla v)_K
+   *   + \kappa \int_{\partial K} \left(\sigma\, u\, v - \frac{1}{2}
+   *   \left(\partial_n u\, v + u\, \partial_n v\right)\right) \mathrm{d}s
+   * @f]
+   * is approximated by the one on an axis-parallel box with the extents of
+   * the cell (see TriaAccessor::extent_in_direction()), where the boundary
+   * integrals are the cell contributions of the symmetric interior penalty
+   * method with penalty parameter $\sigma = \text{penalty\_factor}
+   * (k+1)^2/h$. This box operator is a sum of Kronecker products of
+   * one-dimensional mass and Laplace matrices, which is inverted with the
+   * TensorProductMatrixSymmetricSum class at a cost of $\mathcal O(k^{d+1})$
+   * per cell. The vmult() function applies these inverses to the cell
+   * values of the source vector inside a MatrixFree::cell_loop() and adds
+   * the results of all cells.
+   *
+   * For discontinuous elements, this is a (non-overlapping) block-Jacobi
+   * method, where the blocks approximate the cell matrices of an interior
+   * penalty discretization. For continuous elements, the cells overlap in
+   * the degrees of freedom on their boundary. In that case, both the input
+   * and the output of the cell inverses are weighted by the inverse of the
+   * number of cells sharing a degree of freedom, like in Neumann-Neumann
+   * methods. This keeps the smoother symmetric and bounds the eigenvalues of
+   * the preconditioned operator independently of the number of cells around
+   * a vertex. The boundary terms weakly impose homogeneous Dirichlet
+   * conditions on the cell problems, which makes them definite also without
+   * a mass term.
+   *
+   * On the constrained degrees of freedom, which are skipped by the cell
+   * loop, the smoother is the identity scaled by the relaxation factor, in
+   * line with the treatment of these entries in MatrixFreeOperators::Base.
+   *
+   * The generalized eigenvalue problems of the 1D matrices are solved for
+   * each cell batch, vectorized over the lanes of VectorizedArray. Cell
+   * batches whose cells have the same extents share the eigendecomposition,
+   * such that only a few of them are stored on (nearly) Cartesian meshes.
+   *
+   * The class provides the functions initialize(), vmult() and Tvmult() and
+   * can thus be used as a preconditioner in MGSmootherPrecondition or
+   * PreconditionChebyshev.
+   *
+   * @note This class requires LAPACK support.
+   */
+  template <int dim,
+            int fe_degree,
+            typename Number              = double,
+            typename VectorizedArrayType = VectorizedArray<Number>>
+  class FastDiagonalizationSmoother : public Subscriptor
+  {
+    static_assert(
+      std::is_same<Number, typename VectorizedArrayType::value_type>::value,
+      "Type of Number and of VectorizedArrayType do not match.");
+
+  public:
+    /**
+     * Type of the vectors this class operates on.
+     */
+    using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+    /**
+     * Parameters of the smoother.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const double       relaxation          = 1.,
+                     const double       mass_coefficient    = 0.,
+                     const double       laplace_coefficient = 1.,
+                     const double       penalty_factor      = 1.,
+                     const unsigned int dof_handler_index   = 0);
+
+      /**
+       * Factor by which the result of vmult() is scaled.
+       */
+      double relaxation;
+
+      /**
+       * The coefficient $\mu$ of the mass term.
+       */
+      double mass_coefficient;
+
+      /**
+       * The coefficient $\kappa$ of the Laplace term.
+       */
+      double laplace_coefficient;
+
+      /**
+       * The factor of the penalty parameter
+       * $\sigma = \text{penalty\_factor} (k+1)^2/h$ in the boundary terms.
+       */
+      double penalty_factor;
+
+      /**
+       * The index of the DoFHandler in the MatrixFree object. The quadrature
+       * formula with index zero is used to compute the 1D matrices.
+       */
+      unsigned int dof_handler_index;
+    };
+
+    /**
+     * Default constructor.
+     */
+    FastDiagonalizationSmoother() = default;
+
+    /**
+     * Set up the smoother for the MatrixFree object of @p matrix, which can
+     * be any class with a `get_matrix_free()` function as e.g.
+     * MatrixFreeOperators::Base, and compute the eigendecompositions for all
+     * cell batches.
+     */
+    template <typename MatrixType>
+    void
+    initialize(const MatrixType &    matrix,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Set up the smoother for the given MatrixFree object and compute the
+     * eigendecompositions for all cell batches.
+     */
+    void
+    initialize(
+      const std::shared_ptr<const MatrixFree<dim, Number, VectorizedArrayType>>
+        &                   matrix_free,
+      const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Release all memory and return to a state just like after having called
+     * the default constructor.
+     */
+    void
+    clear();
+
+    /**
+     * Apply the smoother, i.e., the weighted sum of the inverses of the cell
+     * operators, to @p src and write the result into @p dst.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Apply the transpose of the smoother. As the cell operators are
+     * symmetric, this is the same as vmult().
+     */
+    void
+    Tvmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the number of distinct eigendecompositions stored after
+     * compressing the cell batches with the same extents.
+     */
+    unsigned int
+    n_stored_cell_matrices() const;
+
+    /**
+     * Return the memory consumption of this class in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The cell operation of vmult().
+     */
+    void
+    local_apply(const MatrixFree<dim, Number, VectorizedArrayType> &data,
+                VectorType &                                        dst,
+                const VectorType &                                  src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const;
+
+    /**
+     * The MatrixFree object the smoother works on.
+     */
+    std::shared_ptr<const MatrixFree<dim, Number, VectorizedArrayType>>
+      matrix_free;
+
+    /**
+     * The parameters of the smoother.
+     */
+    AdditionalData additional_data;
+
+    /**
+     * The eigendecompositions of the cell operators, possibly shared among
+     * several cell batches.
+     */
+    std::vector<TensorProductMatrixSymmetricSum<dim,
+                                                VectorizedArrayType,
+                                                fe_degree + 1>>
+      cell_matrices;
+
+    /**
+     * The index into @p cell_matrices for each cell batch.
+     */
+    std::vector<unsigned int> cell_matrix_indices;
+
+    /**
+     * For continuous elements, the inverse of the number of cells sharing a
+     * degree of freedom, and zero on the constrained degrees of freedom,
+     * which vmult() sets separately. Empty for discontinuous elements.
+     */
+    VectorType weights;
+
+    /**
+     * The source vector scaled by @p weights in vmult().
+     */
+    mutable VectorType weighted_src;
+  };
+
+
+
+  // ------------------------------------ inline functions ---------------------
+
+#ifndef DOXYGEN
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline FastDiagonalizationSmoother<dim,
+                                     fe_degree,
+                                     Number,
+                                     VectorizedArrayType>::AdditionalData::
+    AdditionalData(const double       relaxation,
+                   const double       mass_coefficient,
+                   const double       laplace_coefficient,
+                   const double       penalty_factor,
+                   const unsigned int dof_handler_index)
+    : relaxation(relaxation)
+    , mass_coefficient(mass_coefficient)
+    , laplace_coefficient(laplace_coefficient)
+    , penalty_factor(penalty_factor)
+    , dof_handler_index(dof_handler_index)
+  {}
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  template <typename MatrixType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    initialize(const MatrixType &matrix, const AdditionalData &additional_data)
+  {
+    initialize(matrix.get_matrix_free(), additional_data);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    initialize(
+      const std::shared_ptr<const MatrixFree<dim, Number, VectorizedArrayType>>
+        &                   matrix_free,
+      const AdditionalData &additional_data)
+  {
+    this->matrix_free     = matrix_free;
+    this->additional_data = additional_data;
+
+    const unsigned int dof_no = additional_data.dof_handler_index;
+    const auto &       shape_data =
+      matrix_free->get_shape_info(dof_no, 0).data.front();
+    const unsigned int n_dofs_1d     = fe_degree + 1;
+    const unsigned int n_q_points_1d = shape_data.n_q_points_1d;
+    AssertDimension(shape_data.fe_degree, fe_degree);
+    AssertDimension(shape_data.shape_values.size(), n_dofs_1d * n_q_points_1d);
+
+    // 1D mass and Laplace matrices on the unit interval, and the boundary
+    // terms of the interior penalty method, without the scaling by the
+    // penalty parameter and the cell extent
+    Table<2, Number> mass_1d(n_dofs_1d, n_dofs_1d);
+    Table<2, Number> laplace_1d(n_dofs_1d, n_dofs_1d);
+    Table<2, Number> penalty_1d(n_dofs_1d, n_dofs_1d);
+    Table<2, Number> consistency_1d(n_dofs_1d, n_dofs_1d);
+    for (unsigned int i = 0; i < n_dofs_1d; ++i)
+      for (unsigned int j = 0; j < n_dofs_1d; ++j)
+        {
+          Number sum_mass = 0, sum_laplace = 0;
+          for (unsigned int q = 0; q < n_q_points_1d; ++q)
+            {
+              const Number weight = shape_data.quadrature.weight(q);
+              sum_mass += shape_data.shape_values[i * n_q_points_1d + q][0] *
+                          shape_data.shape_values[j * n_q_points_1d + q][0] *
+                          weight;
+              sum_laplace +=
+                shape_data.shape_gradients[i * n_q_points_1d + q][0] *
+                shape_data.shape_gradients[j * n_q_points_1d + q][0] * weight;
+            }
+          mass_1d(i, j)    = sum_mass;
+          laplace_1d(i, j) = sum_laplace;
+
+          // the outer normal is -1 at the left end and +1 at the right end
+          // of the interval
+          penalty_1d(i, j)     = 0;
+          consistency_1d(i, j) = 0;
+          for (unsigned int side = 0; side < 2; ++side)
+            {
+              const Number normal = side == 0 ? -1. : 1.;
+              const auto & face   = shape_data.shape_data_on_face[side];
+              penalty_1d(i, j) += face[i][0] * face[j][0];
+              consistency_1d(i, j) -=
+                0.5 * normal *
+                (face[n_dofs_1d + i][0] * face[j][0] +
+                 face[i][0] * face[n_dofs_1d + j][0]);
+            }
+        }
+
+    const Number penalty = additional_data.penalty_factor * (fe_degree + 1) *
+                           (fe_degree + 1);
+    const Number mu    = additional_data.mass_coefficient;
+    const Number kappa = additional_data.laplace_coefficient;
+
+    // compute the eigendecompositions for all cell batches, re-using the
+    // ones of earlier cell batches with the same extents
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+    const unsigned int     n_cell_batches = matrix_free->n_cell_batches();
+    std::vector<double>    all_extents(n_cell_batches * dim * n_lanes);
+    double                 max_extent = 0.;
+    for (unsigned int cell = 0; cell < n_cell_batches; ++cell)
+      {
+        const unsigned int n_filled_lanes =
+          matrix_free->n_active_entries_per_cell_batch(cell);
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            // fill unused lanes with the data of the first lane to get
+            // well-defined eigenvalue problems
+            const auto cell_iterator =
+              matrix_free->get_cell_iterator(cell,
+                                             v < n_filled_lanes ? v : 0,
+                                             dof_no);
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                const double h = cell_iterator->extent_in_direction(d);
+                all_extents[(cell * dim + d) * n_lanes + v] = h;
+                max_extent = std::max(max_extent, h);
+              }
+          }
+      }
+
+    // the extents are identified by rounding them to integer multiples of
+    // a small fraction of the largest extent, which gives keys with a
+    // strict weak ordering for the map also in the presence of roundoff
+    const double inverse_resolution =
+      max_extent > 0. ? 1e10 / max_extent : 0.;
+    std::map<std::vector<long long int>, unsigned int> extents_to_index;
+
+    cell_matrices.clear();
+    cell_matrix_indices.resize(n_cell_batches);
+    std::vector<Number>        extents(dim * n_lanes);
+    std::vector<long long int> key(dim * n_lanes);
+    for (unsigned int cell = 0; cell < n_cell_batches; ++cell)
+      {
+        for (unsigned int i = 0; i < dim * n_lanes; ++i)
+          {
+            const double h = all_extents[cell * dim * n_lanes + i];
+            extents[i]     = h;
+            key[i]         = std::llround(h * inverse_resolution);
+          }
+
+        const auto position = extents_to_index.find(key);
+        if (position != extents_to_index.end())
+          {
+            cell_matrix_indices[cell] = position->second;
+            continue;
+          }
+
+        std::array<Table<2, VectorizedArrayType>, dim> mass_matrices;
+        std::array<Table<2, VectorizedArrayType>, dim> laplace_matrices;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            VectorizedArrayType h;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              h[v] = extents[d * n_lanes + v];
+            const VectorizedArrayType h_inv = Number(1.) / h;
+
+            mass_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+            laplace_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                {
+                  mass_matrices[d](i, j) = mass_1d(i, j) * h;
+                  // the sum of Kronecker products with the mass matrices in
+                  // the other directions gives mu times the full mass
+                  // matrix when adding mu/dim times the mass matrix in each
+                  // direction
+                  laplace_matrices[d](i, j) =
+                    kappa * h_inv *
+                      (laplace_1d(i, j) + penalty * penalty_1d(i, j) +
+                       consistency_1d(i, j)) +
+                    (mu / dim) * mass_1d(i, j) * h;
+                }
+          }
+
+        cell_matrix_indices[cell] = cell_matrices.size();
+        extents_to_index.emplace(key, cell_matrices.size());
+        cell_matrices.emplace_back(mass_matrices, laplace_matrices);
+      }
+
+    // for continuous elements, compute the weights of the cell contributions
+    // as the inverse of the number of cells sharing a degree of freedom
+    weights.reinit(0);
+    if (matrix_free->get_dof_handler(dof_no).get_fe().n_dofs_per_vertex() > 0)
+      {
+        matrix_free->initialize_dof_vector(weights, dof_no);
+        FEEvaluation<dim,
+                     fe_degree,
+                     fe_degree + 1,
+                     1,
+                     Number,
+                     VectorizedArrayType>
+          phi(*matrix_free, dof_no, 0);
+        for (unsigned int cell = 0; cell < matrix_free->n_cell_batches();
+             ++cell)
+          {
+            phi.reinit(cell);
+            for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+              phi.begin_dof_values()[i] = Number(1.);
+            phi.distribute_local_to_global(weights);
+          }
+        weights.compress(VectorOperation::add);
+        for (unsigned int i = 0; i < weights.locally_owned_size(); ++i)
+          weights.local_element(i) =
+            weights.local_element(i) > 0. ?
+              Number(1.) / weights.local_element(i) :
+              Number(0.);
+      }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    clear()
+  {
+    matrix_free.reset();
+    cell_matrices.clear();
+    cell_matrix_indices.clear();
+    weights.reinit(0);
+    weighted_src.reinit(0);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    vmult(VectorType &dst, const VectorType &src) const
+  {
+    Assert(matrix_free.get() != nullptr, ExcNotInitialized());
+    if (weights.size() > 0)
+      {
+        weighted_src = src;
+        weighted_src.scale(weights);
+        matrix_free->cell_loop(&FastDiagonalizationSmoother::local_apply,
+                               this,
+                               dst,
+                               weighted_src,
+                               true);
+        dst.scale(weights);
+      }
+    else
+      matrix_free->cell_loop(
+        &FastDiagonalizationSmoother::local_apply, this, dst, src, true);
+    if (additional_data.relaxation != 1.)
+      dst *= Number(additional_data.relaxation);
+
+    // the cell loop does not write into constrained degrees of freedom, on
+    // which the smoother acts as the (relaxed) identity like the diagonal of
+    // MatrixFreeOperators::Base
+    for (const unsigned int i :
+         matrix_free->get_constrained_dofs(additional_data.dof_handler_index))
+      dst.local_element(i) =
+        Number(additional_data.relaxation) * src.local_element(i);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    Tvmult(VectorType &dst, const VectorType &src) const
+  {
+    vmult(dst, src);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline unsigned int
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    n_stored_cell_matrices() const
+  {
+    return cell_matrices.size();
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline std::size_t
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    memory_consumption() const
+  {
+    const unsigned int n_dofs_1d = fe_degree + 1;
+    // mass and derivative matrices, eigenvectors, and eigenvalues
+    return cell_matrices.size() * dim * (3 * n_dofs_1d + 1) * n_dofs_1d *
+             sizeof(VectorizedArrayType) +
+           MemoryConsumption::memory_consumption(cell_matrix_indices) +
+           weights.memory_consumption();
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  FastDiagonalizationSmoother<dim, fe_degree, Number, VectorizedArrayType>::
+    local_apply(const MatrixFree<dim, Number, VectorizedArrayType> &data,
+                VectorType &                                        dst,
+                const VectorType &                                  src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number, VectorizedArrayType>
+      phi(data, cell_range, additional_data.dof_handler_index, 0);
+
+    const unsigned int                 dofs_per_cell = phi.dofs_per_cell;
+    AlignedVector<VectorizedArrayType> values(dofs_per_cell);
+    AlignedVector<VectorizedArrayType> tmp(dofs_per_cell);
+
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          values[i] = phi.begin_dof_values()[i];
+        cell_matrices[cell_matrix_indices[cell]].apply_inverse(
+          make_array_view(phi.begin_dof_values(),
+                          phi.begin_dof_values() + dofs_per_cell),
+          make_array_view(values.begin(), values.end()),
+          make_array_view(tmp.begin(), tmp.end()));
+        phi.distribute_local_to_global(dst);
+      }
+  }
+
+#endif // DOXYGEN
+
+} // end of namespace MatrixFreeOperators
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
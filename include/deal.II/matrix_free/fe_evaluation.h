@@ -2984,6 +2984,10 @@ inline FEEvaluationBase<dim,
                          other.matrix_free->acquire_scratch_data())
   , matrix_free(other.matrix_free)
 {
+  // the geometry computed on the fly is filled by reinit(), so each copy
+  // needs its own storage
+  this->cell_geometry_on_the_fly.reset();
+
   if (other.matrix_free == nullptr)
     {
       Assert(other.mapped_geometry.get() != nullptr, ExcInternalError());
@@ -3045,6 +3049,7 @@ operator=(const FEEvaluationBase<dim,
     }
 
   this->FEEvaluationData<dim, VectorizedArrayType, is_face>::operator=(other);
+  this->cell_geometry_on_the_fly.reset();
 
   matrix_free = other.matrix_free;
 
@@ -6776,10 +6781,28 @@ FEEvaluation<dim,
 
   const unsigned int offsets =
     this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
-  this->jacobian_gradients =
-    this->mapping_data->jacobian_gradients[0].data() + offsets;
+  if (offsets == numbers::invalid_unsigned_int)
+    {
+      // the geometry of this cell batch is not stored but computed from the
+      // support points of the mapping
+      if (this->cell_geometry_on_the_fly == nullptr)
+        this->cell_geometry_on_the_fly =
+          std::make_shared<internal::MatrixFreeFunctions::
+                             CellGeometryOnTheFly<dim, VectorizedArrayType>>();
+      auto &geometry = *this->cell_geometry_on_the_fly;
+      this->matrix_free->get_mapping_info().compute_cell_geometry_on_the_fly(
+        cell_index, this->quad_no, geometry);
+      this->jacobian           = geometry.jacobians.data();
+      this->J_value            = geometry.JxW_values.data();
+      this->jacobian_gradients = geometry.jacobian_gradients.data();
+    }
+  else
+    {
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+      this->jacobian_gradients =
+        this->mapping_data->jacobian_gradients[0].data() + offsets;
+    }
 
   unsigned int i = 0;
   for (; i < this->matrix_free->n_active_entries_per_cell_batch(this->cell);
@@ -6788,7 +6811,10 @@ FEEvaluation<dim,
   for (; i < VectorizedArrayType::size(); ++i)
     this->cell_ids[i] = numbers::invalid_unsigned_int;
 
-  if (this->mapping_data->quadrature_points.empty() == false)
+  if (offsets == numbers::invalid_unsigned_int)
+    this->quadrature_points =
+      this->cell_geometry_on_the_fly->quadrature_points.data();
+  else if (this->mapping_data->quadrature_points.empty() == false)
     this->quadrature_points =
       &this->mapping_data->quadrature_points
          [this->mapping_data->quadrature_point_offsets[this->cell]];
@@ -6854,32 +6880,50 @@ FEEvaluation<dim,
   auto &this_jacobian_gradients_data = mapping_storage.jacobian_gradients[0];
   auto &this_quadrature_points_data  = mapping_storage.quadrature_points;
 
+  // cells whose geometry is computed on the fly do not store any data in
+  // mapping_data, so we need to check the update flags
+  const auto &mapping_info = this->matrix_free->get_mapping_info();
+  const bool  geometry_on_the_fly =
+    mapping_info.mapping_support_point_offsets.empty() == false;
+  const bool has_jacobians =
+    this->mapping_data->jacobians[0].size() > 0 || geometry_on_the_fly;
+  const bool has_JxW_values =
+    this->mapping_data->JxW_values.size() > 0 || geometry_on_the_fly;
+  const bool has_jacobian_gradients =
+    this->mapping_data->jacobian_gradients[0].size() > 0 ||
+    (geometry_on_the_fly &&
+     (mapping_info.update_flags_cells & update_jacobian_grads));
+  const bool has_quadrature_points =
+    this->mapping_data->quadrature_points.size() > 0 ||
+    (geometry_on_the_fly &&
+     (mapping_info.update_flags_cells & update_quadrature_points));
+
   if (this->cell_type <= internal::MatrixFreeFunctions::GeometryType::affine)
     {
-      if (this->mapping_data->jacobians[0].size() > 0)
+      if (has_jacobians)
         this_jacobian_data.resize_fast(2);
 
-      if (this->mapping_data->JxW_values.size() > 0)
+      if (has_JxW_values)
         this_J_value_data.resize_fast(1);
 
-      if (this->mapping_data->jacobian_gradients[0].size() > 0)
+      if (has_jacobian_gradients)
         this_jacobian_gradients_data.resize_fast(1);
 
-      if (this->mapping_data->quadrature_points.size() > 0)
+      if (has_quadrature_points)
         this_quadrature_points_data.resize_fast(1);
     }
   else
     {
-      if (this->mapping_data->jacobians[0].size() > 0)
+      if (has_jacobians)
         this_jacobian_data.resize_fast(this->n_quadrature_points);
 
-      if (this->mapping_data->JxW_values.size() > 0)
+      if (has_JxW_values)
         this_J_value_data.resize_fast(this->n_quadrature_points);
 
-      if (this->mapping_data->jacobian_gradients[0].size() > 0)
+      if (has_jacobian_gradients)
         this_jacobian_gradients_data.resize_fast(this->n_quadrature_points);
 
-      if (this->mapping_data->quadrature_points.size() > 0)
+      if (has_quadrature_points)
         this_quadrature_points_data.resize_fast(this->n_quadrature_points);
     }
 
@@ -6890,6 +6934,7 @@ FEEvaluation<dim,
   this->quadrature_points  = this_quadrature_points_data.data();
 
   // fill internal data storage lane by lane
+  unsigned int computed_cell_batch = numbers::invalid_unsigned_int;
   for (unsigned int v = 0; v < VectorizedArrayType::size(); ++v)
     {
       const unsigned int cell_index = cell_ids[v];
@@ -6942,6 +6987,51 @@ FEEvaluation<dim,
             this->matrix_free->get_mapping_info().get_cell_type(
               cell_batch_index);
 
+          // select the source of the data, computing the geometry of the
+          // cell batch first if it is not stored
+          const Tensor<2, dim, VectorizedArrayType> *jacobian_src = nullptr;
+          const VectorizedArrayType *                J_value_src  = nullptr;
+          const Tensor<1,
+                       dim *(dim + 1) / 2,
+                       Tensor<1, dim, VectorizedArrayType>>
+            *jacobian_gradients_src = nullptr;
+          const Point<dim, VectorizedArrayType> *quadrature_points_src =
+            nullptr;
+          if (mapping_info.cell_geometry_is_computed_on_the_fly(
+                cell_batch_index))
+            {
+              if (this->cell_geometry_on_the_fly == nullptr)
+                this->cell_geometry_on_the_fly = std::make_shared<
+                  internal::MatrixFreeFunctions::
+                    CellGeometryOnTheFly<dim, VectorizedArrayType>>();
+              auto &geometry = *this->cell_geometry_on_the_fly;
+              if (cell_batch_index != computed_cell_batch)
+                {
+                  mapping_info.compute_cell_geometry_on_the_fly(
+                    cell_batch_index, this->quad_no, geometry);
+                  computed_cell_batch = cell_batch_index;
+                }
+              jacobian_src           = geometry.jacobians.data();
+              J_value_src            = geometry.JxW_values.data();
+              jacobian_gradients_src = geometry.jacobian_gradients.data();
+              quadrature_points_src  = geometry.quadrature_points.data();
+            }
+          else
+            {
+              if (has_jacobians)
+                jacobian_src = &this->mapping_data->jacobians[0][offsets];
+              if (has_JxW_values)
+                J_value_src = &this->mapping_data->JxW_values[offsets];
+              if (has_jacobian_gradients)
+                jacobian_gradients_src =
+                  &this->mapping_data->jacobian_gradients[0][offsets];
+              if (has_quadrature_points)
+                quadrature_points_src =
+                  &this->mapping_data->quadrature_points
+                     [this->mapping_data
+                        ->quadrature_point_offsets[cell_batch_index]];
+            }
+
           for (unsigned int q = 0; q < this->n_quadrature_points; ++q)
             {
               const unsigned int q_src =
@@ -6950,25 +7040,22 @@ FEEvaluation<dim,
                   0 :
                   q;
 
-              if (this->mapping_data->JxW_values.size() > 0)
-                this_J_value_data[q][v] =
-                  this->mapping_data->JxW_values[offsets + q_src][lane];
+              if (has_JxW_values)
+                this_J_value_data[q][v] = J_value_src[q_src][lane];
 
-              if (this->mapping_data->jacobians[0].size() > 0)
+              if (has_jacobians)
                 for (unsigned int i = 0; i < dim; ++i)
                   for (unsigned int j = 0; j < dim; ++j)
                     this_jacobian_data[q][i][j][v] =
-                      this->mapping_data
-                        ->jacobians[0][offsets + q_src][i][j][lane];
+                      jacobian_src[q_src][i][j][lane];
 
-              if (this->mapping_data->jacobian_gradients[0].size() > 0)
+              if (has_jacobian_gradients)
                 for (unsigned int i = 0; i < dim * (dim + 1) / 2; ++i)
                   for (unsigned int j = 0; j < dim; ++j)
                     this_jacobian_gradients_data[q][i][j][v] =
-                      this->mapping_data
-                        ->jacobian_gradients[0][offsets + q_src][i][j][lane];
+                      jacobian_gradients_src[q_src][i][j][lane];
 
-              if (this->mapping_data->quadrature_points.size() > 0)
+              if (has_quadrature_points)
                 {
                   if (cell_type <=
                       internal::MatrixFreeFunctions::GeometryType::affine)
@@ -6977,13 +7064,10 @@ FEEvaluation<dim,
                       // have to be computed from the corner point and the
                       // Jacobian
                       Point<dim, VectorizedArrayType> point =
-                        this->mapping_data->quadrature_points
-                          [this->mapping_data
-                             ->quadrature_point_offsets[cell_batch_index] +
-                           0];
+                        quadrature_points_src[0];
 
                       const Tensor<2, dim, VectorizedArrayType> &jac =
-                        this->mapping_data->jacobians[0][offsets + 1];
+                        jacobian_src[1];
                       if (cell_type == internal::MatrixFreeFunctions::cartesian)
                         for (unsigned int d = 0; d < dim; ++d)
                           point[d] +=
@@ -7006,10 +7090,7 @@ FEEvaluation<dim,
                       // general case: quadrature points are available
                       for (unsigned int i = 0; i < dim; ++i)
                         this_quadrature_points_data[q][i][v] =
-                          this->mapping_data->quadrature_points
-                            [this->mapping_data
-                               ->quadrature_point_offsets[cell_batch_index] +
-                             q][i][lane];
+                          quadrature_points_src[q][i][lane];
                     }
                 }
             }
@@ -76,6 +76,9 @@ namespace internal
   {
     template <int, typename>
     class MappingDataOnTheFly;
+
+    template <int, typename>
+    struct CellGeometryOnTheFly;
   }
 } // namespace internal
 
@@ -347,6 +350,10 @@ public:
    * Jacobian of the geometry, e.g., to store an effective coefficient tensors
    * that combines a coefficient with the geometry for lower memory transfer
    * as the available data fields.
+   *
+   * @note For cells whose geometry is computed on the fly, see
+   * MatrixFree::AdditionalData::compute_geometry_on_the_fly, no data is
+   * stored and this function returns numbers::invalid_unsigned_int.
    */
   unsigned int
   get_mapping_data_index_offset() const;
@@ -971,6 +978,15 @@ protected:
     internal::MatrixFreeFunctions::MappingDataOnTheFly<dim, Number>>
     mapped_geometry;
 
+  /**
+   * Geometry data of a cell batch that is computed when reinitializing the
+   * object, in case the MatrixFree object was set up with
+   * MatrixFree::AdditionalData::compute_geometry_on_the_fly.
+   */
+  std::shared_ptr<
+    internal::MatrixFreeFunctions::CellGeometryOnTheFly<dim, Number>>
+    cell_geometry_on_the_fly;
+
   // Make FEEvaluation and FEEvaluationBase objects friends for access to
   // protected member mapped_geometry.
   template <int, int, typename, bool, typename>
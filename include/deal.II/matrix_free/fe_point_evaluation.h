@@ -20,6 +20,7 @@
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/ndarray.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/tensor.h>
@@ -762,6 +763,21 @@ private:
    * The reference points specified at reinit().
    */
   std::vector<Point<dim>> unit_points;
+
+  /**
+   * The reference points specified at reinit(), packed into batches of
+   * VectorizedArray<Number>::size() points for the tensor product evaluators
+   * of the fast path.
+   */
+  AlignedVector<Point<dim, VectorizedArray<Number>>> unit_point_batches;
+
+  /**
+   * The values and derivatives of the 1D polynomials at the points of
+   * each batch in `unit_point_batches`, with `poly.size()` entries per batch.
+   * They are computed once in reinit() and then re-used by all calls to
+   * evaluate() and integrate() for the given points.
+   */
+  AlignedVector<dealii::ndarray<VectorizedArray<Number>, 2, dim>> shapes;
 };
 
 // ----------------------- template and inline function ----------------------
@@ -898,6 +914,30 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
                  unit_points.size()));
 
       mapping_data = precomputed_mapping_data;
+
+      // pack the points into batches of VectorizedArray lanes and evaluate
+      // the 1D polynomials at them, so that evaluate() and integrate() only
+      // need to perform the tensor product sums
+      const unsigned int n_lanes   = VectorizedArray<Number>::size();
+      const unsigned int n_batches =
+        (unit_points.size() + n_lanes - 1) / n_lanes;
+      unit_point_batches.resize_fast(n_batches);
+      for (unsigned int i = 0, qb = 0; i < unit_points.size();
+           i += n_lanes, ++qb)
+        {
+          Point<dim, VectorizedArray<Number>> vectorized_points;
+          for (unsigned int j = 0; j < n_lanes && i + j < unit_points.size();
+               ++j)
+            for (unsigned int d = 0; d < dim; ++d)
+              vectorized_points[d][j] = unit_points[i + j][d];
+          unit_point_batches[qb] = vectorized_points;
+        }
+
+      shapes.resize_fast(n_batches * poly.size());
+      for (unsigned int qb = 0; qb < n_batches; ++qb)
+        internal::compute_values_of_array(shapes.data() + qb * poly.size(),
+                                          poly,
+                                          unit_point_batches[qb]);
     }
   else
     {
@@ -973,21 +1013,21 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate(
 
       const std::size_t n_points = unit_points.size();
       const std::size_t n_lanes  = VectorizedArray<Number>::size();
-      for (unsigned int i = 0; i < n_points; i += n_lanes)
+      for (unsigned int i = 0, qb = 0; i < n_points; i += n_lanes, ++qb)
         {
-          // convert to vectorized format
-          Point<dim, VectorizedArray<Number>> vectorized_points;
-          for (unsigned int j = 0; j < n_lanes && i + j < n_points; ++j)
-            for (unsigned int d = 0; d < dim; ++d)
-              vectorized_points[d][j] = unit_points[i + j][d];
-
-          // compute
+          // compute with the points packed into the lanes of VectorizedArray,
+          // using the 1D polynomials precomputed in reinit() unless the
+          // unrolled code for linear polynomials is cheaper
           const auto val_and_grad =
-            internal::evaluate_tensor_product_value_and_gradient(
-              poly,
-              solution_renumbered,
-              vectorized_points,
-              polynomials_are_hat_functions);
+            polynomials_are_hat_functions ?
+              internal::evaluate_tensor_product_value_and_gradient(
+                poly, solution_renumbered, unit_point_batches[qb], true) :
+              internal::evaluate_tensor_product_value_and_gradient_shapes<
+                dim,
+                value_type,
+                VectorizedArray<Number>>(shapes.data() + qb * poly.size(),
+                                         poly.size(),
+                                         solution_renumbered);
 
           // convert back to standard format
           if (evaluation_flag & EvaluationFlags::values)
@@ -1113,14 +1153,8 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
 
       const std::size_t n_points = unit_points.size();
       const std::size_t n_lanes  = VectorizedArray<Number>::size();
-      for (unsigned int i = 0; i < n_points; i += n_lanes)
+      for (unsigned int i = 0, qb = 0; i < n_points; i += n_lanes, ++qb)
         {
-          // convert to vectorized format
-          Point<dim, VectorizedArray<Number>> vectorized_points;
-          for (unsigned int j = 0; j < n_lanes && i + j < n_points; ++j)
-            for (unsigned int d = 0; d < dim; ++d)
-              vectorized_points[d][j] = unit_points[i + j][d];
-
           typename internal::ProductTypeNoPoint<value_type,
                                                 VectorizedArray<Number>>::type
             value = {};
@@ -1152,13 +1186,14 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
                     gradient, j, gradients[i + j]);
               }
 
-          // compute
-          internal::integrate_add_tensor_product_value_and_gradient(
-            poly,
-            value,
-            gradient,
-            vectorized_points,
-            solution_renumbered_vectorized);
+          // compute with the 1D polynomials precomputed in reinit()
+          internal::integrate_add_tensor_product_value_and_gradient_shapes<
+            dim,
+            VectorizedArray<Number>>(shapes.data() + qb * poly.size(),
+                                     poly.size(),
+                                     value,
+                                     gradient,
+                                     solution_renumbered_vectorized);
         }
 
       // add between the lanes and write into the result
@@ -35,6 +35,7 @@
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/helper_functions.h>
 #include <deal.II/matrix_free/mapping_info_storage.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -46,6 +47,50 @@ namespace internal
 {
   namespace MatrixFreeFunctions
   {
+    /**
+     * Storage for the geometry of a single batch of cells that is computed on
+     * the fly from the support points of a MappingQ, see
+     * MappingInfo::compute_cell_geometry_on_the_fly(). The arrays follow the
+     * layout of the respective fields in MappingInfoStorage for a cell batch
+     * of type GeometryType::general, i.e., they hold one entry per quadrature
+     * point.
+     */
+    template <int dim, typename VectorizedArrayType>
+    struct CellGeometryOnTheFly
+    {
+      /**
+       * The inverse and transposed Jacobians on the quadrature points.
+       */
+      AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians;
+
+      /**
+       * The Jacobian determinant times the quadrature weight.
+       */
+      AlignedVector<VectorizedArrayType> JxW_values;
+
+      /**
+       * The gradients of the inverse Jacobian, only filled if
+       * update_jacobian_grads has been requested for the cells.
+       */
+      AlignedVector<
+        Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>>
+        jacobian_gradients;
+
+      /**
+       * The quadrature points in real coordinates, only filled if
+       * update_quadrature_points has been requested for the cells.
+       */
+      AlignedVector<Point<dim, VectorizedArrayType>> quadrature_points;
+
+      /**
+       * Scratch memory for the evaluation of the geometry with the
+       * tensor-product kernels.
+       */
+      AlignedVector<VectorizedArrayType> scratch_data;
+    };
+
+
+
     /**
      * The class that stores all geometry-dependent data related with cell
      * interiors for use in the matrix-free class.
@@ -62,6 +107,14 @@ namespace internal
        * for different kinds of iterators, e.g. standard DoFHandler,
        * multigrid, etc.)  on a fixed Triangulation. In addition, a mapping
        * and several 1D quadrature formulas are given.
+       *
+       * If @p compute_geometry_on_the_fly is set, the mapping is a MappingQ,
+       * and no hp-capabilities are used, the Jacobians, JxW values, Jacobian
+       * gradients and quadrature points of cell batches with GeometryType
+       * general are not stored. Instead, only the support points of the
+       * mapping are kept and the data is recomputed by
+       * compute_cell_geometry_on_the_fly() when it is requested. The flag is
+       * ignored in all other cases.
        */
       void
       initialize(
@@ -74,7 +127,8 @@ namespace internal
         const UpdateFlags update_flags_cells,
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags update_flags_faces_by_cells,
+        const bool        compute_geometry_on_the_fly = false);
 
       /**
        * Update the information in the given cells and faces that is the
@@ -90,12 +144,49 @@ namespace internal
         const std::vector<unsigned int> &active_fe_index,
         const std::shared_ptr<dealii::hp::MappingCollection<dim>> &mapping);
 
+      /**
+       * Copy the data from an object with a different number type, converting
+       * all geometry fields. This object can use more SIMD lanes than @p
+       * other, in which case the cell and face batches of @p other are kept
+       * and the additional lanes are filled like the unused lanes of
+       * partially filled batches.
+       */
+      template <typename OtherNumber, typename OtherVectorizedArrayType>
+      void
+      copy_from(const MappingInfo<dim, OtherNumber, OtherVectorizedArrayType>
+                  &other);
+
       /**
        * Return the type of a given cell as detected during initialization.
        */
       GeometryType
       get_cell_type(const unsigned int cell_chunk_no) const;
 
+      /**
+       * Return whether the geometry of the given cell batch is not stored
+       * but must be computed by compute_cell_geometry_on_the_fly(). In that
+       * case, the entry of MappingInfoStorage::data_index_offsets of the
+       * cell batch is numbers::invalid_unsigned_int.
+       */
+      bool
+      cell_geometry_is_computed_on_the_fly(
+        const unsigned int cell_chunk_no) const;
+
+      /**
+       * Compute the inverse Jacobians, the JxW values and, if requested by
+       * the update flags for the cells, the gradients of the inverse
+       * Jacobians and the quadrature points of the given cell batch on the
+       * quadrature formula with index @p quad_no, using the tensor-product
+       * kernels on the stored support points of the mapping. This function
+       * is only valid for cell batches for which
+       * cell_geometry_is_computed_on_the_fly() returns true.
+       */
+      void
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                               cell_chunk_no,
+        const unsigned int                               quad_no,
+        CellGeometryOnTheFly<dim, VectorizedArrayType> &geometry) const;
+
       /**
        * Clear all data fields in this class.
        */
@@ -191,6 +282,38 @@ namespace internal
        */
       std::vector<std::vector<dealii::ReferenceCell>> reference_cell_types;
 
+      /**
+       * Whether the geometry of general cells should be computed on the fly
+       * rather than stored, as passed to initialize().
+       */
+      bool compute_geometry_on_the_fly;
+
+      /**
+       * The support points of the mapping for the cell batches whose
+       * geometry is computed on the fly. For each such batch, the array
+       * holds the points in the order of the components, with the first
+       * support point of each lane subtracted to retain accuracy for the
+       * derivatives also in single precision, followed by the first support
+       * point itself.
+       *
+       * Indexed by @p mapping_support_point_offsets.
+       */
+      AlignedVector<VectorizedArrayType> mapping_support_points;
+
+      /**
+       * The offset of a cell batch into the array @p mapping_support_points,
+       * or numbers::invalid_unsigned_int for batches whose geometry is
+       * stored. Empty if no geometry is computed on the fly.
+       */
+      std::vector<unsigned int> mapping_support_point_offsets;
+
+      /**
+       * The interpolation matrices from the support points of the mapping
+       * to the quadrature points of each quadrature formula, used for the
+       * geometry computed on the fly.
+       */
+      std::vector<ShapeInfo<VectorizedArrayType>> mapping_shape_info;
+
       /**
        * Internal function to compute the geometry for the case the mapping is
        * a MappingQ and a single quadrature formula per slot (non-hp-case) is
@@ -219,6 +342,14 @@ namespace internal
         const std::vector<FaceToCellTopology<VectorizedArrayType::size()>>
           &faces);
 
+      /**
+       * Fill the field @p mapping_shape_info with the interpolation from the
+       * support points of a MappingQ of the given degree to the quadrature
+       * points of the cells.
+       */
+      void
+      compute_mapping_shape_info(const unsigned int mapping_degree);
+
       /**
        * Computes the information in the given cells, called within
        * initialize.
@@ -370,6 +501,63 @@ namespace internal
       return cell_type[cell_no];
     }
 
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    template <typename OtherNumber, typename OtherVectorizedArrayType>
+    inline void
+    MappingInfo<dim, Number, VectorizedArrayType>::copy_from(
+      const MappingInfo<dim, OtherNumber, OtherVectorizedArrayType> &other)
+    {
+      static_assert(VectorizedArrayType::size() >=
+                      OtherVectorizedArrayType::size(),
+                    "The number of SIMD lanes can not be decreased.");
+
+      update_flags_cells          = other.update_flags_cells;
+      update_flags_boundary_faces = other.update_flags_boundary_faces;
+      update_flags_inner_faces    = other.update_flags_inner_faces;
+      update_flags_faces_by_cells = other.update_flags_faces_by_cells;
+      cell_type                   = other.cell_type;
+      face_type                   = other.face_type;
+
+      cell_data.resize(other.cell_data.size());
+      for (unsigned int i = 0; i < cell_data.size(); ++i)
+        cell_data[i].copy_from(other.cell_data[i]);
+      face_data.resize(other.face_data.size());
+      for (unsigned int i = 0; i < face_data.size(); ++i)
+        face_data[i].copy_from(other.face_data[i]);
+      face_data_by_cells.resize(other.face_data_by_cells.size());
+      for (unsigned int i = 0; i < face_data_by_cells.size(); ++i)
+        face_data_by_cells[i].copy_from(other.face_data_by_cells[i]);
+
+      mapping_collection   = other.mapping_collection;
+      mapping              = other.mapping;
+      reference_cell_types = other.reference_cell_types;
+
+      compute_geometry_on_the_fly = other.compute_geometry_on_the_fly;
+      MappingInfoStorageHelper::convert_vector(other.mapping_support_points,
+                                               mapping_support_points);
+      mapping_support_point_offsets = other.mapping_support_point_offsets;
+      mapping_shape_info.clear();
+      if (other.mapping_shape_info.empty() == false)
+        compute_mapping_shape_info(
+          other.mapping_shape_info[0].data.front().fe_degree);
+    }
+
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    inline bool
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      cell_geometry_is_computed_on_the_fly(const unsigned int cell_no) const
+    {
+      if (mapping_support_point_offsets.empty())
+        return false;
+      AssertIndexRange(cell_no, mapping_support_point_offsets.size());
+      return mapping_support_point_offsets[cell_no] !=
+             numbers::invalid_unsigned_int;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
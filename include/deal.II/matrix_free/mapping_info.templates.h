@@ -50,8 +50,12 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
-      mapping_collection = nullptr;
-      mapping            = nullptr;
+      mapping_collection          = nullptr;
+      mapping                     = nullptr;
+      compute_geometry_on_the_fly = false;
+      mapping_support_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_shape_info.clear();
     }
 
 
@@ -68,11 +72,13 @@ namespace internal
       const UpdateFlags update_flags_cells,
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags update_flags_faces_by_cells,
+      const bool        compute_geometry_on_the_fly)
     {
       clear();
-      this->mapping_collection = mapping;
-      this->mapping            = &mapping->operator[](0);
+      this->mapping_collection          = mapping;
+      this->mapping                     = &mapping->operator[](0);
+      this->compute_geometry_on_the_fly = compute_geometry_on_the_fly;
 
       cell_data.resize(quad.size());
       face_data.resize(quad.size());
@@ -191,6 +197,15 @@ namespace internal
             tria, cells, face_info.faces, active_fe_index, *mapping);
           initialize_faces_by_cells(tria, cells, *mapping);
         }
+
+      // deduplicate the data of affine and Cartesian cells and faces across
+      // all batches
+      for (auto &data : cell_data)
+        data.compress_data_fields();
+      for (auto &data : face_data)
+        data.compress_data_fields();
+      for (auto &data : face_data_by_cells)
+        data.compress_data_fields();
     }
 
 
@@ -213,6 +228,9 @@ namespace internal
         data.clear_data_fields();
       for (auto &data : face_data_by_cells)
         data.clear_data_fields();
+      mapping_support_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_shape_info.clear();
 
       this->mapping_collection = mapping;
       this->mapping            = &mapping->operator[](0);
@@ -229,6 +247,15 @@ namespace internal
             tria, cells, face_info.faces, active_fe_index, *mapping);
           initialize_faces_by_cells(tria, cells, *mapping);
         }
+
+      // deduplicate the data of affine and Cartesian cells and faces across
+      // all batches
+      for (auto &data : cell_data)
+        data.compress_data_fields();
+      for (auto &data : face_data)
+        data.compress_data_fields();
+      for (auto &data : face_data_by_cells)
+        data.compress_data_fields();
     }
 
 
@@ -1119,7 +1146,8 @@ namespace internal
         const UpdateFlags                  update_flags_cells,
         const AlignedVector<double> &      plain_quadrature_points,
         const ShapeInfo<VectorizedDouble> &shape_info,
-        MappingInfoStorage<dim, dim, VectorizedArrayType> &my_data)
+        MappingInfoStorage<dim, dim, VectorizedArrayType> &my_data,
+        const bool geometry_on_the_fly = false)
       {
         constexpr unsigned int n_lanes   = VectorizedArrayType::size();
         constexpr unsigned int n_lanes_d = VectorizedDouble::size();
@@ -1137,6 +1165,10 @@ namespace internal
         for (unsigned int cell = begin_cell; cell < end_cell; ++cell)
           for (unsigned vv = 0; vv < n_lanes; vv += n_lanes_d)
             {
+              // the geometry of these cells is computed within FEEvaluation
+              if (geometry_on_the_fly && cell_type[cell] > affine)
+                break;
+
               if (cell_type[cell] > affine || process_cell[cell])
                 {
                   unsigned int start_indices[n_lanes_d];
@@ -1354,13 +1386,13 @@ namespace internal
                 shift[i - 1][1] +
                 data_cells_local[i - 1].first[my_q].quadrature_points.size();
             }
-          cell_data[my_q].JxW_values.resize_fast(
+          cell_data[my_q].JxW_values.resize(
             shift.back()[0] +
             data_cells_local.back().first[my_q].JxW_values.size());
-          cell_data[my_q].jacobians[0].resize_fast(
+          cell_data[my_q].jacobians[0].resize(
             cell_data[my_q].JxW_values.size());
           if (update_flags_cells & update_jacobian_grads)
-            cell_data[my_q].jacobian_gradients[0].resize_fast(
+            cell_data[my_q].jacobian_gradients[0].resize(
               cell_data[my_q].JxW_values.size());
           if (update_flags_cells & update_quadrature_points)
             {
@@ -2393,25 +2425,25 @@ namespace internal
                 shift[i - 1][1] +
                 data_faces_local[i - 1].first[my_q].quadrature_points.size();
             }
-          face_data[my_q].JxW_values.resize_fast(
+          face_data[my_q].JxW_values.resize(
             shift.back()[0] +
             data_faces_local.back().first[my_q].JxW_values.size());
-          face_data[my_q].normal_vectors.resize_fast(
+          face_data[my_q].normal_vectors.resize(
             face_data[my_q].JxW_values.size());
-          face_data[my_q].jacobians[0].resize_fast(
+          face_data[my_q].jacobians[0].resize(
             face_data[my_q].JxW_values.size());
-          face_data[my_q].jacobians[1].resize_fast(
+          face_data[my_q].jacobians[1].resize(
             face_data[my_q].JxW_values.size());
           if (update_flags_common & update_jacobian_grads)
             {
-              face_data[my_q].jacobian_gradients[0].resize_fast(
+              face_data[my_q].jacobian_gradients[0].resize(
                 face_data[my_q].JxW_values.size());
-              face_data[my_q].jacobian_gradients[1].resize_fast(
+              face_data[my_q].jacobian_gradients[1].resize(
                 face_data[my_q].JxW_values.size());
             }
-          face_data[my_q].normals_times_jacobians[0].resize_fast(
+          face_data[my_q].normals_times_jacobians[0].resize(
             face_data[my_q].JxW_values.size());
-          face_data[my_q].normals_times_jacobians[1].resize_fast(
+          face_data[my_q].normals_times_jacobians[1].resize(
             face_data[my_q].JxW_values.size());
           if (update_flags_common & update_quadrature_points)
             {
@@ -2619,7 +2651,62 @@ namespace internal
         }
 
       // step 4: compute the data on cells from the cached quadrature
-      // points, filling up all SIMD lanes as appropriate
+      // points, filling up all SIMD lanes as appropriate. If requested, only
+      // keep the support points of the mapping for general cells and
+      // compute the rest on the fly within FEEvaluation::reinit()
+      mapping_support_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_shape_info.clear();
+      const bool geometry_on_the_fly =
+        compute_geometry_on_the_fly &&
+        std::find(cell_type.begin(), cell_type.end(), general) !=
+          cell_type.end();
+      if (geometry_on_the_fly)
+        {
+          unsigned int n_general = 0;
+          mapping_support_point_offsets.resize(cell_type.size(),
+                                               numbers::invalid_unsigned_int);
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_type[cell] > affine)
+              mapping_support_point_offsets[cell] =
+                (n_general++) * (n_mapping_points + 1) * dim;
+          mapping_support_points.resize_fast(n_general *
+                                             (n_mapping_points + 1) * dim);
+
+          dealii::parallel::apply_to_subranges(
+            0U,
+            cell_type.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int cell = begin; cell < end; ++cell)
+                if (mapping_support_point_offsets[cell] !=
+                    numbers::invalid_unsigned_int)
+                  {
+                    VectorizedArrayType *points =
+                      mapping_support_points.data() +
+                      mapping_support_point_offsets[cell];
+                    for (unsigned int v = 0; v < n_lanes; ++v)
+                      {
+                        const double *cell_points =
+                          plain_quadrature_points.data() +
+                          (cell * n_lanes + v) * n_mapping_points * dim;
+                        for (unsigned int d = 0; d < dim; ++d)
+                          {
+                            const double x0 =
+                              cell_points[d * n_mapping_points];
+                            for (unsigned int i = 0; i < n_mapping_points; ++i)
+                              points[d * n_mapping_points + i][v] =
+                                cell_points[d * n_mapping_points + i] - x0;
+                            points[dim * n_mapping_points + d][v] = x0;
+                          }
+                      }
+                  }
+            },
+            std::max(cell_type.size() / MultithreadInfo::n_threads() / 2,
+                     std::size_t(2U)));
+
+          compute_mapping_shape_info(mapping_degree);
+        }
+
       for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
         {
           MappingInfoStorage<dim, dim, VectorizedArrayType> &my_data =
@@ -2632,7 +2719,13 @@ namespace internal
           my_data.data_index_offsets.resize(cell_type.size());
           for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
             {
-              if (process_cell[cell] == false)
+              if (geometry_on_the_fly && cell_type[cell] > affine)
+                {
+                  my_data.data_index_offsets[cell] =
+                    numbers::invalid_unsigned_int;
+                  continue;
+                }
+              else if (process_cell[cell] == false)
                 my_data.data_index_offsets[cell] =
                   my_data.data_index_offsets[cell_data_index_vect[cell]];
               else
@@ -2643,13 +2736,18 @@ namespace internal
                            (cell_type[cell] <= affine ? 2 : n_q_points));
             }
 
-          my_data.JxW_values.resize_fast(max_size);
-          my_data.jacobians[0].resize_fast(max_size);
+          // zero-initialize the fields because the unused slots of affine
+          // cells enter the comparison in
+          // MappingInfoStorage::compress_data_fields()
+          my_data.JxW_values.resize(max_size);
+          my_data.jacobians[0].resize(max_size);
           if (update_flags_cells & update_jacobian_grads)
-            my_data.jacobian_gradients[0].resize_fast(max_size);
+            my_data.jacobian_gradients[0].resize(max_size);
 
           if (update_flags_cells & update_quadrature_points)
             {
+              const unsigned int n_q_points_general =
+                geometry_on_the_fly ? 0 : n_q_points;
               my_data.quadrature_point_offsets.resize(cell_type.size());
               for (unsigned int cell = 1; cell < cell_type.size(); ++cell)
                 if (cell_type[cell - 1] <= affine)
@@ -2657,10 +2755,11 @@ namespace internal
                     my_data.quadrature_point_offsets[cell - 1] + 1;
                 else
                   my_data.quadrature_point_offsets[cell] =
-                    my_data.quadrature_point_offsets[cell - 1] + n_q_points;
+                    my_data.quadrature_point_offsets[cell - 1] +
+                    n_q_points_general;
               my_data.quadrature_points.resize_fast(
                 my_data.quadrature_point_offsets.back() +
-                (cell_type.back() <= affine ? 1 : n_q_points));
+                (cell_type.back() <= affine ? 1 : n_q_points_general));
             }
 
           // step 4b: go through the cells and compute the information using
@@ -2680,7 +2779,8 @@ namespace internal
                 update_flags_cells,
                 plain_quadrature_points,
                 shape_infos[my_q],
-                my_data);
+                my_data,
+                geometry_on_the_fly);
             },
             std::max(cell_type.size() / MultithreadInfo::n_threads() / 2,
                      std::size_t(2U)));
@@ -2768,17 +2868,18 @@ namespace internal
           const UpdateFlags update_flags_common =
             update_flags_boundary_faces | update_flags_inner_faces;
 
-          my_data.JxW_values.resize_fast(max_size);
-          my_data.normal_vectors.resize_fast(max_size);
-          my_data.jacobians[0].resize_fast(max_size);
-          my_data.jacobians[1].resize_fast(max_size);
+          // zero-initialize the fields, see the comment on cells above
+          my_data.JxW_values.resize(max_size);
+          my_data.normal_vectors.resize(max_size);
+          my_data.jacobians[0].resize(max_size);
+          my_data.jacobians[1].resize(max_size);
           if (update_flags_common & update_jacobian_grads)
             {
-              my_data.jacobian_gradients[0].resize_fast(max_size);
-              my_data.jacobian_gradients[1].resize_fast(max_size);
+              my_data.jacobian_gradients[0].resize(max_size);
+              my_data.jacobian_gradients[1].resize(max_size);
             }
-          my_data.normals_times_jacobians[0].resize_fast(max_size);
-          my_data.normals_times_jacobians[1].resize_fast(max_size);
+          my_data.normals_times_jacobians[0].resize(max_size);
+          my_data.normals_times_jacobians[1].resize(max_size);
 
           if (update_flags_common & update_quadrature_points)
             {
@@ -2859,6 +2960,112 @@ namespace internal
 
 
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::compute_mapping_shape_info(
+      const unsigned int mapping_degree)
+    {
+      FE_DGQ<dim> fe_geometry(mapping_degree);
+      mapping_shape_info.resize(cell_data.size());
+      for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+        mapping_shape_info[my_q].reinit(
+          cell_data[my_q].descriptor[0].quadrature, fe_geometry);
+    }
+
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                               cell,
+        const unsigned int                               quad_no,
+        CellGeometryOnTheFly<dim, VectorizedArrayType> &geometry) const
+    {
+      Assert(cell_geometry_is_computed_on_the_fly(cell),
+             ExcMessage("The geometry of this cell batch is stored and not "
+                        "computed on the fly."));
+      AssertIndexRange(quad_no, mapping_shape_info.size());
+
+      const ShapeInfo<VectorizedArrayType> &shape_info =
+        mapping_shape_info[quad_no];
+      const auto &descriptor = cell_data[quad_no].descriptor[0];
+
+      const unsigned int n_q_points = descriptor.n_q_points;
+      const unsigned int n_mapping_points =
+        shape_info.dofs_per_component_on_cell;
+      constexpr unsigned int hess_dim = dim * (dim + 1) / 2;
+
+      FEEvaluationData<dim, VectorizedArrayType, false> eval(shape_info);
+      eval.set_data_pointers(&geometry.scratch_data, dim);
+
+      const VectorizedArrayType *support_points =
+        mapping_support_points.data() + mapping_support_point_offsets[cell];
+      std::copy(support_points,
+                support_points + dim * n_mapping_points,
+                eval.begin_dof_values());
+
+      FEEvaluationFactory<dim, VectorizedArrayType>::evaluate(
+        dim,
+        EvaluationFlags::values | EvaluationFlags::gradients |
+          (update_flags_cells & update_jacobian_grads ?
+             EvaluationFlags::hessians :
+             EvaluationFlags::nothing),
+        eval.begin_dof_values(),
+        eval);
+
+      geometry.jacobians.resize_fast(n_q_points);
+      geometry.JxW_values.resize_fast(n_q_points);
+      if (update_flags_cells & update_jacobian_grads)
+        geometry.jacobian_gradients.resize_fast(n_q_points);
+      if (update_flags_cells & update_quadrature_points)
+        {
+          geometry.quadrature_points.resize_fast(n_q_points);
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const VectorizedArrayType x0 =
+                support_points[dim * n_mapping_points + d];
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                geometry.quadrature_points[q][d] =
+                  x0 + eval.begin_values()[q + d * n_q_points];
+            }
+        }
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          Tensor<2, dim, VectorizedArrayType> jac;
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int e = 0; e < dim; ++e)
+              jac[d][e] = eval.begin_gradients()[q + (d * dim + e) * n_q_points];
+
+          const Tensor<2, dim, VectorizedArrayType> inv_jac =
+            transpose(invert(jac));
+          geometry.JxW_values[q] =
+            determinant(jac) * Number(descriptor.quadrature.weight(q));
+          geometry.jacobians[q] = inv_jac;
+
+          if (update_flags_cells & update_jacobian_grads)
+            {
+              Tensor<3, dim, VectorizedArrayType> jac_grad;
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  for (unsigned int e = 0; e < dim; ++e)
+                    jac_grad[d][e][e] =
+                      eval.begin_hessians()[q + (d * hess_dim + e) * n_q_points];
+                  for (unsigned int c = dim, e = 0; e < dim; ++e)
+                    for (unsigned int f = e + 1; f < dim; ++f, ++c)
+                      jac_grad[d][e][f] = jac_grad[d][f][e] =
+                        eval.begin_hessians()[q + (d * hess_dim + c) *
+                                                    n_q_points];
+                }
+              geometry.jacobian_gradients[q] =
+                process_jacobian_gradient(inv_jac, inv_jac, jac_grad);
+            }
+        }
+    }
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     void
     MappingInfo<dim, Number, VectorizedArrayType>::initialize_faces_by_cells(
@@ -2917,26 +3124,22 @@ namespace internal
                     (i * GeometryInfo<dim>::faces_per_cell + face) *
                     face_data_by_cells[my_q].descriptor[0].n_q_points;
               }
-          face_data_by_cells[my_q].JxW_values.resize_fast(
-            storage_length * GeometryInfo<dim>::faces_per_cell);
-          face_data_by_cells[my_q].jacobians[0].resize_fast(
-            storage_length * GeometryInfo<dim>::faces_per_cell);
-          face_data_by_cells[my_q].jacobians[1].resize_fast(
-            storage_length * GeometryInfo<dim>::faces_per_cell);
+          face_data_by_cells[my_q].JxW_values.resize(storage_length);
+          face_data_by_cells[my_q].jacobians[0].resize(storage_length);
+          face_data_by_cells[my_q].jacobians[1].resize(storage_length);
           if (update_flags & update_normal_vectors)
-            face_data_by_cells[my_q].normal_vectors.resize_fast(
-              storage_length * GeometryInfo<dim>::faces_per_cell);
+            face_data_by_cells[my_q].normal_vectors.resize(storage_length);
           if (update_flags & update_normal_vectors &&
               update_flags & update_jacobians)
-            face_data_by_cells[my_q].normals_times_jacobians[0].resize_fast(
-              storage_length * GeometryInfo<dim>::faces_per_cell);
+            face_data_by_cells[my_q].normals_times_jacobians[0].resize(
+              storage_length);
           if (update_flags & update_normal_vectors &&
               update_flags & update_jacobians)
-            face_data_by_cells[my_q].normals_times_jacobians[1].resize_fast(
-              storage_length * GeometryInfo<dim>::faces_per_cell);
+            face_data_by_cells[my_q].normals_times_jacobians[1].resize(
+              storage_length);
           if (update_flags & update_jacobian_grads)
-            face_data_by_cells[my_q].jacobian_gradients[0].resize_fast(
-              storage_length * GeometryInfo<dim>::faces_per_cell);
+            face_data_by_cells[my_q].jacobian_gradients[0].resize(
+              storage_length);
 
           if (update_flags & update_quadrature_points)
             face_data_by_cells[my_q].quadrature_points.resize_fast(
@@ -3135,6 +3338,10 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(face_data);
       memory += cell_type.capacity() * sizeof(GeometryType);
       memory += face_type.capacity() * sizeof(GeometryType);
+      memory += MemoryConsumption::memory_consumption(mapping_support_points);
+      memory +=
+        MemoryConsumption::memory_consumption(mapping_support_point_offsets);
+      memory += MemoryConsumption::memory_consumption(mapping_shape_info);
       memory += sizeof(*this);
       return memory;
     }
@@ -3156,6 +3363,12 @@ namespace internal
       task_info.print_memory_statistics(out,
                                         face_type.capacity() *
                                           sizeof(GeometryType));
+      if (mapping_support_points.empty() == false)
+        {
+          out << "    Mapping support points:          ";
+          task_info.print_memory_statistics(
+            out, MemoryConsumption::memory_consumption(mapping_support_points));
+        }
       for (unsigned int j = 0; j < cell_data.size(); ++j)
         {
           out << "    Data component " << j << std::endl;
@@ -22,6 +22,7 @@
 
 #include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/vectorization.h>
@@ -284,6 +285,43 @@ namespace internal
       void
       clear_data_fields();
 
+      /**
+       * Find the blocks of data of affine and Cartesian cells or faces,
+       * i.e., the blocks of at most two entries in the fields indexed by
+       * @p data_index_offsets, that contain the same data on all SIMD lanes
+       * and let the respective entries of @p data_index_offsets point to a
+       * single copy. The blocks are identified by a lookup keyed by the
+       * entries of all fields rounded to a few units in the last place. As
+       * opposed to the compression during the setup, which combines batches
+       * whose lanes have been found to be translations of the same cells lane
+       * by lane, this compares the final data of whole batches and thus works
+       * across all batches of the mesh, regardless of how the cells have been
+       * grouped into the batches.
+       */
+      void
+      compress_data_fields();
+
+      /**
+       * Return the memory consumption in bytes that the fields indexed by
+       * @p data_index_offsets would have if every cell or face batch held its
+       * own copy of the data. The ratio to the actual memory consumption of
+       * these fields is the compression ratio reported by
+       * print_memory_consumption().
+       */
+      std::size_t
+      uncompressed_data_memory_consumption() const;
+
+      /**
+       * Copy all data from an object with a different number type, converting
+       * the entries. The number type of this object can have more SIMD lanes
+       * than the one of @p other, in which case the additional lanes are
+       * filled with the data of the last lane of @p other.
+       */
+      template <typename OtherNumber>
+      void
+      copy_from(
+        const MappingInfoStorage<structdim, spacedim, OtherNumber> &other);
+
       /**
        * Returns the quadrature index for a given number of quadrature
        * points. If not in hp-mode or if the index is not found, this
@@ -323,6 +361,99 @@ namespace internal
 
     /* ------------------- inline functions ----------------------------- */
 
+    namespace MappingInfoStorageHelper
+    {
+      // Convert the entries of the geometry fields between different number
+      // types, lane by lane for vectorized types. If the output has more
+      // lanes, the additional lanes get the data of the last input lane, like
+      // the unused lanes of partially filled cell batches
+      template <typename Number, typename OtherNumber>
+      inline void
+      convert_entry(const OtherNumber &in, Number &out)
+      {
+        out = in;
+      }
+
+      template <typename Number,
+                std::size_t width,
+                typename OtherNumber,
+                std::size_t other_width>
+      inline void
+      convert_entry(const VectorizedArray<OtherNumber, other_width> &in,
+                    VectorizedArray<Number, width> &                 out)
+      {
+        static_assert(width >= other_width,
+                      "The number of lanes can not be decreased.");
+        for (unsigned int v = 0; v < width; ++v)
+          out[v] = in[std::min<unsigned int>(v, other_width - 1)];
+      }
+
+      template <int rank, int dim, typename Number, typename OtherNumber>
+      inline void
+      convert_entry(const Tensor<rank, dim, OtherNumber> &in,
+                    Tensor<rank, dim, Number> &           out)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          convert_entry(in[d], out[d]);
+      }
+
+      template <int dim, typename Number, typename OtherNumber>
+      inline void
+      convert_entry(const Point<dim, OtherNumber> &in, Point<dim, Number> &out)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          convert_entry(in[d], out[d]);
+      }
+
+      template <typename T, typename OtherT>
+      inline void
+      convert_vector(const AlignedVector<OtherT> &in, AlignedVector<T> &out)
+      {
+        out.resize_fast(in.size());
+        for (unsigned int i = 0; i < in.size(); ++i)
+          convert_entry(in[i], out[i]);
+      }
+    } // namespace MappingInfoStorageHelper
+
+
+
+    template <int structdim, int spacedim, typename Number>
+    template <typename OtherNumber>
+    inline void
+    MappingInfoStorage<structdim, spacedim, Number>::copy_from(
+      const MappingInfoStorage<structdim, spacedim, OtherNumber> &other)
+    {
+      using namespace MappingInfoStorageHelper;
+
+      descriptor.resize(other.descriptor.size());
+      for (unsigned int i = 0; i < descriptor.size(); ++i)
+        {
+          descriptor[i].n_q_points    = other.descriptor[i].n_q_points;
+          descriptor[i].quadrature_1d = other.descriptor[i].quadrature_1d;
+          descriptor[i].quadrature    = other.descriptor[i].quadrature;
+          for (int d = 0; d < structdim; ++d)
+            convert_vector(other.descriptor[i].tensor_quadrature_weights[d],
+                           descriptor[i].tensor_quadrature_weights[d]);
+          convert_vector(other.descriptor[i].quadrature_weights,
+                         descriptor[i].quadrature_weights);
+        }
+      q_collection       = other.q_collection;
+      data_index_offsets = other.data_index_offsets;
+      convert_vector(other.JxW_values, JxW_values);
+      convert_vector(other.normal_vectors, normal_vectors);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert_vector(other.jacobians[i], jacobians[i]);
+          convert_vector(other.jacobian_gradients[i], jacobian_gradients[i]);
+          convert_vector(other.normals_times_jacobians[i],
+                         normals_times_jacobians[i]);
+        }
+      quadrature_point_offsets = other.quadrature_point_offsets;
+      convert_vector(other.quadrature_points, quadrature_points);
+    }
+
+
+
     template <int structdim, int spacedim, typename Number>
     inline unsigned int
     MappingInfoStorage<structdim, spacedim, Number>::quad_index_from_n_q_points(
@@ -33,6 +33,13 @@
 #include <deal.II/matrix_free/task_info.h>
 #include <deal.II/matrix_free/util.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <type_traits>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -120,6 +127,240 @@ namespace internal
 
 
 
+    namespace MappingInfoStorageHelper
+    {
+      // Return the sorted list of the starting positions of the data blocks
+      // referenced by the given offsets. As the blocks are stored
+      // contiguously, the length of a block is the distance to the start of
+      // the next block, or to the end of the fields for the last one.
+      inline std::vector<unsigned int>
+      get_data_block_starts(
+        const AlignedVector<unsigned int> &data_index_offsets)
+      {
+        std::vector<unsigned int> block_starts;
+        block_starts.reserve(data_index_offsets.size());
+        for (const unsigned int offset : data_index_offsets)
+          if (offset != numbers::invalid_unsigned_int)
+            block_starts.push_back(offset);
+        std::sort(block_starts.begin(), block_starts.end());
+        block_starts.erase(std::unique(block_starts.begin(),
+                                       block_starts.end()),
+                           block_starts.end());
+        return block_starts;
+      }
+
+
+
+      // Return the number of entries in the fields indexed by the given
+      // offsets if every cell or face batch held its own copy of the data
+      inline std::size_t
+      count_uncompressed_entries(
+        const AlignedVector<unsigned int> &data_index_offsets,
+        const std::size_t                  n_data)
+      {
+        const std::vector<unsigned int> block_starts =
+          get_data_block_starts(data_index_offsets);
+        std::size_t n_entries = 0;
+        for (const unsigned int offset : data_index_offsets)
+          if (offset != numbers::invalid_unsigned_int)
+            {
+              const auto next_block = std::upper_bound(block_starts.begin(),
+                                                       block_starts.end(),
+                                                       offset);
+              n_entries +=
+                (next_block == block_starts.end() ? n_data : *next_block) -
+                offset;
+            }
+        return n_entries;
+      }
+    } // namespace MappingInfoStorageHelper
+
+
+
+    template <int structdim, int spacedim, typename Number>
+    void
+    MappingInfoStorage<structdim, spacedim, Number>::compress_data_fields()
+    {
+      using ScalarNumber = typename VectorizedArrayTrait<Number>::value_type;
+
+      // all fields indexed by data_index_offsets must follow the layout of
+      // the JxW values, otherwise we cannot move the blocks around
+      const std::size_t n_data      = JxW_values.size();
+      const auto        same_layout = [n_data](const std::size_t size) {
+        return size == 0 || size == n_data;
+      };
+      if (n_data == 0 || !same_layout(normal_vectors.size()) ||
+          !same_layout(jacobians[0].size()) ||
+          !same_layout(jacobians[1].size()) ||
+          !same_layout(jacobian_gradients[0].size()) ||
+          !same_layout(jacobian_gradients[1].size()) ||
+          !same_layout(normals_times_jacobians[0].size()) ||
+          !same_layout(normals_times_jacobians[1].size()))
+        return;
+
+      const std::vector<unsigned int> block_starts =
+        MappingInfoStorageHelper::get_data_block_starts(data_index_offsets);
+      if (block_starts.empty() || block_starts.back() >= n_data)
+        return;
+
+      // Round the entries to the leading digits-4 bits of the mantissa, such
+      // that data that only differs by roundoff in the setup (e.g. due to a
+      // translation of the cells) gets the same key. Data that happens to be
+      // on the two sides of a rounding boundary is not merged, which only
+      // reduces the compression. The key stores the bit patterns of the
+      // rounded numbers to get a well-defined ordering also for special
+      // values.
+      using KeyType =
+        typename std::conditional<sizeof(ScalarNumber) == sizeof(std::uint64_t),
+                                  std::uint64_t,
+                                  std::uint32_t>::type;
+      static_assert(sizeof(KeyType) == sizeof(ScalarNumber),
+                    "Unexpected size of floating point type");
+      const ScalarNumber scaling =
+        std::ldexp(ScalarNumber(1.),
+                   std::numeric_limits<ScalarNumber>::digits - 4);
+      std::vector<KeyType> key;
+      const auto           append_to_key = [&](const auto &       field,
+                                     const unsigned int start,
+                                     const unsigned int length) {
+        if (field.empty())
+          return;
+        const ScalarNumber *entries =
+          reinterpret_cast<const ScalarNumber *>(field.data() + start);
+        const std::size_t n_entries =
+          length * sizeof(field[0]) / sizeof(ScalarNumber);
+
+        // entries that are zero up to roundoff relative to the largest entry
+        // of the field, like the off-diagonal entries of the Jacobian of a
+        // Cartesian cell, are considered as zero
+        ScalarNumber max_entry = ScalarNumber();
+        for (std::size_t i = 0; i < n_entries; ++i)
+          max_entry = std::max(max_entry, std::abs(entries[i]));
+        const ScalarNumber zero_tolerance =
+          100 * std::numeric_limits<ScalarNumber>::epsilon() * max_entry;
+
+        for (std::size_t i = 0; i < n_entries; ++i)
+          {
+            ScalarNumber rounded = ScalarNumber();
+            // this also avoids to distinguish between +0 and -0
+            if (std::abs(entries[i]) > zero_tolerance)
+              {
+                int                exponent;
+                const ScalarNumber mantissa = std::frexp(entries[i], &exponent);
+                rounded = std::ldexp(std::round(mantissa * scaling) / scaling,
+                                     exponent);
+              }
+            KeyType bits;
+            std::memcpy(&bits, &rounded, sizeof(KeyType));
+            key.push_back(bits);
+          }
+      };
+
+      // Go through the blocks and identify duplicates. Only the short blocks
+      // of affine and Cartesian cells or faces are considered, because the
+      // keys of general cells would temporarily need as much memory as the
+      // data itself, and their lane-by-lane compression during the setup
+      // already catches the relevant cases.
+      std::map<std::vector<KeyType>, unsigned int> unique_blocks;
+      std::vector<unsigned int> new_block_starts(block_starts.size());
+      std::vector<std::pair<unsigned int, unsigned int>> kept_blocks;
+      unsigned int                                       new_size = 0;
+      for (unsigned int b = 0; b < block_starts.size(); ++b)
+        {
+          const unsigned int length =
+            (b + 1 < block_starts.size() ? block_starts[b + 1] : n_data) -
+            block_starts[b];
+          bool is_new_block = true;
+          if (length <= 2)
+            {
+              key.clear();
+              append_to_key(JxW_values, block_starts[b], length);
+              append_to_key(normal_vectors, block_starts[b], length);
+              for (unsigned int i = 0; i < 2; ++i)
+                {
+                  append_to_key(jacobians[i], block_starts[b], length);
+                  append_to_key(jacobian_gradients[i], block_starts[b], length);
+                  append_to_key(normals_times_jacobians[i],
+                                block_starts[b],
+                                length);
+                }
+              const auto inserted = unique_blocks.emplace(key, new_size);
+              is_new_block        = inserted.second;
+              new_block_starts[b] = inserted.first->second;
+            }
+          else
+            new_block_starts[b] = new_size;
+
+          if (is_new_block)
+            {
+              kept_blocks.emplace_back(block_starts[b], length);
+              new_size += length;
+            }
+        }
+
+      if (new_size == n_data)
+        return;
+
+      const auto compress_field = [&](auto &field) {
+        if (field.empty())
+          return;
+        typename std::remove_reference<decltype(field)>::type new_field;
+        new_field.resize_fast(new_size);
+        unsigned int position = 0;
+        for (const auto &block : kept_blocks)
+          {
+            std::copy(field.begin() + block.first,
+                      field.begin() + block.first + block.second,
+                      new_field.begin() + position);
+            position += block.second;
+          }
+        field.swap(new_field);
+      };
+      compress_field(JxW_values);
+      compress_field(normal_vectors);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          compress_field(jacobians[i]);
+          compress_field(jacobian_gradients[i]);
+          compress_field(normals_times_jacobians[i]);
+        }
+
+      for (unsigned int &offset : data_index_offsets)
+        if (offset != numbers::invalid_unsigned_int)
+          offset = new_block_starts[std::lower_bound(block_starts.begin(),
+                                                     block_starts.end(),
+                                                     offset) -
+                                    block_starts.begin()];
+    }
+
+
+
+    template <int structdim, int spacedim, typename Number>
+    std::size_t
+    MappingInfoStorage<structdim, spacedim, Number>::
+      uncompressed_data_memory_consumption() const
+    {
+      const std::size_t n_data          = JxW_values.size();
+      std::size_t       bytes_per_entry = sizeof(Number);
+      if (normal_vectors.size() == n_data)
+        bytes_per_entry += sizeof(normal_vectors[0]);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          if (jacobians[i].size() == n_data)
+            bytes_per_entry += sizeof(jacobians[i][0]);
+          if (jacobian_gradients[i].size() == n_data)
+            bytes_per_entry += sizeof(jacobian_gradients[i][0]);
+          if (normals_times_jacobians[i].size() == n_data)
+            bytes_per_entry += sizeof(normals_times_jacobians[i][0]);
+        }
+
+      return MappingInfoStorageHelper::count_uncompressed_entries(
+               data_index_offsets, n_data) *
+             bytes_per_entry;
+    }
+
+
+
     template <int structdim, int spacedim, typename Number>
     UpdateFlags
     MappingInfoStorage<structdim, spacedim, Number>::compute_update_flags(
@@ -230,6 +471,20 @@ namespace internal
                 normals_times_jacobians[1]));
         }
 
+      if (size > 0)
+        {
+          const std::size_t n_entries =
+            Utilities::MPI::sum(JxW_values.size(), task_info.communicator);
+          const std::size_t n_uncompressed_entries = Utilities::MPI::sum(
+            MappingInfoStorageHelper::count_uncompressed_entries(
+              data_index_offsets, JxW_values.size()),
+            task_info.communicator);
+          out << "      Compression ratio geometry:    "
+              << static_cast<double>(n_uncompressed_entries) /
+                   std::max<std::size_t>(n_entries, 1)
+              << std::endl;
+        }
+
       const std::size_t quad_size =
         Utilities::MPI::sum(quadrature_points.size(), task_info.communicator);
       if (quad_size > 0)
@@ -134,7 +134,7 @@ public:
    * Collects the options for initialization of the MatrixFree class. The
    * first parameter specifies the MPI communicator to be used, the second the
    * parallelization options in shared memory (task-based parallelism, where
-   * one can choose between no parallelism and three schemes that avoid that
+   * one can choose between no parallelism and four schemes that avoid that
    * cells with access to the same vector entries are accessed
    * simultaneously), the third with the block size for task parallel
    * scheduling, the fourth the update flags that should be stored by this
@@ -203,7 +203,13 @@ public:
        * Use the traditional coloring algorithm: this is like
        * TasksParallelScheme::partition_color, but only uses one partition.
        */
-      color = internal::MatrixFreeFunctions::TaskInfo::color
+      color = internal::MatrixFreeFunctions::TaskInfo::color,
+      /**
+       * Partition the cells into two levels like
+       * TasksParallelScheme::partition_partition, but schedule the chunks
+       * dynamically with work stealing.
+       */
+      work_stealing = internal::MatrixFreeFunctions::TaskInfo::work_stealing
     };
 
     /**
@@ -224,7 +230,8 @@ public:
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
       const bool         cell_vectorization_categories_strict = false,
-      const bool         allow_ghosted_vectors_in_loops       = true)
+      const bool         allow_ghosted_vectors_in_loops       = true,
+      const bool         compute_geometry_on_the_fly          = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -240,6 +247,7 @@ public:
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(allow_ghosted_vectors_in_loops)
+      , compute_geometry_on_the_fly(compute_geometry_on_the_fly)
       , communicator_sm(MPI_COMM_SELF)
     {}
 
@@ -266,6 +274,7 @@ public:
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(other.allow_ghosted_vectors_in_loops)
+      , compute_geometry_on_the_fly(other.compute_geometry_on_the_fly)
       , communicator_sm(other.communicator_sm)
     {}
 
@@ -294,13 +303,14 @@ public:
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
       allow_ghosted_vectors_in_loops = other.allow_ghosted_vectors_in_loops;
+      compute_geometry_on_the_fly    = other.compute_geometry_on_the_fly;
       communicator_sm                = other.communicator_sm;
 
       return *this;
     }
 
     /**
-     * Set the scheme for task parallelism. There are four options available.
+     * Set the scheme for task parallelism. There are five options available.
      * If set to @p none, the operator application is done in serial without
      * shared memory parallelism. If this class is used together with MPI and
      * MPI is also used for parallelism within the nodes, this flag should be
@@ -327,6 +337,19 @@ public:
      * might degrade parallel performance (bad cache behavior, many
      * synchronization points).
      *
+     * The fourth option @p work_stealing uses the same partitions as
+     * @p partition_partition, but rather than a fixed tree of tasks, all
+     * chunks form a single graph whose dependencies are resolved at run
+     * time: A chunk is handed to the threads as soon as the neighboring
+     * chunks accessing the same vector entries are done, and idle threads
+     * steal work from busy ones. The thread that completes a chunk continues
+     * with one of its neighbors to re-use the vector entries in cache. The
+     * time spent in each chunk is measured, and subsequent loops start the
+     * chunks on the longest remaining path through the graph first, which
+     * balances unequal costs of cell, face and boundary work. This option is
+     * also available when deal.II is configured with the oneAPI version of
+     * TBB, where the other options fall back to @p none.
+     *
      * @note Threading support is currently experimental for the case inner
      * face integrals are performed and it is recommended to use MPI
      * parallelism if possible. While the scheme has been verified to work
@@ -531,6 +554,24 @@ public:
      */
     bool allow_ghosted_vectors_in_loops;
 
+    /**
+     * By default, the inverse Jacobians and JxW values are precomputed and
+     * stored on all quadrature points of cells with a general (non-affine)
+     * geometry. On curved meshes with high polynomial degrees, loading these
+     * data from memory can take more time than the access to the vectors.
+     * If this flag is set to @p true, only the support points of the
+     * mapping are stored for these cells, and FEEvaluation::reinit()
+     * recomputes the geometry with the same tensor-product kernels that are
+     * used for the solution fields. This trades memory transfer for
+     * arithmetic operations and leaves the interface of FEEvaluation
+     * unchanged.
+     *
+     * This option is only used for the cell data when the mapping is a
+     * MappingQ (or derived from it) and no hp-capabilities are in use; it is
+     * ignored otherwise. The geometry data on faces is always stored.
+     */
+    bool compute_geometry_on_the_fly;
+
     /**
      * Shared-memory MPI communicator. Default: MPI_COMM_SELF.
      */
@@ -724,6 +765,55 @@ public:
   copy_from(
     const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free_base);
 
+  /**
+   * Copy function from an object with a different number type. This makes
+   * it possible to set up, e.g., a MatrixFree<dim, float> object for a
+   * multigrid smoother from the MatrixFree<dim, double> object on the same
+   * DoFHandler and mapping without running the full setup again:
+   * - The information about the degrees of freedom (DoFInfo) is shared
+   *   between the two objects rather than copied, if both use the same
+   *   number of SIMD lanes. Otherwise, it is converted to the layout of
+   *   this object and stored separately. To save the memory of the index
+   *   data, choose a @p VectorizedArrayType for this object with as many
+   *   lanes as the one of @p other.
+   * - The cell and face layout, including the task layout (TaskInfo), is
+   *   copied.
+   * - The geometry data is converted to the new number type, so the float
+   *   object stores its geometry in single precision.
+   * - The shape information is recomputed for the new number type from the
+   *   finite elements and the quadrature formulas of @p other.
+   *
+   * Since FEEvaluation can read from and write into vectors with a
+   * different number type than the MatrixFree object, the resulting object
+   * can also be used for mixed-precision evaluation, e.g., with geometry
+   * and shape data in float and vectors in double.
+   *
+   * The cell and face batches are laid out for the number of SIMD lanes of
+   * @p other. If this object uses the same number of lanes, e.g. a
+   * MatrixFree<dim, float, VectorizedArray<float, 4>> converted from a
+   * MatrixFree<dim, double, VectorizedArray<double, 4>>, all lanes are
+   * filled as in @p other. With the default types, however, a
+   * MatrixFree<dim, float> object has twice as many lanes as a
+   * MatrixFree<dim, double> object. In that case, the batches of @p other
+   * are kept with their cells in the first lanes and the remaining lanes
+   * left empty, like in the last batch of a partially filled range. The
+   * index data then can not be shared but is converted to the wider
+   * layout. Since only part of the SIMD lanes is used, the arithmetic
+   * throughput per cell is the one of @p other, and only the memory
+   * transfer of the vectors and the geometry benefits from the smaller
+   * number type. To fill all lanes, set up the object with reinit()
+   * instead, or select the SIMD width of @p other explicitly, e.g.
+   * VectorizedArray<float, VectorizedArray<double>::size()> where this
+   * type exists. Converting to fewer lanes than @p other is not supported.
+   *
+   * @note When converting from a lower to a higher precision, the geometry
+   * is only accurate to the lower precision.
+   */
+  template <typename OtherNumber, typename OtherVectorizedArrayType>
+  void
+  copy_from(
+    const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType> &other);
+
   /**
    * Refreshes the geometry data stored in the MappingInfo fields when the
    * underlying geometry has changed (e.g. by a mapping that can deform
@@ -2097,9 +2187,10 @@ private:
 
   /**
    * Contains the information about degrees of freedom on the individual cells
-   * and constraints.
+   * and constraints. The data is shared with the objects that have been
+   * initialized by copy_from().
    */
-  std::vector<internal::MatrixFreeFunctions::DoFInfo> dof_info;
+  internal::MatrixFreeFunctions::DoFInfoCollection dof_info;
 
   /**
    * Contains the weights for constraints stored in DoFInfo. Filled into a
@@ -2191,6 +2282,10 @@ private:
    * Stored the level of the mesh to be worked on.
    */
   unsigned int mg_level;
+
+  // Allow copy_from() to access the data of objects with other number types
+  template <int, typename, typename>
+  friend class MatrixFree;
 };
 
 
@@ -2427,6 +2522,141 @@ inline const internal::MatrixFreeFunctions::
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OtherNumber, typename OtherVectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
+  const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType> &other)
+{
+  static_assert(VectorizedArrayType::size() >= OtherVectorizedArrayType::size(),
+                "The conversion to a type with fewer SIMD lanes is not "
+                "supported, because the cell and face batches would need to "
+                "be split.");
+  Assert(other.indices_are_initialized && other.mapping_is_initialized,
+         ExcMessage("The MatrixFree object to copy from must be fully "
+                    "initialized."));
+
+  clear();
+  dof_handlers = other.dof_handlers;
+  dof_info     = other.dof_info;
+  constraint_pool_data.assign(other.constraint_pool_data.begin(),
+                              other.constraint_pool_data.end());
+  constraint_pool_row_index  = other.constraint_pool_row_index;
+  cell_level_index_end_local = other.cell_level_index_end_local;
+  task_info                  = other.task_info;
+  mg_level                   = other.mg_level;
+  mapping_info.copy_from(other.mapping_info);
+
+  // with more SIMD lanes, the batches of the other object are kept and the
+  // data stored per lane is spread to the wider layout, leaving the
+  // additional lanes empty
+  constexpr unsigned int n_lanes       = VectorizedArrayType::size();
+  constexpr unsigned int n_other_lanes = OtherVectorizedArrayType::size();
+  task_info.vectorization_length       = n_lanes;
+
+  const auto spread_index = [](const unsigned int index) {
+    return index == numbers::invalid_unsigned_int ?
+             index :
+             index / n_other_lanes * n_lanes + index % n_other_lanes;
+  };
+
+  face_info.faces.resize(other.face_info.faces.size());
+  for (unsigned int f = 0; f < face_info.faces.size(); ++f)
+    {
+      const auto &other_face = other.face_info.faces[f];
+      auto &      face       = face_info.faces[f];
+      face.cells_interior.fill(numbers::invalid_unsigned_int);
+      face.cells_exterior.fill(numbers::invalid_unsigned_int);
+      for (unsigned int v = 0; v < n_other_lanes; ++v)
+        {
+          face.cells_interior[v] = spread_index(other_face.cells_interior[v]);
+          face.cells_exterior[v] = spread_index(other_face.cells_exterior[v]);
+        }
+      face.exterior_face_no = other_face.exterior_face_no;
+      face.interior_face_no = other_face.interior_face_no;
+      face.subface_index    = other_face.subface_index;
+      face.face_orientation = other_face.face_orientation;
+      face.face_type        = other_face.face_type;
+    }
+
+  const auto &other_plain_faces = other.face_info.cell_and_face_to_plain_faces;
+  const auto &other_boundary_id = other.face_info.cell_and_face_boundary_id;
+  face_info.cell_and_face_to_plain_faces.reinit(
+    TableIndices<3>(other_plain_faces.size(0),
+                    other_plain_faces.size(1),
+                    other_plain_faces.size(0) > 0 ? n_lanes : 0),
+    true);
+  face_info.cell_and_face_to_plain_faces.fill(numbers::invalid_unsigned_int);
+  face_info.cell_and_face_boundary_id.reinit(
+    TableIndices<3>(other_boundary_id.size(0),
+                    other_boundary_id.size(1),
+                    other_boundary_id.size(0) > 0 ? n_lanes : 0),
+    true);
+  face_info.cell_and_face_boundary_id.fill(numbers::invalid_boundary_id);
+  for (unsigned int c = 0; c < other_plain_faces.size(0); ++c)
+    for (unsigned int f = 0; f < other_plain_faces.size(1); ++f)
+      for (unsigned int v = 0; v < n_other_lanes; ++v)
+        {
+          face_info.cell_and_face_to_plain_faces(c, f, v) =
+            spread_index(other_plain_faces(c, f, v));
+          face_info.cell_and_face_boundary_id(c, f, v) =
+            other_boundary_id(c, f, v);
+        }
+
+  // the unused lanes repeat the last cell of the batch, which is how
+  // n_active_entries_per_cell_batch() detects them
+  cell_level_index.clear();
+  cell_level_index.reserve(other.cell_level_index.size() / n_other_lanes *
+                           n_lanes);
+  for (unsigned int i = 0; i < other.cell_level_index.size();
+       i += n_other_lanes)
+    {
+      cell_level_index.insert(cell_level_index.end(),
+                              other.cell_level_index.begin() + i,
+                              other.cell_level_index.begin() + i +
+                                n_other_lanes);
+      cell_level_index.resize(cell_level_index.size() + n_lanes -
+                                n_other_lanes,
+                              cell_level_index.back());
+    }
+
+  // the index data can only be shared with the same number of lanes,
+  // otherwise this object gets its own copy in the wider layout
+  if (n_lanes > n_other_lanes)
+    for (auto &di : dof_info)
+      {
+        di.increase_vectorization_length(n_lanes);
+        if (face_info.faces.empty() == false)
+          di.compute_face_index_compression(face_info.faces);
+      }
+
+  // the shape functions are evaluated again in the new number type with the
+  // same element and quadrature formula, following internal_reinit()
+  shape_info.reinit(TableIndices<4>(other.shape_info.size(0),
+                                    other.shape_info.size(1),
+                                    other.shape_info.size(2),
+                                    other.shape_info.size(3)));
+  for (unsigned int no = 0, c = 0; no < dof_handlers.size(); ++no)
+    for (unsigned int b = 0; b < dof_handlers[no]->get_fe(0).n_base_elements();
+         ++b, ++c)
+      for (unsigned int fe_no = 0;
+           fe_no < dof_handlers[no]->get_fe_collection().size();
+           ++fe_no)
+        for (unsigned int nq = 0; nq < shape_info.size(1); ++nq)
+          for (unsigned int q_no = 0;
+               q_no < mapping_info.cell_data[nq].descriptor.size();
+               ++q_no)
+            shape_info(c, nq, fe_no, q_no)
+              .reinit(mapping_info.cell_data[nq].descriptor[q_no].quadrature,
+                      dof_handlers[no]->get_fe(fe_no),
+                      b);
+
+  indices_are_initialized = true;
+  mapping_is_initialized  = true;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline const internal::MatrixFreeFunctions::DoFInfo &
 MatrixFree<dim, Number, VectorizedArrayType>::get_dof_info(
@@ -3381,6 +3611,21 @@ namespace internal
 
 
 
+    /**
+     * Return the data exchanger of get_partitioner() if it can exchange
+     * several vectors with a single message per process, and a null pointer
+     * otherwise.
+     */
+    const internal::MatrixFreeFunctions::VectorDataExchange::AggregatedBase *
+    get_aggregated_partitioner(const unsigned int mf_component) const
+    {
+      return dynamic_cast<const internal::MatrixFreeFunctions::
+                            VectorDataExchange::AggregatedBase *>(
+        &get_partitioner(mf_component));
+    }
+
+
+
     /**
      * Start update_ghost_value for serial vectors
      */
@@ -3801,6 +4046,322 @@ namespace internal
 
 
 
+    /**
+     * Exchange of the blocks with a single message per process is only
+     * implemented for LinearAlgebra::distributed::BlockVector, so do nothing
+     * for all other vector types and let the caller exchange the blocks
+     * individually.
+     */
+    template <typename VectorType>
+    bool
+    update_ghost_values_start_aggregated(
+      const unsigned int /*component_in_block_vector*/,
+      const VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Finish update_ghost_value with a single message per process for
+     * generic vector types, which is not supported, see above.
+     */
+    template <typename VectorType>
+    bool
+    update_ghost_values_finish_aggregated(
+      const unsigned int /*component_in_block_vector*/,
+      const VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Start compress with a single message per process for generic vector
+     * types, which is not supported, see above.
+     */
+    template <typename VectorType>
+    bool
+    compress_start_aggregated(const unsigned int /*component_in_block_vector*/,
+                              VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Finish compress with a single message per process for generic vector
+     * types, which is not supported, see above.
+     */
+    template <typename VectorType>
+    bool
+    compress_finish_aggregated(const unsigned int /*component_in_block_vector*/,
+                               VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Return whether the blocks of a LinearAlgebra::distributed::BlockVector
+     * can be exchanged with a single message per process, which is the case
+     * if all blocks share the same partitioner and the data exchanger of
+     * that partitioner supports it.
+     */
+    bool
+    exchange_blocks_aggregated(
+      const LinearAlgebra::distributed::BlockVector<Number> &vec) const
+    {
+#  ifdef DEAL_II_WITH_MPI
+      if (vec.n_blocks() < 2 || vec.block(0).size() == 0)
+        return false;
+      for (unsigned int b = 1; b < vec.n_blocks(); ++b)
+        if (vec.block(b).get_partitioner().get() !=
+            vec.block(0).get_partitioner().get())
+          return false;
+
+      return get_aggregated_partitioner(find_vector_in_mf(vec.block(0))) !=
+             nullptr;
+#  else
+      (void)vec;
+      return false;
+#  endif
+    }
+
+
+
+    /**
+     * Start update_ghost_value for all blocks of a block vector with a single
+     * message per process, if exchange_blocks_aggregated() allows it, and
+     * return whether this was done.
+     */
+    bool
+    update_ghost_values_start_aggregated(
+      const unsigned int component_in_block_vector,
+      const LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (exchange_blocks_aggregated(vec) == false)
+        return false;
+
+      bool ghosts_set = vec.has_ghost_elements();
+
+      Assert(matrix_free.get_task_info().allow_ghosted_vectors_in_loops ||
+               ghosts_set == false,
+             ExcNotImplemented());
+
+      if (ghosts_set)
+        ghosts_were_set = true;
+
+#  ifdef DEAL_II_WITH_MPI
+      const unsigned int mf_component = find_vector_in_mf(vec.block(0));
+
+      const auto &part = *get_aggregated_partitioner(mf_component);
+
+      if (part.n_ghost_indices() == 0 && part.n_import_indices() == 0)
+        return true;
+
+      std::vector<ArrayView<const Number>> locally_owned_arrays;
+      std::vector<ArrayView<Number>>       ghost_arrays;
+      for (unsigned int b = 0; b < vec.n_blocks(); ++b)
+        {
+          locally_owned_arrays.emplace_back(vec.block(b).begin(),
+                                            part.locally_owned_size());
+          ghost_arrays.emplace_back(
+            const_cast<Number *>(vec.block(b).begin()) +
+              part.locally_owned_size(),
+            matrix_free.get_dof_info(mf_component)
+              .vector_partitioner->n_ghost_indices());
+        }
+
+      tmp_data[component_in_block_vector] =
+        matrix_free.acquire_scratch_data_non_threadsafe();
+      tmp_data[component_in_block_vector]->resize_fast(
+        vec.n_blocks() * (part.n_import_indices() + part.n_ghost_indices()));
+      AssertDimension(requests.size(), tmp_data.size());
+
+      part.export_to_ghosted_arrays_start(
+        component_in_block_vector * 2 + channel_shift,
+        locally_owned_arrays,
+        ghost_arrays,
+        ArrayView<Number>(tmp_data[component_in_block_vector]->begin(),
+                          tmp_data[component_in_block_vector]->size()),
+        this->requests[component_in_block_vector]);
+#  else
+      (void)component_in_block_vector;
+#  endif
+
+      return true;
+    }
+
+
+
+    /**
+     * Finish update_ghost_value for block vectors started by
+     * update_ghost_values_start_aggregated(), and return whether the blocks
+     * were exchanged in aggregated form.
+     */
+    bool
+    update_ghost_values_finish_aggregated(
+      const unsigned int component_in_block_vector,
+      const LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (exchange_blocks_aggregated(vec) == false)
+        return false;
+
+#  ifdef DEAL_II_WITH_MPI
+      AssertIndexRange(component_in_block_vector, tmp_data.size());
+      AssertDimension(requests.size(), tmp_data.size());
+
+      const unsigned int mf_component = find_vector_in_mf(vec.block(0));
+
+      const auto &part = *get_aggregated_partitioner(mf_component);
+
+      if (part.n_ghost_indices() != 0 || part.n_import_indices() != 0)
+        {
+          std::vector<ArrayView<Number>> ghost_arrays;
+          for (unsigned int b = 0; b < vec.n_blocks(); ++b)
+            ghost_arrays.emplace_back(
+              const_cast<Number *>(vec.block(b).begin()) +
+                part.locally_owned_size(),
+              matrix_free.get_dof_info(mf_component)
+                .vector_partitioner->n_ghost_indices());
+
+          part.export_to_ghosted_arrays_finish(
+            ghost_arrays,
+            ArrayView<const Number>(
+              tmp_data[component_in_block_vector]->begin(),
+              tmp_data[component_in_block_vector]->size()),
+            this->requests[component_in_block_vector]);
+
+          matrix_free.release_scratch_data_non_threadsafe(
+            tmp_data[component_in_block_vector]);
+          tmp_data[component_in_block_vector] = nullptr;
+        }
+#  else
+      (void)component_in_block_vector;
+#  endif
+
+      // let vector know that ghosts are being updated and we can read from
+      // them
+      for (unsigned int b = 0; b < vec.n_blocks(); ++b)
+        vec.block(b).set_ghost_state(true);
+
+      return true;
+    }
+
+
+
+    /**
+     * Start compress for all blocks of a block vector with a single message
+     * per process, if exchange_blocks_aggregated() allows it, and return
+     * whether this was done.
+     */
+    bool
+    compress_start_aggregated(
+      const unsigned int component_in_block_vector,
+      LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (exchange_blocks_aggregated(vec) == false)
+        return false;
+
+      Assert(vec.has_ghost_elements() == false, ExcNotImplemented());
+
+#  ifdef DEAL_II_WITH_MPI
+      const unsigned int mf_component = find_vector_in_mf(vec.block(0));
+
+      const auto &part = *get_aggregated_partitioner(mf_component);
+
+      if (part.n_ghost_indices() == 0 && part.n_import_indices() == 0)
+        return true;
+
+      std::vector<ArrayView<Number>> ghost_arrays;
+      for (unsigned int b = 0; b < vec.n_blocks(); ++b)
+        ghost_arrays.emplace_back(vec.block(b).begin() +
+                                    part.locally_owned_size(),
+                                  matrix_free.get_dof_info(mf_component)
+                                    .vector_partitioner->n_ghost_indices());
+
+      tmp_data[component_in_block_vector] =
+        matrix_free.acquire_scratch_data_non_threadsafe();
+      tmp_data[component_in_block_vector]->resize_fast(
+        vec.n_blocks() * (part.n_import_indices() + part.n_ghost_indices()));
+      AssertDimension(requests.size(), tmp_data.size());
+
+      part.import_from_ghosted_arrays_start(
+        component_in_block_vector * 2 + channel_shift,
+        ghost_arrays,
+        ArrayView<Number>(tmp_data[component_in_block_vector]->begin(),
+                          tmp_data[component_in_block_vector]->size()),
+        this->requests[component_in_block_vector]);
+#  else
+      (void)component_in_block_vector;
+#  endif
+
+      return true;
+    }
+
+
+
+    /**
+     * Finish compress for block vectors started by
+     * compress_start_aggregated(), and return whether the blocks were
+     * exchanged in aggregated form.
+     */
+    bool
+    compress_finish_aggregated(
+      const unsigned int component_in_block_vector,
+      LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (exchange_blocks_aggregated(vec) == false)
+        return false;
+
+#  ifdef DEAL_II_WITH_MPI
+      AssertIndexRange(component_in_block_vector, tmp_data.size());
+      AssertDimension(requests.size(), tmp_data.size());
+
+      const unsigned int mf_component = find_vector_in_mf(vec.block(0));
+
+      const auto &part = *get_aggregated_partitioner(mf_component);
+
+      if (part.n_ghost_indices() != 0 || part.n_import_indices() != 0)
+        {
+          std::vector<ArrayView<Number>> locally_owned_arrays;
+          std::vector<ArrayView<Number>> ghost_arrays;
+          for (unsigned int b = 0; b < vec.n_blocks(); ++b)
+            {
+              locally_owned_arrays.emplace_back(vec.block(b).begin(),
+                                                part.locally_owned_size());
+              ghost_arrays.emplace_back(
+                vec.block(b).begin() + part.locally_owned_size(),
+                matrix_free.get_dof_info(mf_component)
+                  .vector_partitioner->n_ghost_indices());
+            }
+
+          part.import_from_ghosted_arrays_finish(
+            locally_owned_arrays,
+            ghost_arrays,
+            ArrayView<const Number>(
+              tmp_data[component_in_block_vector]->begin(),
+              tmp_data[component_in_block_vector]->size()),
+            this->requests[component_in_block_vector]);
+
+          matrix_free.release_scratch_data_non_threadsafe(
+            tmp_data[component_in_block_vector]);
+          tmp_data[component_in_block_vector] = nullptr;
+        }
+#  else
+      (void)component_in_block_vector;
+#  endif
+
+      return true;
+    }
+
+
+
     /**
      * Reset all ghost values for serial vectors
      */
@@ -4064,7 +4625,12 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
-    if (get_communication_block_size(vec) < vec.n_blocks())
+    if (exchanger.update_ghost_values_start_aggregated(channel, vec))
+      {
+        // all blocks are sent with a single message per process, independent
+        // of the number of blocks
+      }
+    else if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // don't forget to set ghosts_were_set, that otherwise happens
         // inside VectorDataExchange::update_ghost_values_start()
@@ -4155,7 +4721,11 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
-    if (get_communication_block_size(vec) < vec.n_blocks())
+    if (exchanger.update_ghost_values_finish_aggregated(channel, vec))
+      {
+        // the data of all blocks has been received and unpacked
+      }
+    else if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // do nothing, everything has already been completed in the _start()
         // call
@@ -4242,7 +4812,12 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
-    if (get_communication_block_size(vec) < vec.n_blocks())
+    if (exchanger.compress_start_aggregated(channel, vec))
+      {
+        // all blocks are sent with a single message per process, independent
+        // of the number of blocks
+      }
+    else if (get_communication_block_size(vec) < vec.n_blocks())
       vec.compress(dealii::VectorOperation::add);
     else
       for (unsigned int i = 0; i < vec.n_blocks(); ++i)
@@ -4326,7 +4901,11 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
-    if (get_communication_block_size(vec) < vec.n_blocks())
+    if (exchanger.compress_finish_aggregated(channel, vec))
+      {
+        // the contributions of all blocks have been received and added
+      }
+    else if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // do nothing, everything has already been completed in the _start()
         // call
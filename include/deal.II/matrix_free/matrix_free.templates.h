@@ -462,8 +462,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
 
         // initialize the basic multithreading information that needs to be
         // passed to the DoFInfo structure
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
       if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
+#  ifdef DEAL_II_TBB_WITH_ONEAPI
+          additional_data.tasks_parallel_scheme ==
+            AdditionalData::work_stealing &&
+#  endif
           MultithreadInfo::n_threads() > 1)
         {
           task_info.scheme =
@@ -803,7 +807,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.compute_geometry_on_the_fly);
 
       mapping_is_initialized = true;
     }
@@ -924,7 +929,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_dof_handlers(
 
 namespace internal
 {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
 
 #  ifdef DEAL_II_TBB_WITH_ONEAPI
   struct unsigned_int_pair_hash
@@ -1611,7 +1616,7 @@ namespace internal
         connectivity.reinit(task_info.n_active_cells, task_info.n_active_cells);
         if (do_face_integrals)
           {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
             // step 1: build map between the index in the matrix-free context
             // and the one in the triangulation
             tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,
@@ -1821,7 +1826,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
     additional_data.overlap_communication_computation,
     task_info,
     cell_level_index,
-    dof_info,
+    dof_info.get_vector(),
     face_setup,
     constraint_values,
     additional_data.communicator_sm != MPI_COMM_SELF);
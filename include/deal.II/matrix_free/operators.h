@@ -33,6 +33,10 @@
 
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -314,6 +318,29 @@ namespace MatrixFreeOperators
     void
     vmult(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Matrix-vector multiplication that additionally runs two functions on
+     * ranges of the locally owned entries of the vectors: the first one
+     * before the matrix-vector product touches these entries for the first
+     * time, and the second one after the product (including the treatment of
+     * constrained entries) has touched them for the last time, see
+     * MatrixFree::cell_loop() for the precise guarantees. This allows
+     * iterative methods like PreconditionChebyshev to merge their vector
+     * updates into the cell loop, operating on vector entries that are still
+     * in cache.
+     *
+     * The ranges are given in the MPI-local numbering of the DoFHandler of
+     * the (only) selected block. This function is only implemented for
+     * operators on a single block.
+     */
+    void
+    vmult(VectorType &      dst,
+          const VectorType &src,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_before_matrix_vector_product,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_after_matrix_vector_product) const;
+
     /**
      * Transpose matrix-vector multiplication.
      */
@@ -431,6 +458,26 @@ namespace MatrixFreeOperators
     virtual void
     Tapply_add(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Apply operator to @p src and add result in @p dst, calling
+     * @p operation_before_loop and @p operation_after_loop on ranges of the
+     * locally owned entries as described for MatrixFree::cell_loop().
+     *
+     * The default implementation runs @p operation_before_loop on the whole
+     * locally owned range, then apply_add(), and then
+     * @p operation_after_loop on the whole range. Derived classes that
+     * implement apply_add() by a MatrixFree::cell_loop() should override this
+     * function and pass the two functions on to the loop.
+     */
+    virtual void
+    apply_add_with_pre_post(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const;
+
     /**
      * MatrixFree object to be used with this operator.
      */
@@ -806,6 +853,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but running the given functions on ranges of the
+     * vectors within the cell loop.
+     */
+    virtual void
+    apply_add_with_pre_post(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -956,6 +1016,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but running the given functions on ranges of the
+     * vectors within the cell loop.
+     */
+    virtual void
+    apply_add_with_pre_post(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1404,6 +1477,81 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::vmult(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_matrix_vector_product,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_matrix_vector_product) const
+  {
+    using Number =
+      typename Base<dim, VectorType, VectorizedArrayType>::value_type;
+    AssertDimension(dst.size(), src.size());
+    AssertDimension(BlockHelper::n_blocks(dst), BlockHelper::n_blocks(src));
+    AssertDimension(BlockHelper::n_blocks(dst), selected_rows.size());
+    Assert(BlockHelper::n_blocks(dst) == 1,
+           ExcMessage("This function is only implemented for operators "
+                      "acting on a single block."));
+
+    preprocess_constraints(dst, src);
+
+    auto &      dst_vector = BlockHelper::subblock(dst, 0);
+    const auto &src_vector = BlockHelper::subblock(src, 0);
+    const std::vector<unsigned int> &constrained_dofs =
+      data->get_constrained_dofs(selected_rows[0]);
+    const std::vector<unsigned int> &edge_dofs = edge_constrained_indices[0];
+
+    // the locally owned part of the destination is zeroed in the first of
+    // the two operations below, but the ghost entries that the cell loop
+    // sums into must be zero, too
+    dst_vector.zero_out_ghost_values();
+
+    apply_add_with_pre_post(
+      dst,
+      src,
+      [&](const unsigned int start_range, const unsigned int end_range) {
+        // the product starts from a zero destination vector, so we can set
+        // the entries to zero right before they are first written
+        if (end_range > start_range)
+          std::memset(dst_vector.begin() + start_range,
+                      0,
+                      sizeof(Number) * (end_range - start_range));
+        if (operation_before_matrix_vector_product)
+          operation_before_matrix_vector_product(start_range, end_range);
+      },
+      [&](const unsigned int start_range, const unsigned int end_range) {
+        // same as postprocess_constraints(), restricted to the current range
+        // and for a destination vector that was zero before the product
+        for (auto it = std::lower_bound(constrained_dofs.begin(),
+                                        constrained_dofs.end(),
+                                        start_range);
+             it != constrained_dofs.end() && *it < end_range;
+             ++it)
+          dst_vector.local_element(*it) += src_vector.local_element(*it);
+
+        for (auto it = std::lower_bound(edge_dofs.begin(),
+                                        edge_dofs.end(),
+                                        start_range);
+             it != edge_dofs.end() && *it < end_range;
+             ++it)
+          {
+            const Number value =
+              edge_constrained_values[0][it - edge_dofs.begin()].first;
+            BlockHelper::subblock(const_cast<VectorType &>(src), 0)
+              .local_element(*it)         = value;
+            dst_vector.local_element(*it) = value;
+          }
+
+        if (operation_after_matrix_vector_product)
+          operation_after_matrix_vector_product(start_range, end_range);
+      });
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::vmult_add(
@@ -1708,6 +1856,27 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_add_with_pre_post(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    const unsigned int locally_owned_size =
+      BlockHelper::subblock(dst, 0).locally_owned_size();
+    if (operation_before_loop)
+      operation_before_loop(0U, locally_owned_size);
+    apply_add(dst, src);
+    if (operation_after_loop)
+      operation_after_loop(0U, locally_owned_size);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::Tapply_add(
@@ -2037,6 +2206,39 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+               fe_degree,
+               n_q_points_1d,
+               n_components,
+               VectorType,
+               VectorizedArrayType>::
+    apply_add_with_pre_post(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &MassOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2231,6 +2433,39 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                  fe_degree,
+                  n_q_points_1d,
+                  n_components,
+                  VectorType,
+                  VectorizedArrayType>::
+    apply_add_with_pre_post(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &LaplaceOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
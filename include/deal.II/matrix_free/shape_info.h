@@ -26,6 +26,8 @@
 #include <deal.II/base/table.h>
 #include <deal.II/base/vectorization.h>
 
+#include <array>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -459,6 +461,35 @@ namespace internal
        */
       unsigned int dofs_per_component_on_face;
 
+      /**
+       * For simplex and wedge elements combined with a quadrature formula
+       * whose points form a tensor product in the collapsed coordinates of
+       * the cell, like QStroudSimplex and QStroudWedge, this field stores the
+       * number of points per collapsed coordinate. The gradients are then
+       * computed by sum factorization in the collapsed coordinates with the
+       * matrices in @p shape_gradients_collocation_collapsed. Otherwise, the
+       * value is zero and the gradients are computed with the full matrix in
+       * @p shape_gradients.
+       */
+      unsigned int n_q_points_1d_collapsed;
+
+      /**
+       * The derivatives of the Lagrange polynomials through the quadrature
+       * points in each of the collapsed coordinates, evaluated at these
+       * points. The layout per direction is the same as for
+       * UnivariateShapeData::shape_gradients_collocation.
+       */
+      std::array<AlignedVector<Number>, 3>
+        shape_gradients_collocation_collapsed;
+
+      /**
+       * The transformation from derivatives in the collapsed coordinates to
+       * derivatives in the reference coordinates in each quadrature point,
+       * stored as a lower triangular matrix with @p n_dimensions rows and
+       * columns per point.
+       */
+      AlignedVector<Number> collapsed_coordinate_transformation;
+
       /**
        * For nodal basis functions with nodes located at the boundary of the
        * unit cell, face integrals that involve only the values of the shape
@@ -536,6 +567,31 @@ namespace internal
        */
       dealii::Table<2, unsigned int> face_to_cell_index_hermite;
 
+      /**
+       * For bases that are not nodal at the cell boundaries, e.g. FE_DGQ
+       * with Gauss points or FE_DGQLegendre, all degrees of freedom along a
+       * line in the direction normal to a face contribute to the values and
+       * derivatives on the face. This array stores the lexicographic index
+       * of the first degree of freedom of each such line, i.e., the one with
+       * index zero in the face-normal direction, for each degree of freedom
+       * of the face. The other degrees of freedom of the line follow with
+       * stride <code>(fe_degree+1)^(face_no/2)</code>. This allows to
+       * interpolate to the face directly when reading from the vector,
+       * without first copying all degrees of freedom of the cell.
+       *
+       * The first table index runs through the faces of a cell, and the
+       * second runs through the degrees of freedom of the face, using the
+       * same face-local numbering as @p face_to_cell_index_nodal. For the
+       * example of a 2D element of degree 3 with the numbering shown above,
+       * the first and second row store the indices <code>0, 4, 8,
+       * 12</code> and the third and fourth row store the indices <code>0, 1,
+       * 2, 3</code>.
+       *
+       * @note This object is only filled for element types up to @p
+       * tensor_general.
+       */
+      dealii::Table<2, unsigned int> face_to_cell_index_normal_lines;
+
       /**
        * For unknowns located on faces, the basis functions are not
        * in the correct order if a face is not in the standard orientation
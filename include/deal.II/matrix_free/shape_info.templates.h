@@ -45,6 +45,9 @@
 #include <deal.II/matrix_free/shape_info.h>
 #include <deal.II/matrix_free/util.h>
 
+#include <algorithm>
+#include <array>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -206,6 +209,7 @@ namespace internal
       , dofs_per_component_on_cell(0)
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
+      , n_q_points_1d_collapsed(0)
     {}
 
 
@@ -223,6 +227,7 @@ namespace internal
       , dofs_per_component_on_cell(0)
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
+      , n_q_points_1d_collapsed(0)
     {
       reinit(quad, fe_in, base_element_number);
     }
@@ -238,6 +243,7 @@ namespace internal
     {
       static_assert(dim == spacedim,
                     "Currently, only the case dim=spacedim is implemented");
+      n_q_points_1d_collapsed = 0;
       if (quad_in.is_tensor_product() == false ||
           dynamic_cast<const FE_SimplexP<dim> *>(
             &fe_in.base_element(base_element_number)) ||
@@ -309,9 +315,149 @@ namespace internal
                                   q] = grad[d];
               }
 
-          {
-            const auto reference_cell = fe.reference_cell();
+          // check whether the quadrature points form a tensor product in the
+          // collapsed coordinates of simplex and wedge cells, which are given
+          // by x = a(1-b)(1-c), y = b(1-c), z = c on the tetrahedron, x =
+          // a(1-b), y = b on the triangle, and x = a(1-b), y = b, z = c on
+          // the wedge. In that case, the pullback of the polynomial space of
+          // degree k is contained in the tensor product polynomials of degree
+          // k in the collapsed coordinates, such that the derivatives can be
+          // computed exactly by collocation derivatives along the lines of
+          // points
+          const auto reference_cell = fe.reference_cell();
+          if (dim > 1 && (reference_cell.is_simplex() ||
+                          reference_cell == ReferenceCells::Wedge))
+            {
+              const unsigned int n_collapsed =
+                reference_cell.is_simplex() ? dim : 2;
+              std::vector<std::array<double, 3>> collapsed_points(n_q_points);
+              bool                               is_collapsed = true;
+              std::array<std::vector<double>, dim> points_1d;
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  const Point<dim> &p = quad.point(q);
+                  for (unsigned int d = n_collapsed; d < dim; ++d)
+                    collapsed_points[q][d] = p[d];
+                  double scaling = 1.;
+                  for (int d = n_collapsed - 1; d >= 0; --d)
+                    {
+                      // points at the collapsed vertex cannot be mapped back
+                      if (scaling < 1e-12)
+                        is_collapsed = false;
+                      else
+                        collapsed_points[q][d] = p[d] / scaling;
+                      scaling *= 1. - collapsed_points[q][d];
+                    }
+                  for (unsigned int d = 0; d < dim; ++d)
+                    points_1d[d].push_back(collapsed_points[q][d]);
+                }
+
+              const auto is_equal = [](const double a, const double b) {
+                return std::abs(a - b) < 1e-10;
+              };
+              unsigned int n_points_1d = 0;
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  std::sort(points_1d[d].begin(), points_1d[d].end());
+                  points_1d[d].erase(std::unique(points_1d[d].begin(),
+                                                 points_1d[d].end(),
+                                                 is_equal),
+                                     points_1d[d].end());
+                  if (d == 0)
+                    n_points_1d = points_1d[d].size();
+                  else if (points_1d[d].size() != n_points_1d)
+                    is_collapsed = false;
+                }
+
+              // the points must be numbered lexicographically in the
+              // collapsed coordinates, and there must be enough points per
+              // direction to represent the polynomials exactly
+              if (Utilities::fixed_power<dim>(n_points_1d) != n_q_points ||
+                  n_points_1d < fe.degree + 1)
+                is_collapsed = false;
+              for (unsigned int q = 0; q < n_q_points && is_collapsed; ++q)
+                {
+                  unsigned int index = 0;
+                  for (int d = dim - 1; d >= 0; --d)
+                    {
+                      const auto position =
+                        std::lower_bound(points_1d[d].begin(),
+                                         points_1d[d].end(),
+                                         collapsed_points[q][d] - 1e-10);
+                      if (position == points_1d[d].end() ||
+                          !is_equal(*position, collapsed_points[q][d]))
+                        is_collapsed = false;
+                      index = index * n_points_1d +
+                              (position - points_1d[d].begin());
+                    }
+                  if (index != q)
+                    is_collapsed = false;
+                }
+
+              if (is_collapsed)
+                {
+                  n_q_points_1d_collapsed = n_points_1d;
 
+                  // derivatives of the Lagrange polynomials through the
+                  // points, computed with the barycentric weights
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      const std::vector<double> &x = points_1d[d];
+                      std::vector<double> weights(n_points_1d, 1.);
+                      for (unsigned int j = 0; j < n_points_1d; ++j)
+                        for (unsigned int k = 0; k < n_points_1d; ++k)
+                          if (k != j)
+                            weights[j] /= x[j] - x[k];
+
+                      auto &gradients =
+                        shape_gradients_collocation_collapsed[d];
+                      gradients.resize_fast(n_points_1d * n_points_1d);
+                      for (unsigned int j = 0; j < n_points_1d; ++j)
+                        for (unsigned int i = 0; i < n_points_1d; ++i)
+                          {
+                            double value = 0.;
+                            if (i == j)
+                              for (unsigned int k = 0; k < n_points_1d; ++k)
+                                {
+                                  if (k != i)
+                                    value += 1. / (x[i] - x[k]);
+                                }
+                            else
+                              value = weights[j] / weights[i] / (x[i] - x[j]);
+                            gradients[j * n_points_1d + i] = value;
+                          }
+                    }
+
+                  // chain rule from the collapsed to the reference
+                  // coordinates, derived from the derivatives of the
+                  // collapsed coordinates with respect to x, y, z
+                  collapsed_coordinate_transformation.resize(n_q_points * dim *
+                                                             dim);
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    {
+                      const double a = collapsed_points[q][0];
+                      const double b = collapsed_points[q][1];
+                      const double c =
+                        n_collapsed == 3 ? collapsed_points[q][2] : 0.;
+                      Number *transformation =
+                        collapsed_coordinate_transformation.data() +
+                        q * dim * dim;
+                      transformation[0]       = 1. / ((1. - b) * (1. - c));
+                      transformation[dim]     = a / ((1. - b) * (1. - c));
+                      transformation[dim + 1] = 1. / (1. - c);
+                      if (dim == 3)
+                        {
+                          transformation[2 * dim] =
+                            n_collapsed == 3 ? a / ((1. - b) * (1. - c)) : 0.;
+                          transformation[2 * dim + 1] =
+                            n_collapsed == 3 ? b / (1. - c) : 0.;
+                          transformation[2 * dim + 2] = 1.;
+                        }
+                    }
+                }
+            }
+
+          {
             const auto  temp      = get_face_quadrature_collection(quad, false);
             const auto &quad_face = temp.second;
 
@@ -849,9 +995,37 @@ namespace internal
                       face_to_cell_index_nodal(f, l) = ind;
                     }
             }
+        }
 
-          // face orientation for faces in 3D
-          // (similar to MappingInfoStorage::QuadratureDescriptor::initialize)
+      if (element_type <= tensor_general)
+        {
+          // same numbering as face_to_cell_index_nodal, but always starting
+          // from the layer of degrees of freedom with index zero in the
+          // face-normal direction
+          face_to_cell_index_normal_lines.reinit(
+            GeometryInfo<dim>::faces_per_cell, dofs_per_component_on_face);
+          for (auto f : GeometryInfo<dim>::face_indices())
+            {
+              const unsigned int direction = f / 2;
+              const unsigned int stride =
+                direction < dim - 1 ? (fe_degree + 1) : 1;
+
+              if (direction == 0 || direction == dim - 1)
+                for (unsigned int i = 0; i < dofs_per_component_on_face; ++i)
+                  face_to_cell_index_normal_lines(f, i) = i * stride;
+              else
+                for (unsigned int j = 0; j <= fe_degree; ++j)
+                  for (unsigned int i = 0; i <= fe_degree; ++i)
+                    face_to_cell_index_normal_lines(f,
+                                                    i * (fe_degree + 1) + j) =
+                      j * dofs_per_component_on_face + i;
+            }
+        }
+
+      // face orientation for faces in 3D
+      // (similar to MappingInfoStorage::QuadratureDescriptor::initialize)
+      if (nodal_at_cell_boundaries == true || element_type <= tensor_general)
+        {
           if (dim == 3)
             {
               face_orientations_dofs = compute_orientation_table(fe_degree + 1);
@@ -1167,6 +1341,10 @@ namespace internal
       std::size_t memory = sizeof(*this);
       for (const auto &univariate_shape_data : data)
         memory += univariate_shape_data.memory_consumption();
+      for (const auto &matrix : shape_gradients_collocation_collapsed)
+        memory += MemoryConsumption::memory_consumption(matrix);
+      memory += MemoryConsumption::memory_consumption(
+        collapsed_coordinate_transformation);
       return memory;
     }
 
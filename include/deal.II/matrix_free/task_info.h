@@ -30,6 +30,7 @@
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -108,13 +109,15 @@ namespace internal
       // enum for choice of how to build the task graph. Odd add versions with
       // preblocking and even versions with postblocking. partition_partition
       // and partition_color are deprecated but kept for backward
-      // compatibility.
+      // compatibility. work_stealing uses the partitions of
+      // partition_partition but schedules the chunks dynamically.
       enum TasksParallelScheme
       {
         none,
         partition_partition,
         partition_color,
-        color
+        color,
+        work_stealing
       };
 
       /**
@@ -405,6 +408,35 @@ namespace internal
       void
       update_task_info(const unsigned int partition);
 
+      /**
+       * Set up the task graph for the work_stealing scheme from the two-level
+       * partitioning in @p partition_row_index, filling the fields
+       * @p task_n_predecessors, @p task_successor_row_index,
+       * @p task_successors and @p task_topological_order. The tasks
+       * 0,...,n_chunks-1 are the chunks of cells (and faces) described by
+       * @p cell_partition_data, except for the ghost cells at the end, where
+       * n_chunks is the last entry of @p partition_row_index. They are
+       * followed by one task per partition that completes once all chunks of
+       * that partition are done, one task for finishing the ghost value
+       * update and one task for starting the compress operation.
+       */
+      void
+      setup_work_stealing_graph();
+
+      /**
+       * Recompute @p task_priorities as the length of the longest path from
+       * each task to the end of the task graph, using the time spent in the
+       * tasks stored in @p task_times.
+       */
+      void
+      update_task_priorities() const;
+
+      /**
+       * Return the current @p task_priorities for use in one loop.
+       */
+      std::shared_ptr<const std::vector<double>>
+      get_task_priorities() const;
+
       /**
        * Creates a task graph from a connectivity structure.
        */
@@ -598,6 +630,61 @@ namespace internal
        */
       unsigned int n_workers;
 
+      /**
+       * For the work_stealing scheme: The number of tasks that need to be
+       * completed before a task can be started.
+       */
+      std::vector<unsigned int> task_n_predecessors;
+
+      /**
+       * For the work_stealing scheme: The start of the list of successors of
+       * each task within @p task_successors.
+       */
+      std::vector<unsigned int> task_successor_row_index;
+
+      /**
+       * For the work_stealing scheme: The tasks that depend on a task, in a
+       * compressed row storage indexed by @p task_successor_row_index.
+       */
+      std::vector<unsigned int> task_successors;
+
+      /**
+       * For the work_stealing scheme: All tasks in an order where each task
+       * appears after its predecessors.
+       */
+      std::vector<unsigned int> task_topological_order;
+
+      /**
+       * For the work_stealing scheme: The time in seconds spent in each task
+       * during the most recent loop. Before the first loop, this field holds
+       * an estimate from the number of cell batches in a chunk.
+       */
+      mutable std::vector<double> task_times;
+
+      /**
+       * For the work_stealing scheme: The priority of each task, given by the
+       * length of the longest path through the task graph starting at the
+       * task as measured with @p task_times. Ready tasks with higher priority
+       * are started first, which re-balances the work on subsequent loops.
+       *
+       * Each loop works on the priorities it obtains at its start. Updated
+       * priorities are stored in a new vector that replaces this pointer, so
+       * loops running concurrently never see a vector that is being
+       * written to.
+       */
+      mutable std::shared_ptr<const std::vector<double>> task_priorities;
+
+      /**
+       * Mutex to make sure that only one loop at a time records the times in
+       * @p task_times in case several loops run concurrently.
+       */
+      mutable Threads::Mutex task_times_mutex;
+
+      /**
+       * Mutex to protect the exchange of the pointer @p task_priorities.
+       */
+      mutable Threads::Mutex task_priorities_mutex;
+
       /**
        * Stores whether a particular task is at an MPI boundary and needs data
        * exchange
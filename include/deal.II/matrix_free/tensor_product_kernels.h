@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/ndarray.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/utilities.h>
 
@@ -1949,6 +1950,368 @@ namespace internal
 
 
 
+  /**
+   * Internal evaluator for shape function using the tensor product form
+   * of the basis functions with the even-odd decomposition. The same as the
+   * other templated class but without making use of template arguments and
+   * variable loop bounds instead. This makes the reduction of the arithmetic
+   * work to roughly half of the general kernel available to the evaluation
+   * with a polynomial degree or a number of quadrature points only known at
+   * run time, such as over-integration with a number of points that is not
+   * pre-compiled.
+   *
+   * For a 1D matrix with $m$ columns (input entries) and $n$ rows (output
+   * entries), the general kernel spends $n(2m-1)$ floating point operations
+   * per line. The even-odd kernel first forms the $\lfloor m/2 \rfloor$
+   * sums and differences of the input, then multiplies them with two
+   * matrices of size roughly $n/2 \times m/2$ and combines the results, which
+   * gives $m n + m$ operations for even $m$ and $n$. For values on a 3D cell
+   * with degree $k$ and $n_q$ points per direction, this is e.g. 1344 versus
+   * 960 operations for $k=3, n_q=4$, 4914 versus 3094 for $k=4, n_q=6$, and
+   * 46070 versus 26558 for $k=8, n_q=10$, approaching a factor of two for
+   * high degrees.
+   *
+   * The decomposition requires the symmetry $S_{n-1-i,m-1-j} = \pm S_{i,j}$
+   * of the 1D shape matrix, i.e., basis functions and quadrature points
+   * that are symmetric about the midpoint of the interval. This is what the
+   * element type ElementType::tensor_symmetric describes. For other bases,
+   * the folded entries $x_j \pm x_{m-1-j}$ do not determine the result, so
+   * these elements must use the general kernel. The same holds for the
+   * interpolation to a single face, where the matrix has only one or two
+   * rows (value and derivative at one end point) and no mirror image.
+   *
+   * @tparam dim Space dimension in which this class is applied
+   * @tparam Number Abstract number type for input and output arrays
+   * @tparam Number2 Abstract number type for coefficient arrays (defaults to
+   *                 same type as the input/output arrays); must implement
+   *                 operator* with Number and produce Number as an output to
+   *                 be a valid type
+   */
+  template <int dim, typename Number, typename Number2>
+  struct EvaluatorTensorProduct<evaluate_evenodd, dim, 0, 0, Number, Number2>
+  {
+    static constexpr unsigned int n_rows_of_product =
+      numbers::invalid_unsigned_int;
+    static constexpr unsigned int n_columns_of_product =
+      numbers::invalid_unsigned_int;
+
+    /**
+     * Empty constructor. Does nothing. Be careful when using 'values' and
+     * related methods because they need to be filled with the other
+     * constructor.
+     */
+    EvaluatorTensorProduct()
+      : shape_values(nullptr)
+      , shape_gradients(nullptr)
+      , shape_hessians(nullptr)
+      , n_rows(numbers::invalid_unsigned_int)
+      , n_columns(numbers::invalid_unsigned_int)
+    {}
+
+    /**
+     * Constructor, taking the data from ShapeInfo (using the even-odd
+     * variants stored there). The sizes have default arguments to be
+     * compatible with the constructor of the templated class, but must be
+     * set for the apply functions to be usable.
+     */
+    EvaluatorTensorProduct(
+      const AlignedVector<Number2> &shape_values,
+      const AlignedVector<Number2> &shape_gradients,
+      const AlignedVector<Number2> &shape_hessians,
+      const unsigned int            n_rows    = numbers::invalid_unsigned_int,
+      const unsigned int            n_columns = numbers::invalid_unsigned_int)
+      : shape_values(shape_values.begin())
+      , shape_gradients(shape_gradients.begin())
+      , shape_hessians(shape_hessians.begin())
+      , n_rows(n_rows)
+      , n_columns(n_columns)
+    {
+      // In this function, we allow for dummy pointers if some of values,
+      // gradients or hessians should not be computed
+      if (n_rows != numbers::invalid_unsigned_int &&
+          n_columns != numbers::invalid_unsigned_int)
+        {
+          if (!shape_values.empty())
+            AssertDimension(shape_values.size(),
+                            n_rows * ((n_columns + 1) / 2));
+          if (!shape_gradients.empty())
+            AssertDimension(shape_gradients.size(),
+                            n_rows * ((n_columns + 1) / 2));
+          if (!shape_hessians.empty())
+            AssertDimension(shape_hessians.size(),
+                            n_rows * ((n_columns + 1) / 2));
+        }
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    values(const Number in[], Number out[]) const
+    {
+      Assert(shape_values != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 0>(shape_values, in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    gradients(const Number in[], Number out[]) const
+    {
+      Assert(shape_gradients != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 1>(shape_gradients, in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    hessians(const Number in[], Number out[]) const
+    {
+      Assert(shape_hessians != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 2>(shape_hessians, in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    values_one_line(const Number in[], Number out[]) const
+    {
+      Assert(shape_values != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 0, true>(shape_values, in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    gradients_one_line(const Number in[], Number out[]) const
+    {
+      Assert(shape_gradients != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 1, true>(shape_gradients,
+                                                         in,
+                                                         out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    hessians_one_line(const Number in[], Number out[]) const
+    {
+      Assert(shape_hessians != nullptr, ExcNotInitialized());
+      apply<direction, contract_over_rows, add, 2, true>(shape_hessians,
+                                                         in,
+                                                         out);
+    }
+
+    /**
+     * This function applies the tensor product kernel along the given
+     * @p direction of the tensor data in the input array, see the
+     * documentation of the templated class for the meaning of the template
+     * arguments.
+     */
+    template <int  direction,
+              bool contract_over_rows,
+              bool add,
+              int  type,
+              bool one_line = false>
+    void
+    apply(const Number2 *DEAL_II_RESTRICT shape_data,
+          const Number *                  in,
+          Number *                        out) const;
+
+    const Number2 *    shape_values;
+    const Number2 *    shape_gradients;
+    const Number2 *    shape_hessians;
+    const unsigned int n_rows;
+    const unsigned int n_columns;
+  };
+
+
+
+  template <int dim, typename Number, typename Number2>
+  template <int  direction,
+            bool contract_over_rows,
+            bool add,
+            int  type,
+            bool one_line>
+  inline void
+  EvaluatorTensorProduct<evaluate_evenodd, dim, 0, 0, Number, Number2>::apply(
+    const Number2 *DEAL_II_RESTRICT shapes,
+    const Number *                  in,
+    Number *                        out) const
+  {
+    static_assert(type < 3, "Only three variants type=0,1,2 implemented");
+    static_assert(one_line == false || direction == dim - 1,
+                  "Single-line evaluation only works for direction=dim-1.");
+    Assert(n_rows != numbers::invalid_unsigned_int &&
+             n_columns != numbers::invalid_unsigned_int,
+           ExcMessage("The sizes of the evaluator have not been set"));
+    Assert(dim == direction + 1 || one_line == true || n_rows == n_columns ||
+             in != out,
+           ExcMessage("In-place operation only supported for "
+                      "n_rows==n_columns or single-line interpolation"));
+    AssertIndexRange(direction, dim);
+    Assert(n_rows <= 128 && n_columns <= 128, ExcNotImplemented());
+
+    const int nn     = contract_over_rows ? n_columns : n_rows;
+    const int mm     = contract_over_rows ? n_rows : n_columns;
+    const int n_cols = nn / 2;
+    const int mid    = mm / 2;
+
+    const int stride =
+      direction == 0 ? 1 : Utilities::fixed_power<direction>(n_columns);
+    const int n_blocks1 = one_line ? 1 : stride;
+    const int n_blocks2 = direction >= dim - 1 ?
+                            1 :
+                            Utilities::fixed_power<dim - direction - 1>(n_rows);
+
+    const int offset = (n_columns + 1) / 2;
+
+    // same structure as the templated kernel above, with all conditionals
+    // on the sizes evaluated at run time
+    for (int i2 = 0; i2 < n_blocks2; ++i2)
+      {
+        for (int i1 = 0; i1 < n_blocks1; ++i1)
+          {
+            Number xp[64], xm[64];
+            for (int i = 0; i < mid; ++i)
+              {
+                if (contract_over_rows == true && type == 1)
+                  {
+                    xp[i] = in[stride * i] - in[stride * (mm - 1 - i)];
+                    xm[i] = in[stride * i] + in[stride * (mm - 1 - i)];
+                  }
+                else
+                  {
+                    xp[i] = in[stride * i] + in[stride * (mm - 1 - i)];
+                    xm[i] = in[stride * i] - in[stride * (mm - 1 - i)];
+                  }
+              }
+            Number xmid = in[stride * mid];
+            for (int col = 0; col < n_cols; ++col)
+              {
+                Number r0, r1;
+                if (mid > 0)
+                  {
+                    if (contract_over_rows == true)
+                      {
+                        r0 = shapes[col] * xp[0];
+                        r1 = shapes[(n_rows - 1) * offset + col] * xm[0];
+                      }
+                    else
+                      {
+                        r0 = shapes[col * offset] * xp[0];
+                        r1 = shapes[(n_rows - 1 - col) * offset] * xm[0];
+                      }
+                    for (int ind = 1; ind < mid; ++ind)
+                      {
+                        if (contract_over_rows == true)
+                          {
+                            r0 += shapes[ind * offset + col] * xp[ind];
+                            r1 += shapes[(n_rows - 1 - ind) * offset + col] *
+                                  xm[ind];
+                          }
+                        else
+                          {
+                            r0 += shapes[col * offset + ind] * xp[ind];
+                            r1 += shapes[(n_rows - 1 - col) * offset + ind] *
+                                  xm[ind];
+                          }
+                      }
+                  }
+                else
+                  r0 = r1 = Number();
+                if (mm % 2 == 1 && contract_over_rows == true)
+                  {
+                    if (type == 1)
+                      r1 += shapes[mid * offset + col] * xmid;
+                    else
+                      r0 += shapes[mid * offset + col] * xmid;
+                  }
+                else if (mm % 2 == 1 && (nn % 2 == 0 || type > 0 || mm == 3))
+                  r0 += shapes[col * offset + mid] * xmid;
+
+                if (add)
+                  {
+                    out[stride * col] += r0 + r1;
+                    if (type == 1 && contract_over_rows == false)
+                      out[stride * (nn - 1 - col)] += r1 - r0;
+                    else
+                      out[stride * (nn - 1 - col)] += r0 - r1;
+                  }
+                else
+                  {
+                    out[stride * col] = r0 + r1;
+                    if (type == 1 && contract_over_rows == false)
+                      out[stride * (nn - 1 - col)] = r1 - r0;
+                    else
+                      out[stride * (nn - 1 - col)] = r0 - r1;
+                  }
+              }
+            if (type == 0 && contract_over_rows == true && nn % 2 == 1 &&
+                mm % 2 == 1 && mm > 3)
+              {
+                if (add)
+                  out[stride * n_cols] += shapes[mid * offset + n_cols] * xmid;
+                else
+                  out[stride * n_cols] = shapes[mid * offset + n_cols] * xmid;
+              }
+            else if (contract_over_rows == true && nn % 2 == 1)
+              {
+                Number r0;
+                if (mid > 0)
+                  {
+                    r0 = shapes[n_cols] * xp[0];
+                    for (int ind = 1; ind < mid; ++ind)
+                      r0 += shapes[ind * offset + n_cols] * xp[ind];
+                  }
+                else
+                  r0 = Number();
+                if (type != 1 && mm % 2 == 1)
+                  r0 += shapes[mid * offset + n_cols] * xmid;
+
+                if (add)
+                  out[stride * n_cols] += r0;
+                else
+                  out[stride * n_cols] = r0;
+              }
+            else if (contract_over_rows == false && nn % 2 == 1)
+              {
+                Number r0;
+                if (mid > 0)
+                  {
+                    if (type == 1)
+                      {
+                        r0 = shapes[n_cols * offset] * xm[0];
+                        for (int ind = 1; ind < mid; ++ind)
+                          r0 += shapes[n_cols * offset + ind] * xm[ind];
+                      }
+                    else
+                      {
+                        r0 = shapes[n_cols * offset] * xp[0];
+                        for (int ind = 1; ind < mid; ++ind)
+                          r0 += shapes[n_cols * offset + ind] * xp[ind];
+                      }
+                  }
+                else
+                  r0 = Number();
+
+                if ((type == 0 || type == 2) && mm % 2 == 1)
+                  r0 += shapes[n_cols * offset + mid] * xmid;
+
+                if (add)
+                  out[stride * n_cols] += r0;
+                else
+                  out[stride * n_cols] = r0;
+              }
+            if (one_line == false)
+              {
+                in += 1;
+                out += 1;
+              }
+          }
+        if (one_line == false)
+          {
+            in += stride * (mm - 1);
+            out += stride * (nn - 1);
+          }
+      }
+  }
+
+
+
   /**
    * Internal evaluator for 1d-3d shape function using the tensor product form
    * of the basis functions.
@@ -2348,6 +2711,130 @@ namespace internal
 
 
 
+  /**
+   * Compute the values and first derivatives of the one-dimensional
+   * polynomials @p poly in all coordinate directions of the point @p p, as
+   * needed by evaluate_tensor_product_value_and_gradient_shapes() and
+   * integrate_add_tensor_product_value_and_gradient_shapes(). The entry
+   * `shapes[i][0][d]` holds the value and `shapes[i][1][d]` the derivative of
+   * the polynomial `i` in the direction `d`. The array @p shapes must have
+   * space for `poly.size()` entries.
+   */
+  template <int dim, typename Number>
+  inline void
+  compute_values_of_array(
+    dealii::ndarray<Number, 2, dim> *                   shapes,
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const Point<dim, Number> &                          p)
+  {
+    std::array<Number, 2> values;
+    for (unsigned int i = 0; i < poly.size(); ++i)
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          poly[i].value(p[d], 1, values.data());
+          shapes[i][0][d] = values[0];
+          shapes[i][1][d] = values[1];
+        }
+  }
+
+
+
+  /**
+   * Same as evaluate_tensor_product_value_and_gradient(), but with the
+   * values and derivatives of the one-dimensional polynomials at the point
+   * already computed by compute_values_of_array(). This allows to re-use the
+   * (relatively expensive) polynomial evaluation when the same points are
+   * visited several times.
+   *
+   * @param shapes The values and derivatives of the 1D polynomials as filled
+   * by compute_values_of_array().
+   *
+   * @param n_shapes The number of 1D polynomials.
+   *
+   * @param values The expansion coefficients $u_i$ in the polynomial
+   * interpolation.
+   *
+   * @param renumber Optional parameter to specify a renumbering in the
+   * coefficient vector, see evaluate_tensor_product_value_and_gradient().
+   */
+  template <int dim, typename Number, typename Number2>
+  inline std::pair<
+    typename ProductTypeNoPoint<Number, Number2>::type,
+    Tensor<1, dim, typename ProductTypeNoPoint<Number, Number2>::type>>
+  evaluate_tensor_product_value_and_gradient_shapes(
+    const dealii::ndarray<Number2, 2, dim> *shapes,
+    const int                               n_shapes,
+    const std::vector<Number> &             values,
+    const std::vector<unsigned int> &       renumber = {})
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    using Number3 = typename ProductTypeNoPoint<Number, Number2>::type;
+
+    AssertDimension(Utilities::pow(n_shapes, dim), values.size());
+    Assert(renumber.empty() || renumber.size() == values.size(),
+           ExcDimensionMismatch(renumber.size(), values.size()));
+
+    // Go through the tensor product of shape functions and interpolate
+    // with optimal algorithm
+    std::pair<Number3, Tensor<1, dim, Number3>> result = {};
+    for (int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        Number3 value_y = {}, deriv_x = {}, deriv_y = {};
+        for (int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            // Interpolation + derivative x direction
+            Number3 value = {}, deriv = {};
+
+            // Distinguish the inner loop based on whether we have a
+            // renumbering or not
+            if (renumber.empty())
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                {
+                  value += shapes[i0][0][0] * values[i];
+                  deriv += shapes[i0][1][0] * values[i];
+                }
+            else
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                {
+                  value += shapes[i0][0][0] * values[renumber[i]];
+                  deriv += shapes[i0][1][0] * values[renumber[i]];
+                }
+
+            // Interpolation + derivative in y direction
+            if (dim > 1)
+              {
+                value_y += value * shapes[i1][0][1];
+                deriv_x += deriv * shapes[i1][0][1];
+                deriv_y += value * shapes[i1][1][1];
+              }
+            else
+              {
+                result.first     = value;
+                result.second[0] = deriv;
+              }
+          }
+        if (dim == 3)
+          {
+            // Interpolation + derivative in z direction
+            result.first += value_y * shapes[i2][0][2];
+            result.second[0] += deriv_x * shapes[i2][0][2];
+            result.second[1] += deriv_y * shapes[i2][0][2];
+            result.second[2] += value_y * shapes[i2][1][2];
+          }
+        else if (dim == 2)
+          {
+            result.first     = value_y;
+            result.second[0] = deriv_x;
+            result.second[1] = deriv_y;
+          }
+      }
+
+    return result;
+  }
+
+
+
   /**
    * Compute the polynomial interpolation of a tensor product shape function
    * $\varphi_i$ given a vector of coefficients $u_i$ in the form
@@ -2456,69 +2943,15 @@ namespace internal
       }
 
     AssertIndexRange(n_shapes, 200);
-    std::array<Number2, 2 * dim * 200> shapes;
+    dealii::ndarray<Number2, 200, 2, dim> shapes;
 
     // Evaluate 1D polynomials and their derivatives
-    for (unsigned int d = 0; d < dim; ++d)
-      for (int i = 0; i < n_shapes; ++i)
-        poly[i].value(p[d], 1, shapes.data() + 2 * (d * n_shapes + i));
+    compute_values_of_array(shapes.data(), poly, p);
 
-    // Go through the tensor product of shape functions and interpolate
-    // with optimal algorithm
-    std::pair<Number3, Tensor<1, dim, Number3>> result = {};
-    for (int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
-      {
-        Number3 value_y = {}, deriv_x = {}, deriv_y = {};
-        for (int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
-          {
-            // Interpolation + derivative x direction
-            Number3 value = {}, deriv = {};
-
-            // Distinguish the inner loop based on whether we have a
-            // renumbering or not
-            if (renumber.empty())
-              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
-                {
-                  value += shapes[2 * i0] * values[i];
-                  deriv += shapes[2 * i0 + 1] * values[i];
-                }
-            else
-              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
-                {
-                  value += shapes[2 * i0] * values[renumber[i]];
-                  deriv += shapes[2 * i0 + 1] * values[renumber[i]];
-                }
-
-            // Interpolation + derivative in y direction
-            if (dim > 1)
-              {
-                value_y += value * shapes[2 * n_shapes + 2 * i1];
-                deriv_x += deriv * shapes[2 * n_shapes + 2 * i1];
-                deriv_y += value * shapes[2 * n_shapes + 2 * i1 + 1];
-              }
-            else
-              {
-                result.first     = value;
-                result.second[0] = deriv;
-              }
-          }
-        if (dim == 3)
-          {
-            // Interpolation + derivative in z direction
-            result.first += value_y * shapes[4 * n_shapes + 2 * i2];
-            result.second[0] += deriv_x * shapes[4 * n_shapes + 2 * i2];
-            result.second[1] += deriv_y * shapes[4 * n_shapes + 2 * i2];
-            result.second[2] += value_y * shapes[4 * n_shapes + 2 * i2 + 1];
-          }
-        else if (dim == 2)
-          {
-            result.first     = value_y;
-            result.second[0] = deriv_x;
-            result.second[1] = deriv_y;
-          }
-      }
-
-    return result;
+    return evaluate_tensor_product_value_and_gradient_shapes<dim,
+                                                             Number,
+                                                             Number2>(
+      shapes.data(), n_shapes, values, renumber);
   }
 
 
@@ -2623,68 +3056,96 @@ namespace internal
 
 
   /**
-   * Same as evaluate_tensor_product_value_and_gradient() but for integration.
+   * Same as integrate_add_tensor_product_value_and_gradient(), but with the
+   * values and derivatives of the one-dimensional polynomials at the point
+   * already computed by compute_values_of_array().
    */
   template <int dim, typename Number, typename Number2>
   inline void
-  integrate_add_tensor_product_value_and_gradient(
-    const std::vector<Polynomials::Polynomial<double>> &poly,
-    const Number2 &                                     value,
-    const Tensor<1, dim, Number2> &                     gradient,
-    const Point<dim, Number> &                          p,
-    AlignedVector<Number2> &                            values,
-    const std::vector<unsigned int> &                   renumber = {})
+  integrate_add_tensor_product_value_and_gradient_shapes(
+    const dealii::ndarray<Number, 2, dim> *shapes,
+    const int                              n_shapes,
+    const Number2 &                        value,
+    const Tensor<1, dim, Number2> &        gradient,
+    AlignedVector<Number2> &               values,
+    const std::vector<unsigned int> &      renumber = {})
   {
     static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
 
-    // as in evaluate, use `int` type to produce better code in this context
-    const int n_shapes = poly.size();
     AssertDimension(Utilities::pow(n_shapes, dim), values.size());
     Assert(renumber.empty() || renumber.size() == values.size(),
            ExcDimensionMismatch(renumber.size(), values.size()));
 
-    AssertIndexRange(n_shapes, 200);
-    std::array<Number, 2 * dim * 200> shapes;
-
-    // Evaluate 1D polynomials and their derivatives
-    for (unsigned int d = 0; d < dim; ++d)
-      for (int i = 0; i < n_shapes; ++i)
-        poly[i].value(p[d], 1, shapes.data() + 2 * (d * n_shapes + i));
-
-    // Implement the transpose of the function above
+    // Implement the transpose of
+    // evaluate_tensor_product_value_and_gradient_shapes()
     for (int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
       {
         const Number2 test_value_z =
-          dim > 2 ? (value * shapes[4 * n_shapes + 2 * i2] +
-                     gradient[2] * shapes[4 * n_shapes + 2 * i2 + 1]) :
-                    value;
+          dim > 2 ?
+            (value * shapes[i2][0][2] + gradient[2] * shapes[i2][1][2]) :
+            value;
         const Number2 test_grad_x =
-          dim > 2 ? gradient[0] * shapes[4 * n_shapes + 2 * i2] : gradient[0];
+          dim > 2 ? gradient[0] * shapes[i2][0][2] : gradient[0];
         const Number2 test_grad_y =
-          dim > 2 ? gradient[1] * shapes[4 * n_shapes + 2 * i2] :
+          dim > 2 ? gradient[1] * shapes[i2][0][2] :
                     (dim > 1 ? gradient[1] : Number2());
         for (int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
           {
             const Number2 test_value_y =
-              dim > 1 ? (test_value_z * shapes[2 * n_shapes + 2 * i1] +
-                         test_grad_y * shapes[2 * n_shapes + 2 * i1 + 1]) :
+              dim > 1 ? (test_value_z * shapes[i1][0][1] +
+                         test_grad_y * shapes[i1][1][1]) :
                         test_value_z;
             const Number2 test_grad_xy =
-              dim > 1 ? test_grad_x * shapes[2 * n_shapes + 2 * i1] :
-                        test_grad_x;
+              dim > 1 ? test_grad_x * shapes[i1][0][1] : test_grad_x;
             if (renumber.empty())
               for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
-                values[i] += shapes[2 * i0] * test_value_y +
-                             shapes[2 * i0 + 1] * test_grad_xy;
+                values[i] += shapes[i0][0][0] * test_value_y +
+                             shapes[i0][1][0] * test_grad_xy;
             else
               for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
-                values[renumber[i]] += shapes[2 * i0] * test_value_y +
-                                       shapes[2 * i0 + 1] * test_grad_xy;
+                values[renumber[i]] += shapes[i0][0][0] * test_value_y +
+                                       shapes[i0][1][0] * test_grad_xy;
           }
       }
   }
 
 
+
+  /**
+   * Same as evaluate_tensor_product_value_and_gradient() but for integration.
+   */
+  template <int dim, typename Number, typename Number2>
+  inline void
+  integrate_add_tensor_product_value_and_gradient(
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const Number2 &                                     value,
+    const Tensor<1, dim, Number2> &                     gradient,
+    const Point<dim, Number> &                          p,
+    AlignedVector<Number2> &                            values,
+    const std::vector<unsigned int> &                   renumber = {})
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    // as in evaluate, use `int` type to produce better code in this context
+    const int n_shapes = poly.size();
+    AssertDimension(Utilities::pow(n_shapes, dim), values.size());
+    Assert(renumber.empty() || renumber.size() == values.size(),
+           ExcDimensionMismatch(renumber.size(), values.size()));
+
+    AssertIndexRange(n_shapes, 200);
+    dealii::ndarray<Number, 200, 2, dim> shapes;
+
+    // Evaluate 1D polynomials and their derivatives
+    compute_values_of_array(shapes.data(), poly, p);
+
+    integrate_add_tensor_product_value_and_gradient_shapes<dim,
+                                                           Number,
+                                                           Number2>(
+      shapes.data(), n_shapes, value, gradient, values, renumber);
+  }
+
+
+
   template <int dim, int loop_length_template, typename Number>
   inline void
   weight_fe_q_dofs_by_entity(const VectorizedArray<Number> *weights,
@@ -98,6 +98,104 @@ namespace MatrixFreeTools
     const unsigned int quad_no                  = 0,
     const unsigned int first_selected_component = 0);
 
+  /**
+   * Compute the diagonal of a linear operator (@p diagonal_global) whose
+   * cell integral is of the form
+   * @f[
+   *   a_K(u, v) = \int_K \left(\mu\, u\, v + \nabla v \cdot \mathbf{D}\,
+   *   \nabla u \right) \mathrm{d}x,
+   * @f]
+   * i.e., a mass matrix, a Laplacian, or a combination of the two with
+   * variable coefficients. The scalar coefficient $\mu$ and the (not
+   * necessarily symmetric) tensor $\mathbf{D}$ are provided by the function
+   * @p coefficients, which is called for each quadrature point with the
+   * FEEvaluation object initialized on the current cell batch (to query
+   * e.g. FEEvaluation::quadrature_point()), the index of the quadrature
+   * point, and the two coefficients, which are zero on entry.
+   *
+   * As opposed to compute_diagonal(), which applies the cell operation to
+   * each unit vector at a cost of $\mathcal O(k^{2d+1})$ per cell for
+   * polynomial degree $k$, this function computes the diagonal by sum
+   * factorization with the products of the one-dimensional shape functions
+   * and their derivatives at a cost of $\mathcal O(k^{d+1})$ per cell. On
+   * cell batches with constrained degrees of freedom, e.g. from hanging nodes
+   * or Dirichlet boundary conditions, and for elements without
+   * tensor-product structure, the algorithm of compute_diagonal() is used,
+   * such that the result is the same as the one of compute_diagonal() for
+   * the same operator.
+   *
+   * The parameters @p dof_no, @p quad_no, and @p first_selected_component are
+   * passed to the constructor of the FEEvaluation that is internally set up.
+   * Only scalar operators are supported; for vector-valued problems where
+   * each component is described by the same operator, call this function
+   * for each component.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  compute_diagonal_sum_factorized(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    VectorType &                                        diagonal_global,
+    const std::function<void(const FEEvaluation<dim,
+                                                fe_degree,
+                                                n_q_points_1d,
+                                                1,
+                                                Number,
+                                                VectorizedArrayType> &,
+                             const unsigned int,
+                             VectorizedArrayType &,
+                             Tensor<2, dim, VectorizedArrayType> &)>
+      &                coefficients,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the inverses of the cell matrices of the operator described in
+   * compute_diagonal_sum_factorized() for all cell batches of @p matrix_free,
+   * as needed by element-wise (block-)Jacobi smoothers, e.g. for
+   * discontinuous Galerkin methods. The cell matrices are assembled column
+   * by column with sum factorization at a cost of $\mathcal O(k^{2d+1})$ per
+   * cell, without running through the coefficient function and the
+   * geometry for each column, and then inverted for each lane.
+   *
+   * On exit, @p inverse_blocks holds `n_cell_batches() * dofs_per_cell *
+   * dofs_per_cell` entries, with the inverse of cell batch `cell` starting at
+   * `cell * dofs_per_cell * dofs_per_cell` and stored row by row in the
+   * numbering of FEEvaluation::begin_dof_values(). Hence, the inverse block
+   * is applied by FEEvaluation::read_dof_values(), a dense matrix-vector
+   * product on the values of FEEvaluation::begin_dof_values(), and
+   * FEEvaluation::distribute_local_to_global(). Constraints are not applied
+   * to the cell matrices, and the unused lanes of the last cell batch are
+   * filled with the identity matrix.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  compute_inverse_cell_blocks_sum_factorized(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    AlignedVector<VectorizedArrayType> &                inverse_blocks,
+    const std::function<void(const FEEvaluation<dim,
+                                                fe_degree,
+                                                n_q_points_1d,
+                                                1,
+                                                Number,
+                                                VectorizedArrayType> &,
+                             const unsigned int,
+                             VectorizedArrayType &,
+                             Tensor<2, dim, VectorizedArrayType> &)>
+      &                coefficients,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
 
   /**
    * Compute the matrix representation of a linear operator (@p matrix), given
@@ -942,6 +1040,566 @@ namespace MatrixFreeTools
       first_selected_component);
   }
 
+  namespace internal
+  {
+    /**
+     * Helper class for compute_diagonal_sum_factorized() and
+     * compute_inverse_cell_blocks_sum_factorized(): It evaluates the
+     * coefficients of the operator at the quadrature points of a cell batch,
+     * transforms them to the reference cell, and contracts them with the
+     * products of the one-dimensional shape functions and their derivatives.
+     */
+    template <int dim,
+              int fe_degree,
+              int n_q_points_1d,
+              typename Number,
+              typename VectorizedArrayType>
+    class SumFactorizedOperatorHelper
+    {
+    public:
+      using FEEvalType = FEEvaluation<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      1,
+                                      Number,
+                                      VectorizedArrayType>;
+
+      using CoefficientFunction =
+        std::function<void(const FEEvalType &,
+                           const unsigned int,
+                           VectorizedArrayType &,
+                           Tensor<2, dim, VectorizedArrayType> &)>;
+
+      SumFactorizedOperatorHelper(FEEvalType &               phi,
+                                  const CoefficientFunction &coefficients)
+        : phi(phi)
+        , coefficients(coefficients)
+        , n_q_points_1d_runtime(phi.get_shape_info().data.front().n_q_points_1d)
+        , n_dofs_1d(phi.get_shape_info().data.front().shape_values.size() /
+                    n_q_points_1d_runtime)
+        , is_tensor_product(
+            phi.get_shape_info().element_type <=
+            dealii::internal::MatrixFreeFunctions::tensor_general)
+      {
+        mass_coefficients.resize(phi.n_q_points);
+        diffusion_coefficients.resize(phi.n_q_points);
+        reference_coefficients.resize((1 + dim * dim) * phi.n_q_points);
+        const unsigned int n_entries =
+          Utilities::pow(std::max(n_dofs_1d, n_q_points_1d_runtime), dim);
+        scratch.resize(n_entries);
+        scratch_2.resize(n_entries);
+
+        if (is_tensor_product)
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const auto &data = phi.get_shape_info().get_shape_data(d, 0);
+              AssertDimension(data.shape_values.size(),
+                              n_dofs_1d * n_q_points_1d_runtime);
+              shape_values[d]    = data.shape_values.data();
+              shape_gradients[d] = data.shape_gradients.data();
+              values_times_values[d].resize(data.shape_values.size());
+              values_times_gradients[d].resize(data.shape_values.size());
+              gradients_times_gradients[d].resize(data.shape_values.size());
+              for (unsigned int i = 0; i < data.shape_values.size(); ++i)
+                {
+                  values_times_values[d][i] =
+                    data.shape_values[i] * data.shape_values[i];
+                  values_times_gradients[d][i] =
+                    data.shape_values[i] * data.shape_gradients[i];
+                  gradients_times_gradients[d][i] =
+                    data.shape_gradients[i] * data.shape_gradients[i];
+                }
+            }
+      }
+
+      /**
+       * Return whether the element underlying the FEEvaluation object has
+       * tensor-product structure and can be treated by sum factorization.
+       */
+      bool
+      use_sum_factorization() const
+      {
+        return is_tensor_product;
+      }
+
+      /**
+       * Evaluate the coefficients at all quadrature points of the cell batch
+       * the FEEvaluation object is currently initialized on, and transform
+       * them to the reference cell, including the quadrature weights.
+       */
+      void
+      reinit_coefficients()
+      {
+        const unsigned int n_q_points = phi.n_q_points;
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            mass_coefficients[q]      = Number(0.);
+            diffusion_coefficients[q] = Tensor<2, dim, VectorizedArrayType>();
+            coefficients(phi,
+                         q,
+                         mass_coefficients[q],
+                         diffusion_coefficients[q]);
+
+            if (is_tensor_product == false)
+              continue;
+
+            // the gradient on the real cell is J^{-T} times the reference
+            // gradient, so the diffusion tensor on the reference cell is
+            // J^{-1} D J^{-T}
+            const Tensor<2, dim, VectorizedArrayType> inv_jac =
+              phi.inverse_jacobian(q);
+            const VectorizedArrayType JxW = phi.JxW(q);
+            const Tensor<2, dim, VectorizedArrayType> reference_diffusion =
+              transpose(inv_jac) * diffusion_coefficients[q] * inv_jac;
+            reference_coefficients[q] = mass_coefficients[q] * JxW;
+            for (unsigned int a = 0; a < dim; ++a)
+              for (unsigned int b = 0; b < dim; ++b)
+                reference_coefficients[(1 + a * dim + b) * n_q_points + q] =
+                  reference_diffusion[a][b] * JxW;
+          }
+      }
+
+      /**
+       * Apply the cell operator with the coefficients stored by
+       * reinit_coefficients() to the values in
+       * FEEvaluation::begin_dof_values(), using the evaluate() and
+       * integrate() functions of FEEvaluation. This is the operation passed
+       * to ComputeDiagonalHelper on cells with constraints.
+       */
+      void
+      apply_cell_operator() const
+      {
+        phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          {
+            phi.submit_value(mass_coefficients[q] * phi.get_value(q), q);
+            phi.submit_gradient(diffusion_coefficients[q] *
+                                  phi.get_gradient(q),
+                                q);
+          }
+        phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+      }
+
+      /**
+       * Compute the diagonal of the cell matrix in the lexicographic
+       * numbering of the FEEvaluation object.
+       */
+      void
+      compute_diagonal(VectorizedArrayType *diagonal)
+      {
+        const unsigned int n_q_points = phi.n_q_points;
+        const unsigned int dofs_per_cell = Utilities::pow(n_dofs_1d, dim);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          diagonal[i] = Number(0.);
+
+        // the mass term
+        std::array<const VectorizedArrayType *, dim> matrices;
+        for (unsigned int d = 0; d < dim; ++d)
+          matrices[d] = values_times_values[d].data();
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          scratch[q] = reference_coefficients[q];
+        integrate_add(matrices, diagonal);
+
+        // the diffusion term: the contribution of the reference derivatives
+        // in directions a and b is the same as the one of b and a on the
+        // diagonal, so combine the two
+        for (unsigned int a = 0; a < dim; ++a)
+          for (unsigned int b = a; b < dim; ++b)
+            {
+              for (unsigned int d = 0; d < dim; ++d)
+                matrices[d] = (d == a && d == b) ?
+                                gradients_times_gradients[d].data() :
+                                ((d == a || d == b) ?
+                                   values_times_gradients[d].data() :
+                                   values_times_values[d].data());
+              const VectorizedArrayType *coefficient_ab =
+                reference_coefficients.data() + (1 + a * dim + b) * n_q_points;
+              const VectorizedArrayType *coefficient_ba =
+                reference_coefficients.data() + (1 + b * dim + a) * n_q_points;
+              if (a == b)
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  scratch[q] = coefficient_ab[q];
+              else
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  scratch[q] = coefficient_ab[q] + coefficient_ba[q];
+              integrate_add(matrices, diagonal);
+            }
+      }
+
+      /**
+       * Compute the column @p j of the cell matrix in the lexicographic
+       * numbering of the FEEvaluation object.
+       */
+      void
+      compute_matrix_column(const unsigned int   j,
+                            VectorizedArrayType *column)
+      {
+        const unsigned int n_q_points = phi.n_q_points;
+        const unsigned int dofs_per_cell = Utilities::pow(n_dofs_1d, dim);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          column[i] = Number(0.);
+
+        // values and reference derivatives of the basis function j at the
+        // quadrature points, computed as tensor products of the 1D data
+        std::array<unsigned int, dim> j_1d;
+        for (unsigned int d = 0, jj = j; d < dim; ++d, jj /= n_dofs_1d)
+          j_1d[d] = jj % n_dofs_1d;
+        trial_functions.resize((dim + 1) * n_q_points);
+        for (unsigned int b = 0; b < dim + 1; ++b)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              VectorizedArrayType value = Number(1.);
+              for (unsigned int d = 0, qq = q; d < dim;
+                   ++d, qq /= n_q_points_1d_runtime)
+                {
+                  const VectorizedArrayType *shape =
+                    (b == d + 1) ? shape_gradients[d] : shape_values[d];
+                  value *= shape[j_1d[d] * n_q_points_1d_runtime +
+                                 qq % n_q_points_1d_runtime];
+                }
+              trial_functions[b * n_q_points + q] = value;
+            }
+
+        // test with the values for the mass term and with the reference
+        // derivative in direction a for the diffusion term
+        std::array<const VectorizedArrayType *, dim> matrices;
+        for (unsigned int d = 0; d < dim; ++d)
+          matrices[d] = shape_values[d];
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          scratch[q] = reference_coefficients[q] * trial_functions[q];
+        integrate_add(matrices, column);
+
+        for (unsigned int a = 0; a < dim; ++a)
+          {
+            for (unsigned int d = 0; d < dim; ++d)
+              matrices[d] = (d == a) ? shape_gradients[d] : shape_values[d];
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                VectorizedArrayType sum =
+                  reference_coefficients[(1 + a * dim) * n_q_points + q] *
+                  trial_functions[n_q_points + q];
+                for (unsigned int b = 1; b < dim; ++b)
+                  sum += reference_coefficients[(1 + a * dim + b) * n_q_points +
+                                                q] *
+                         trial_functions[(b + 1) * n_q_points + q];
+                scratch[q] = sum;
+              }
+            integrate_add(matrices, column);
+          }
+      }
+
+    private:
+      /**
+       * Multiply the data at quadrature points in the array scratch by the
+       * one-dimensional matrices @p matrices (in the layout of
+       * UnivariateShapeData::shape_values) along all directions, summing
+       * over the quadrature points, and add the result to @p out. The
+       * content of scratch is overwritten.
+       */
+      void
+      integrate_add(
+        const std::array<const VectorizedArrayType *, dim> &matrices,
+        VectorizedArrayType *                               out)
+      {
+        dealii::internal::EvaluatorTensorProduct<
+          dealii::internal::evaluate_general,
+          dim,
+          0,
+          0,
+          VectorizedArrayType,
+          VectorizedArrayType>
+          eval(matrices[0],
+               nullptr,
+               nullptr,
+               n_dofs_1d,
+               n_q_points_1d_runtime);
+        if (dim == 1)
+          eval.template apply<0, false, true>(matrices[0], scratch.data(), out);
+        else if (dim == 2)
+          {
+            eval.template apply<1, false, false>(matrices[1],
+                                                 scratch.data(),
+                                                 scratch_2.data());
+            eval.template apply<0, false, true>(matrices[0],
+                                                scratch_2.data(),
+                                                out);
+          }
+        else if (dim == 3)
+          {
+            eval.template apply<2, false, false>(matrices[2],
+                                                 scratch.data(),
+                                                 scratch_2.data());
+            eval.template apply<1, false, false>(matrices[1],
+                                                 scratch_2.data(),
+                                                 scratch.data());
+            eval.template apply<0, false, true>(matrices[0],
+                                                scratch.data(),
+                                                out);
+          }
+        else
+          Assert(false, ExcNotImplemented());
+      }
+
+      FEEvalType &phi;
+
+      const CoefficientFunction &coefficients;
+
+      const unsigned int n_q_points_1d_runtime;
+
+      const unsigned int n_dofs_1d;
+
+      const bool is_tensor_product;
+
+      AlignedVector<VectorizedArrayType> mass_coefficients;
+
+      AlignedVector<Tensor<2, dim, VectorizedArrayType>> diffusion_coefficients;
+
+      // mass coefficient and the dim*dim entries of the diffusion tensor on
+      // the reference cell times the quadrature weight and the Jacobian
+      // determinant, each for all quadrature points
+      AlignedVector<VectorizedArrayType> reference_coefficients;
+
+      std::array<const VectorizedArrayType *, dim> shape_values;
+      std::array<const VectorizedArrayType *, dim> shape_gradients;
+
+      // products of the 1D shape values and gradients with themselves for
+      // the diagonal
+      std::array<AlignedVector<VectorizedArrayType>, dim> values_times_values;
+      std::array<AlignedVector<VectorizedArrayType>, dim>
+        values_times_gradients;
+      std::array<AlignedVector<VectorizedArrayType>, dim>
+        gradients_times_gradients;
+
+      AlignedVector<VectorizedArrayType> trial_functions;
+      AlignedVector<VectorizedArrayType> scratch;
+      AlignedVector<VectorizedArrayType> scratch_2;
+    };
+  } // namespace internal
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  compute_diagonal_sum_factorized(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    VectorType &                                        diagonal_global,
+    const std::function<void(const FEEvaluation<dim,
+                                                fe_degree,
+                                                n_q_points_1d,
+                                                1,
+                                                Number,
+                                                VectorizedArrayType> &,
+                             const unsigned int,
+                             VectorizedArrayType &,
+                             Tensor<2, dim, VectorizedArrayType> &)>
+      &                coefficients,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    int dummy = 0;
+
+    std::array<typename dealii::internal::BlockVectorSelector<
+                 VectorType,
+                 IsBlockVector<VectorType>::value>::BaseVectorType *,
+               1>
+      diagonal_global_components;
+    diagonal_global_components[0] = dealii::internal::
+      BlockVectorSelector<VectorType, IsBlockVector<VectorType>::value>::
+        get_vector_component(diagonal_global, first_selected_component);
+
+    const auto &dof_info = matrix_free.get_dof_info(dof_no);
+    dealii::internal::check_vector_compatibility(*diagonal_global_components[0],
+                                                 matrix_free,
+                                                 dof_info);
+
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+    const unsigned int     n_fe_components = dof_info.start_components.back();
+    const unsigned int     first_component =
+      n_fe_components == 1 ? 0 : first_selected_component;
+
+    matrix_free.template cell_loop<VectorType, int>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+          VectorType &,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) mutable {
+        FEEvaluation<dim,
+                     fe_degree,
+                     n_q_points_1d,
+                     1,
+                     Number,
+                     VectorizedArrayType>
+          phi(matrix_free, range, dof_no, quad_no, first_selected_component);
+
+        internal::ComputeDiagonalHelper<dim,
+                                        fe_degree,
+                                        n_q_points_1d,
+                                        1,
+                                        Number,
+                                        VectorizedArrayType>
+          helper(phi);
+        internal::SumFactorizedOperatorHelper<dim,
+                                              fe_degree,
+                                              n_q_points_1d,
+                                              Number,
+                                              VectorizedArrayType>
+          operator_helper(phi, coefficients);
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            // check whether any degree of freedom on the cell batch is
+            // constrained, in which case we need the full cell matrix
+            bool has_constraints = false;
+            for (unsigned int v = 0;
+                 v < matrix_free.n_active_entries_per_cell_batch(cell);
+                 ++v)
+              {
+                const unsigned int index =
+                  (cell * n_lanes + v) * n_fe_components + first_component;
+                if (dof_info.row_starts[index].second !=
+                      dof_info.row_starts[index + 1].second ||
+                    (dof_info.hanging_node_constraint_masks.size() > 0 &&
+                     dof_info.hanging_node_constraint_masks[cell * n_lanes +
+                                                            v] !=
+                       dealii::internal::MatrixFreeFunctions::
+                         unconstrained_compressed_constraint_kind))
+                  has_constraints = true;
+              }
+
+            if (operator_helper.use_sum_factorization() && !has_constraints)
+              {
+                phi.reinit(cell);
+                operator_helper.reinit_coefficients();
+                operator_helper.compute_diagonal(phi.begin_dof_values());
+                phi.distribute_local_to_global(*diagonal_global_components[0]);
+              }
+            else
+              {
+                helper.reinit(cell);
+                operator_helper.reinit_coefficients();
+                for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+                  {
+                    helper.prepare_basis_vector(i);
+                    operator_helper.apply_cell_operator();
+                    helper.submit();
+                  }
+
+                helper.distribute_local_to_global(diagonal_global_components);
+              }
+          }
+      },
+      diagonal_global,
+      dummy,
+      false);
+  }
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  compute_inverse_cell_blocks_sum_factorized(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    AlignedVector<VectorizedArrayType> &                inverse_blocks,
+    const std::function<void(const FEEvaluation<dim,
+                                                fe_degree,
+                                                n_q_points_1d,
+                                                1,
+                                                Number,
+                                                VectorizedArrayType> &,
+                             const unsigned int,
+                             VectorizedArrayType &,
+                             Tensor<2, dim, VectorizedArrayType> &)>
+      &                coefficients,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    const unsigned int dofs_per_cell =
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   1,
+                   Number,
+                   VectorizedArrayType>(matrix_free,
+                                        dof_no,
+                                        quad_no,
+                                        first_selected_component)
+        .dofs_per_cell;
+    inverse_blocks.resize_fast(matrix_free.n_cell_batches() * dofs_per_cell *
+                               dofs_per_cell);
+
+    int dummy = 0;
+
+    matrix_free.template cell_loop<int, int>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+          int &,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) mutable {
+        FEEvaluation<dim,
+                     fe_degree,
+                     n_q_points_1d,
+                     1,
+                     Number,
+                     VectorizedArrayType>
+          phi(matrix_free, range, dof_no, quad_no, first_selected_component);
+
+        internal::SumFactorizedOperatorHelper<dim,
+                                              fe_degree,
+                                              n_q_points_1d,
+                                              Number,
+                                              VectorizedArrayType>
+          operator_helper(phi, coefficients);
+        Assert(operator_helper.use_sum_factorization(),
+               ExcMessage("The cell blocks can only be computed for elements "
+                          "with tensor-product structure."));
+
+        AlignedVector<VectorizedArrayType> column(dofs_per_cell);
+        FullMatrix<Number>                 matrix(dofs_per_cell, dofs_per_cell);
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            operator_helper.reinit_coefficients();
+
+            VectorizedArrayType *block =
+              inverse_blocks.data() + cell * dofs_per_cell * dofs_per_cell;
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              {
+                operator_helper.compute_matrix_column(j, column.data());
+                for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                  block[i * dofs_per_cell + j] = column[i];
+              }
+
+            for (unsigned int v = 0; v < VectorizedArrayType::size(); ++v)
+              {
+                if (v < matrix_free.n_active_entries_per_cell_batch(cell))
+                  {
+                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                        matrix(i, j) = block[i * dofs_per_cell + j][v];
+                    matrix.gauss_jordan();
+                  }
+                else
+                  {
+                    matrix = Number(0.);
+                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                      matrix(i, i) = Number(1.);
+                  }
+                for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                  for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                    block[i * dofs_per_cell + j][v] = matrix(i, j);
+              }
+          }
+      },
+      dummy,
+      dummy,
+      false);
+  }
+
   namespace internal
   {
     /**
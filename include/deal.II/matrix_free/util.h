@@ -57,6 +57,12 @@ namespace internal
               return {ReferenceCells::get_simplex<dim>(),
                       dealii::hp::QCollection<dim - 1>(
                         QWitherdenVincentSimplex<dim - 1>(i))};
+
+          for (unsigned int i = 1; i <= 10; ++i)
+            if (quad == QStroudSimplex<dim>(i))
+              return {ReferenceCells::get_simplex<dim>(),
+                      dealii::hp::QCollection<dim - 1>(
+                        QStroudSimplex<dim - 1>(i))};
         }
 
       if (dim == 3)
@@ -71,6 +77,18 @@ namespace internal
                 dealii::hp::QCollection<dim - 1>(tri, tri, quad, quad, quad)};
             }
 
+      if (dim == 3)
+        for (unsigned int i = 1; i <= 10; ++i)
+          if (quad == QStroudWedge<dim>(i))
+            {
+              QGauss<dim - 1>         quad(i);
+              QStroudSimplex<dim - 1> tri(i);
+
+              return {
+                ReferenceCells::Wedge,
+                dealii::hp::QCollection<dim - 1>(tri, tri, quad, quad, quad)};
+            }
+
       if (dim == 3)
         for (unsigned int i = 1; i <= 2; ++i)
           if (quad == QGaussPyramid<dim>(i))
@@ -132,6 +150,16 @@ namespace internal
                   return {Quadrature<dim - 1>(),
                           QWitherdenVincentSimplex<dim - 1>(i)};
               }
+
+          for (unsigned int i = 1; i <= 10; ++i)
+            if (quad == QStroudSimplex<dim>(i))
+              {
+                if (dim == 2)
+                  return {QStroudSimplex<dim - 1>(i), // line!
+                          Quadrature<dim - 1>()};
+                else
+                  return {Quadrature<dim - 1>(), QStroudSimplex<dim - 1>(i)};
+              }
         }
 
       if (dim == 3)
@@ -139,6 +167,11 @@ namespace internal
           if (quad == QGaussWedge<dim>(i))
             return {QGauss<dim - 1>(i), QGaussSimplex<dim - 1>(i)};
 
+      if (dim == 3)
+        for (unsigned int i = 1; i <= 10; ++i)
+          if (quad == QStroudWedge<dim>(i))
+            return {QGauss<dim - 1>(i), QStroudSimplex<dim - 1>(i)};
+
       if (dim == 3)
         for (unsigned int i = 1; i <= 2; ++i)
           if (quad == QGaussPyramid<dim>(i))
@@ -136,10 +136,99 @@ namespace internal
       };
 
 
+
+      /**
+       * Extension of the Base interface by functions that exchange the data
+       * of several vectors with the same parallel layout, e.g. the blocks of
+       * a block vector, with a single message per process.
+       */
+      class AggregatedBase : public Base
+      {
+      public:
+        /**
+         * Start the exchange of the ghost values of several vectors. The
+         * data of all vectors sent to and received from one process is
+         * collected in a single message. The @p temporary_storage must hold
+         * locally_owned_arrays.size() * (n_import_indices() +
+         * n_ghost_indices()) entries.
+         */
+        virtual void
+        export_to_ghosted_arrays_start(
+          const unsigned int                          communication_channel,
+          const std::vector<ArrayView<const double>> &locally_owned_arrays,
+          const std::vector<ArrayView<double>> &      ghost_arrays,
+          const ArrayView<double> &                   temporary_storage,
+          std::vector<MPI_Request> &                  requests) const = 0;
+
+        /**
+         * Finish the exchange started by export_to_ghosted_arrays_start().
+         * The data is copied into the ghost arrays of each process as soon as
+         * its message has arrived.
+         */
+        virtual void
+        export_to_ghosted_arrays_finish(
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<const double> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const = 0;
+
+        /**
+         * Start sending the ghost values of several vectors to their owners
+         * with a single message per process, where they get added to the
+         * locally owned values in import_from_ghosted_arrays_finish().
+         */
+        virtual void
+        import_from_ghosted_arrays_start(
+          const unsigned int                    communication_channel,
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<double> &             temporary_storage,
+          std::vector<MPI_Request> &            requests) const = 0;
+
+        /**
+         * Finish the operation started by import_from_ghosted_arrays_start()
+         * by adding the data of each process as soon as its message has
+         * arrived, and zero the ghost arrays.
+         */
+        virtual void
+        import_from_ghosted_arrays_finish(
+          const std::vector<ArrayView<double>> &locally_owned_arrays,
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<const double> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const = 0;
+
+        virtual void
+        export_to_ghosted_arrays_start(
+          const unsigned int                         communication_channel,
+          const std::vector<ArrayView<const float>> &locally_owned_arrays,
+          const std::vector<ArrayView<float>> &      ghost_arrays,
+          const ArrayView<float> &                   temporary_storage,
+          std::vector<MPI_Request> &                 requests) const = 0;
+
+        virtual void
+        export_to_ghosted_arrays_finish(
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<const float> &       temporary_storage,
+          std::vector<MPI_Request> &           requests) const = 0;
+
+        virtual void
+        import_from_ghosted_arrays_start(
+          const unsigned int                   communication_channel,
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<float> &             temporary_storage,
+          std::vector<MPI_Request> &           requests) const = 0;
+
+        virtual void
+        import_from_ghosted_arrays_finish(
+          const std::vector<ArrayView<float>> &locally_owned_arrays,
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<const float> &       temporary_storage,
+          std::vector<MPI_Request> &           requests) const = 0;
+      };
+
+
       /**
        * Class that simply delegates the task to a Utilities::MPI::Partitioner.
        */
-      class PartitionerWrapper : public Base
+      class PartitionerWrapper : public AggregatedBase
       {
       public:
         PartitionerWrapper(
@@ -239,12 +328,134 @@ namespace internal
         void
         reset_ghost_values(const ArrayView<float> &ghost_array) const override;
 
+        void
+        export_to_ghosted_arrays_start(
+          const unsigned int                          communication_channel,
+          const std::vector<ArrayView<const double>> &locally_owned_arrays,
+          const std::vector<ArrayView<double>> &      ghost_arrays,
+          const ArrayView<double> &                   temporary_storage,
+          std::vector<MPI_Request> &                  requests) const override;
+
+        void
+        export_to_ghosted_arrays_finish(
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<const double> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const override;
+
+        void
+        import_from_ghosted_arrays_start(
+          const unsigned int                    communication_channel,
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<double> &             temporary_storage,
+          std::vector<MPI_Request> &            requests) const override;
+
+        void
+        import_from_ghosted_arrays_finish(
+          const std::vector<ArrayView<double>> &locally_owned_arrays,
+          const std::vector<ArrayView<double>> &ghost_arrays,
+          const ArrayView<const double> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const override;
+
+        void
+        export_to_ghosted_arrays_start(
+          const unsigned int                         communication_channel,
+          const std::vector<ArrayView<const float>> &locally_owned_arrays,
+          const std::vector<ArrayView<float>> &      ghost_arrays,
+          const ArrayView<float> &                   temporary_storage,
+          std::vector<MPI_Request> &                 requests) const override;
+
+        void
+        export_to_ghosted_arrays_finish(
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<const float> &       temporary_storage,
+          std::vector<MPI_Request> &           requests) const override;
+
+        void
+        import_from_ghosted_arrays_start(
+          const unsigned int                   communication_channel,
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<float> &             temporary_storage,
+          std::vector<MPI_Request> &           requests) const override;
+
+        void
+        import_from_ghosted_arrays_finish(
+          const std::vector<ArrayView<float>> &locally_owned_arrays,
+          const std::vector<ArrayView<float>> &ghost_arrays,
+          const ArrayView<const float> &       temporary_storage,
+          std::vector<MPI_Request> &           requests) const override;
+
       private:
         template <typename Number>
         void
         reset_ghost_values_impl(const ArrayView<Number> &ghost_array) const;
 
+        template <typename Number>
+        void
+        export_to_ghosted_arrays_start_impl(
+          const unsigned int                          communication_channel,
+          const std::vector<ArrayView<const Number>> &locally_owned_arrays,
+          const std::vector<ArrayView<Number>> &      ghost_arrays,
+          const ArrayView<Number> &                   temporary_storage,
+          std::vector<MPI_Request> &                  requests) const;
+
+        template <typename Number>
+        void
+        export_to_ghosted_arrays_finish_impl(
+          const std::vector<ArrayView<Number>> &ghost_arrays,
+          const ArrayView<const Number> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const;
+
+        template <typename Number>
+        void
+        import_from_ghosted_arrays_start_impl(
+          const unsigned int                    communication_channel,
+          const std::vector<ArrayView<Number>> &ghost_arrays,
+          const ArrayView<Number> &             temporary_storage,
+          std::vector<MPI_Request> &            requests) const;
+
+        template <typename Number>
+        void
+        import_from_ghosted_arrays_finish_impl(
+          const std::vector<ArrayView<Number>> &locally_owned_arrays,
+          const std::vector<ArrayView<Number>> &ghost_arrays,
+          const ArrayView<const Number> &       temporary_storage,
+          std::vector<MPI_Request> &            requests) const;
+
         const std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
+
+        /**
+         * The ranges within the ghost array that are received from each
+         * process in Utilities::MPI::Partitioner::ghost_targets(), split such
+         * that no range spans several processes. The ranges of process @p i
+         * are given by the indices between ghost_ranges_by_rank_ptr[i] and
+         * ghost_ranges_by_rank_ptr[i+1].
+         */
+        std::vector<std::pair<unsigned int, unsigned int>>
+          ghost_ranges_by_rank;
+
+        /**
+         * Pointer into ghost_ranges_by_rank for each ghost target.
+         */
+        std::vector<unsigned int> ghost_ranges_by_rank_ptr;
+
+        /**
+         * The offset of the data of each ghost target within the ghost
+         * indices, i.e., the sum of the ghost indices of the processes before
+         * it.
+         */
+        std::vector<unsigned int> ghost_offsets_by_rank;
+
+        /**
+         * Pointer into Utilities::MPI::Partitioner::import_indices() for each
+         * import target.
+         */
+        std::vector<unsigned int> import_ranges_by_rank_ptr;
+
+        /**
+         * The offset of the data of each import target within the import
+         * indices.
+         */
+        std::vector<unsigned int> import_offsets_by_rank;
       };
 
 
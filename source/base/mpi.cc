@@ -1071,6 +1071,21 @@ namespace Utilities
 
 
 
+    void
+    wait_for_request(MPI_Request &request)
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (request != MPI_REQUEST_NULL)
+        {
+          const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#endif
+      request = MPI_REQUEST_NULL;
+    }
+
+
+
     std::vector<unsigned int>
     compute_index_owner(const IndexSet &owned_indices,
                         const IndexSet &indices_to_look_up,
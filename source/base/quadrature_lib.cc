@@ -2073,6 +2073,90 @@ QIteratedSimplex<dim>::QIteratedSimplex(const Quadrature<dim> &base_quad,
 
 
 
+namespace
+{
+  /**
+   * Compute the points and weights of the Gauss-Jacobi quadrature rule with
+   * @p n_points points for the weight function $(1-x)^\alpha$ on the unit
+   * interval.
+   */
+  std::pair<std::vector<double>, std::vector<double>>
+  compute_gauss_jacobi_rule(const unsigned int n_points, const int alpha)
+  {
+    const std::vector<long double> roots =
+      Polynomials::jacobi_polynomial_roots<long double>(n_points, alpha, 0);
+    std::vector<double> points(roots.begin(), roots.end());
+    std::sort(points.begin(), points.end());
+
+    // the weights are the integrals of the Lagrange polynomials through the
+    // points against the weight function, which a Gauss formula computes
+    // exactly
+    const QGauss<1>     gauss((n_points + alpha) / 2 + 1);
+    std::vector<double> weights(n_points, 0.);
+    for (unsigned int q = 0; q < gauss.size(); ++q)
+      {
+        const double t = gauss.point(q)[0];
+        const double factor = gauss.weight(q) * std::pow(1. - t, alpha);
+        for (unsigned int i = 0; i < n_points; ++i)
+          {
+            double lagrange = 1.;
+            for (unsigned int j = 0; j < n_points; ++j)
+              if (j != i)
+                lagrange *= (t - points[j]) / (points[i] - points[j]);
+            weights[i] += factor * lagrange;
+          }
+      }
+
+    return {points, weights};
+  }
+} // namespace
+
+
+
+template <int dim>
+QStroudSimplex<dim>::QStroudSimplex(const unsigned int n_points_1D)
+  : QSimplex<dim>(Quadrature<dim>())
+{
+  if (dim == 0 || dim == 1)
+    {
+      const dealii::QGauss<dim> quad(n_points_1D);
+
+      this->quadrature_points = quad.get_points();
+      this->weights           = quad.get_weights();
+    }
+  else if (dim == 2 || dim == 3)
+    {
+      const QGauss<1> quad_a(n_points_1D);
+      const auto      rule_b = compute_gauss_jacobi_rule(n_points_1D, 1);
+      const auto      rule_c = compute_gauss_jacobi_rule(n_points_1D, 2);
+
+      const unsigned int n_points_c = (dim == 3 ? n_points_1D : 1);
+      for (unsigned int k = 0; k < n_points_c; ++k)
+        for (unsigned int j = 0; j < n_points_1D; ++j)
+          for (unsigned int i = 0; i < n_points_1D; ++i)
+            {
+              const double a = quad_a.point(i)[0];
+              const double b = rule_b.first[j];
+              const double c = (dim == 3 ? rule_c.first[k] : 0.);
+
+              Point<dim> p;
+              p[0] = a * (1. - b) * (1. - c);
+              p[1] = b * (1. - c);
+              if (dim == 3)
+                p[dim - 1] = c;
+              this->quadrature_points.push_back(p);
+              this->weights.push_back(quad_a.weight(i) * rule_b.second[j] *
+                                      (dim == 3 ? rule_c.second[k] : 1.));
+            }
+    }
+  else
+    Assert(false, ExcNotImplemented());
+
+  AssertDimension(this->quadrature_points.size(), this->weights.size());
+}
+
+
+
 template <int dim>
 QGaussWedge<dim>::QGaussWedge(const unsigned int n_points)
   : Quadrature<dim>()
@@ -2098,6 +2182,29 @@ QGaussWedge<dim>::QGaussWedge(const unsigned int n_points)
 
 
 
+template <int dim>
+QStroudWedge<dim>::QStroudWedge(const unsigned int n_points_1D)
+  : Quadrature<dim>()
+{
+  AssertDimension(dim, 3);
+
+  QStroudSimplex<2> quad_tri(n_points_1D);
+  QGauss<1>         quad_line(n_points_1D);
+
+  for (unsigned int i = 0; i < quad_line.size(); ++i)
+    for (unsigned int j = 0; j < quad_tri.size(); ++j)
+      {
+        this->quadrature_points.emplace_back(quad_tri.point(j)[0],
+                                             quad_tri.point(j)[1],
+                                             quad_line.point(i)[0]);
+        this->weights.emplace_back(quad_tri.weight(j) * quad_line.weight(i));
+      }
+
+  AssertDimension(this->quadrature_points.size(), this->weights.size());
+}
+
+
+
 template <int dim>
 QGaussPyramid<dim>::QGaussPyramid(const unsigned int n_points_1D)
   : Quadrature<dim>()
@@ -2207,4 +2314,12 @@ template class QWitherdenVincentSimplex<1>;
 template class QWitherdenVincentSimplex<2>;
 template class QWitherdenVincentSimplex<3>;
 
+template class QStroudSimplex<0>;
+template class QStroudSimplex<1>;
+template class QStroudSimplex<2>;
+template class QStroudSimplex<3>;
+template class QStroudWedge<1>;
+template class QStroudWedge<2>;
+template class QStroudWedge<3>;
+
 DEAL_II_NAMESPACE_CLOSE
@@ -16,6 +16,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -63,6 +64,7 @@ DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 #include <boost/random/uniform_real_distribution.hpp>
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
@@ -858,6 +860,88 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  void
+  reorder_cells_and_vertices_hilbert(std::vector<Point<spacedim>> &vertices,
+                                     std::vector<CellData<dim>> &  cells,
+                                     SubCellData &                 subcelldata)
+  {
+    Assert(
+      subcelldata.check_consistency(dim),
+      ExcMessage(
+        "Invalid SubCellData supplied according to ::check_consistency(). "
+        "This is caused by data containing objects for the wrong dimension."));
+
+    // compute the position of the cell centers along the Hilbert curve
+    std::vector<Point<spacedim>> cell_centers(cells.size());
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      {
+        Assert(cells[c].vertices.size() > 0, ExcInternalError());
+        for (const unsigned int v : cells[c].vertices)
+          {
+            AssertIndexRange(v, vertices.size());
+            cell_centers[c] += vertices[v];
+          }
+        cell_centers[c] /= cells[c].vertices.size();
+      }
+    const std::vector<std::array<std::uint64_t, spacedim>> hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(cell_centers);
+
+    // sort the cells by their index along the curve. use a stable sort to
+    // keep the order of cells with the same index deterministic
+    std::vector<unsigned int> cell_permutation(cells.size());
+    std::iota(cell_permutation.begin(), cell_permutation.end(), 0U);
+    std::stable_sort(cell_permutation.begin(),
+                     cell_permutation.end(),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return hilbert_indices[a] < hilbert_indices[b];
+                     });
+
+    std::vector<CellData<dim>> new_cells;
+    new_cells.reserve(cells.size());
+    for (const unsigned int c : cell_permutation)
+      new_cells.push_back(std::move(cells[c]));
+    cells.swap(new_cells);
+
+    // then number the vertices in the order in which the cells visit them
+    std::vector<unsigned int> new_vertex_numbers(vertices.size(),
+                                                 numbers::invalid_unsigned_int);
+    unsigned int              next_free_number = 0;
+    for (auto &cell : cells)
+      for (auto &vertex_index : cell.vertices)
+        {
+          if (new_vertex_numbers[vertex_index] == numbers::invalid_unsigned_int)
+            new_vertex_numbers[vertex_index] = next_free_number++;
+          vertex_index = new_vertex_numbers[vertex_index];
+        }
+    // vertices not referenced by any cell keep their relative order and are
+    // placed after the used ones
+    for (auto &new_number : new_vertex_numbers)
+      if (new_number == numbers::invalid_unsigned_int)
+        new_number = next_free_number++;
+    AssertDimension(next_free_number, vertices.size());
+
+    for (auto &quad : subcelldata.boundary_quads)
+      for (auto &vertex_index : quad.vertices)
+        {
+          AssertIndexRange(vertex_index, vertices.size());
+          vertex_index = new_vertex_numbers[vertex_index];
+        }
+    for (auto &line : subcelldata.boundary_lines)
+      for (auto &vertex_index : line.vertices)
+        {
+          AssertIndexRange(vertex_index, vertices.size());
+          vertex_index = new_vertex_numbers[vertex_index];
+        }
+
+    std::vector<Point<spacedim>> new_vertices(vertices.size());
+    for (unsigned int v = 0; v < vertices.size(); ++v)
+      new_vertices[new_vertex_numbers[v]] = vertices[v];
+    vertices.swap(new_vertices);
+  }
+
+
+
   template <int dim, int spacedim>
   std::size_t
   invert_cells_with_negative_measure(
@@ -5731,6 +5815,230 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+#ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#else
+  return_type
+#endif
+  compute_point_locations_batched(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points,
+                                  const double tolerance)
+  {
+    Assert((dim == spacedim),
+           ExcMessage("Only implemented for dim==spacedim."));
+
+    namespace bgi = boost::geometry::index;
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const auto &       mapping  = cache.get_mapping();
+    const unsigned int n_points = points.size();
+
+    std::vector<active_cell_iterator>      cells_out;
+    std::vector<std::vector<Point<dim>>>   qpoints_out;
+    std::vector<std::vector<unsigned int>> maps_out;
+    std::vector<unsigned int>              missing_points_out;
+
+    if (n_points == 0)
+      return std::make_tuple(std::move(cells_out),
+                             std::move(qpoints_out),
+                             std::move(maps_out),
+                             std::move(missing_points_out));
+
+    // The cache is not thread-safe, so get the tree before starting the
+    // tasks below
+    const auto &b_tree = cache.get_cell_bounding_boxes_rtree();
+
+    // Collect the candidate cells of each point, starting with the cell
+    // whose bounding box has its center closest to the point
+    std::vector<std::vector<active_cell_iterator>> candidates(n_points);
+    parallel::apply_to_subranges(
+      0U,
+      n_points,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<std::pair<BoundingBox<spacedim>, active_cell_iterator>>
+          boxes;
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            boxes.clear();
+            b_tree.query(bgi::intersects(points[i]),
+                         std::back_inserter(boxes));
+            std::sort(boxes.begin(),
+                      boxes.end(),
+                      [&](const auto &a, const auto &b) {
+                        const double distance_a =
+                          a.first.center().distance_square(points[i]);
+                        const double distance_b =
+                          b.first.center().distance_square(points[i]);
+                        return distance_a < distance_b ||
+                               (distance_a == distance_b &&
+                                a.second < b.second);
+                      });
+            candidates[i].reserve(boxes.size());
+            for (const auto &box : boxes)
+              candidates[i].push_back(box.second);
+          }
+      },
+      256);
+
+    // In each round, group the points not found yet by their next candidate
+    // cell and transform all points of a group at once
+    std::vector<active_cell_iterator> point_cells(n_points);
+    std::vector<Point<dim>>           unit_points(n_points);
+    std::vector<unsigned int>         remaining_points(n_points);
+    std::iota(remaining_points.begin(), remaining_points.end(), 0U);
+    for (unsigned int round = 0; remaining_points.size() > 0; ++round)
+      {
+        // pairs of the active cell index of the candidate and point index,
+        // sorted such that the points of each cell are contiguous
+        std::vector<std::pair<unsigned int, unsigned int>> cell_and_point;
+        for (const unsigned int i : remaining_points)
+          if (round < candidates[i].size())
+            cell_and_point.emplace_back(
+              candidates[i][round]->active_cell_index(), i);
+        if (cell_and_point.size() == 0)
+          break;
+        std::sort(cell_and_point.begin(), cell_and_point.end());
+
+        std::vector<unsigned int> group_starts;
+        for (unsigned int j = 0; j < cell_and_point.size(); ++j)
+          if (j == 0 || cell_and_point[j].first != cell_and_point[j - 1].first)
+            group_starts.push_back(j);
+        group_starts.push_back(cell_and_point.size());
+
+        parallel::apply_to_subranges(
+          0U,
+          group_starts.size() - 1,
+          [&](const unsigned int begin, const unsigned int end) {
+            std::vector<Point<spacedim>> real_group;
+            std::vector<Point<dim>>      unit_group;
+            for (unsigned int g = begin; g < end; ++g)
+              {
+                const active_cell_iterator &cell =
+                  candidates[cell_and_point[group_starts[g]].second][round];
+                real_group.clear();
+                for (unsigned int j = group_starts[g]; j < group_starts[g + 1];
+                     ++j)
+                  real_group.push_back(points[cell_and_point[j].second]);
+                unit_group.resize(real_group.size());
+
+                // failed transformations are marked by an infinite
+                // coordinate and hence not inside the reference cell
+                mapping.transform_points_real_to_unit_cell(
+                  cell,
+                  make_array_view(real_group),
+                  make_array_view(unit_group));
+                for (unsigned int j = 0; j < unit_group.size(); ++j)
+                  if (cell->reference_cell().contains_point(unit_group[j],
+                                                            tolerance))
+                    {
+                      const unsigned int i =
+                        cell_and_point[group_starts[g] + j].second;
+                      point_cells[i] = cell;
+                      unit_points[i] = unit_group[j];
+                    }
+              }
+          },
+          16);
+
+        remaining_points.erase(
+          std::remove_if(remaining_points.begin(),
+                         remaining_points.end(),
+                         [&](const unsigned int i) {
+                           return point_cells[i].state() ==
+                                  IteratorState::valid;
+                         }),
+          remaining_points.end());
+      }
+
+    // Search the points that are not in any of their candidate cells with
+    // the more expensive algorithm, in parallel. This includes the points
+    // without any candidate cell, as the bounding boxes neither account for
+    // the tolerance nor necessarily enclose curved cells. The fallback
+    // measures the distance to the unit cell in terms of the hypercube, so
+    // check the result against the actual reference cell. As above, the data
+    // of the cache is collected before starting the tasks.
+    std::vector<unsigned int> fallback_points;
+    for (unsigned int i = 0; i < n_points; ++i)
+      if (point_cells[i].state() != IteratorState::valid)
+        fallback_points.push_back(i);
+
+    if (fallback_points.size() > 0)
+      {
+        const auto &mesh            = cache.get_triangulation();
+        const auto &vertex_to_cells = cache.get_vertex_to_cell_map();
+        const auto &vertex_to_cell_centers =
+          cache.get_vertex_to_cell_centers_directions();
+        const auto &used_vertices_rtree = cache.get_used_vertices_rtree();
+
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(fallback_points.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int j = begin; j < end; ++j)
+              {
+                const unsigned int i            = fallback_points[j];
+                const auto         cell_and_ref = find_active_cell_around_point(
+                  mapping,
+                  mesh,
+                  points[i],
+                  vertex_to_cells,
+                  vertex_to_cell_centers,
+                  candidates[i].size() > 0 ? candidates[i][0] :
+                                             active_cell_iterator(),
+                  std::vector<bool>(),
+                  used_vertices_rtree,
+                  tolerance);
+                if (cell_and_ref.first.state() == IteratorState::valid &&
+                    cell_and_ref.first->reference_cell().contains_point(
+                      cell_and_ref.second, tolerance))
+                  {
+                    point_cells[i] = cell_and_ref.first;
+                    unit_points[i] = cell_and_ref.second;
+                  }
+              }
+          },
+          16);
+      }
+
+    for (const unsigned int i : fallback_points)
+      if (point_cells[i].state() != IteratorState::valid)
+        missing_points_out.push_back(i);
+
+    // Finally sort the points by the cells they are in
+    std::vector<std::pair<unsigned int, unsigned int>> cell_and_point;
+    cell_and_point.reserve(n_points - missing_points_out.size());
+    for (unsigned int i = 0; i < n_points; ++i)
+      if (point_cells[i].state() == IteratorState::valid)
+        cell_and_point.emplace_back(point_cells[i]->active_cell_index(), i);
+    std::sort(cell_and_point.begin(), cell_and_point.end());
+
+    for (unsigned int j = 0; j < cell_and_point.size(); ++j)
+      {
+        const unsigned int i = cell_and_point[j].second;
+        if (j == 0 || cell_and_point[j].first != cell_and_point[j - 1].first)
+          {
+            cells_out.push_back(point_cells[i]);
+            qpoints_out.emplace_back();
+            maps_out.emplace_back();
+          }
+        qpoints_out.back().push_back(unit_points[i]);
+        maps_out.back().push_back(i);
+      }
+
+    return std::make_tuple(std::move(cells_out),
+                           std::move(qpoints_out),
+                           std::move(maps_out),
+                           std::move(missing_points_out));
+  }
+
+
+
   template <int dim, int spacedim>
 #ifndef DOXYGEN
   std::tuple<
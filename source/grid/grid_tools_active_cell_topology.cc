@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/grid/grid_tools_active_cell_topology.h>
+#include <deal.II/grid/tria_accessor.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  template <int dim, int spacedim>
+  ActiveCellTopology<dim, spacedim>::ActiveCellTopology(
+    const Triangulation<dim, spacedim> &tria)
+  {
+    reinit(tria);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ActiveCellTopology<dim, spacedim>::reinit(
+    const Triangulation<dim, spacedim> &tria)
+  {
+    this->tria = &tria;
+
+    const unsigned int n_cells = tria.n_active_cells();
+    cell_level_index.resize(n_cells);
+    vertex_offsets.resize(n_cells + 1);
+    face_offsets.resize(n_cells + 1);
+
+    // first count the vertices and faces of all cells to set up the offsets
+    // of the compressed storage
+    vertex_offsets[0] = 0;
+    face_offsets[0]   = 0;
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        const unsigned int index  = cell->active_cell_index();
+        cell_level_index[index]   = {static_cast<unsigned int>(cell->level()),
+                                   static_cast<unsigned int>(cell->index())};
+        vertex_offsets[index + 1] = cell->n_vertices();
+        face_offsets[index + 1]   = cell->n_faces();
+      }
+    for (unsigned int c = 0; c < n_cells; ++c)
+      {
+        vertex_offsets[c + 1] += vertex_offsets[c];
+        face_offsets[c + 1] += face_offsets[c];
+      }
+
+    vertex_indices_data.resize(vertex_offsets.back());
+    face_orientations.resize(face_offsets.back());
+    face_neighbor_offsets.resize(face_offsets.back() + 1);
+    face_neighbor_offsets[0] = 0;
+    face_neighbors_data.clear();
+    face_neighbors_data.reserve(face_offsets.back());
+
+    // go through the cells in the order of the active cell index, such that
+    // the neighbors can be appended to the list
+    for (const unsigned int c : cell_indices())
+      {
+        const auto cell = cell_iterator(c);
+        Assert(cell->active_cell_index() == c, ExcInternalError());
+
+        for (const unsigned int v : cell->vertex_indices())
+          vertex_indices_data[vertex_offsets[c] + v] = cell->vertex_index(v);
+
+        for (const unsigned int f : cell->face_indices())
+          {
+            const unsigned int index = face_offsets[c] + f;
+            face_orientations[index] = cell->combined_face_orientation(f);
+
+            if (cell->at_boundary(f) == false)
+              {
+                auto neighbor = cell->neighbor(f);
+                if (neighbor->is_active())
+                  face_neighbors_data.push_back(neighbor->active_cell_index());
+                else if (dim == 1)
+                  {
+                    // in 1d, the neighbor is the outermost child on the side
+                    // of the present cell
+                    while (neighbor->has_children())
+                      neighbor = neighbor->child(1 - f);
+                    face_neighbors_data.push_back(
+                      neighbor->active_cell_index());
+                  }
+                else
+                  for (unsigned int sf = 0;
+                       sf < cell->face(f)->n_active_descendants();
+                       ++sf)
+                    face_neighbors_data.push_back(
+                      cell->neighbor_child_on_subface(f, sf)
+                        ->active_cell_index());
+              }
+            face_neighbor_offsets[index + 1] = face_neighbors_data.size();
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ActiveCellTopology<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(cell_level_index) +
+           MemoryConsumption::memory_consumption(vertex_offsets) +
+           MemoryConsumption::memory_consumption(vertex_indices_data) +
+           MemoryConsumption::memory_consumption(face_offsets) +
+           MemoryConsumption::memory_consumption(face_neighbor_offsets) +
+           MemoryConsumption::memory_consumption(face_neighbors_data) +
+           MemoryConsumption::memory_consumption(face_orientations);
+  }
+
+#include "grid_tools_active_cell_topology.inst"
+
+} // namespace GridTools
+
+DEAL_II_NAMESPACE_CLOSE
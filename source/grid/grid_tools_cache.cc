@@ -20,19 +20,87 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
+DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
+#include <boost/geometry/algorithms/equals.hpp>
+DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <algorithm>
+#include <set>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  namespace
+  {
+    /**
+     * Append the vertices of the given cell to the list, together with the
+     * hanging vertices on its faces and, in 3d, on its edges. These are all
+     * the vertices for which GridTools::vertex_to_cell_map() can list the
+     * cell or one of its neighbors.
+     */
+    template <int dim, int spacedim>
+    void
+    append_vertices_and_hanging_vertices(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      std::vector<unsigned int> &                                 vertices)
+    {
+      for (const unsigned int v : cell->vertex_indices())
+        vertices.push_back(cell->vertex_index(v));
+
+      if (dim > 1)
+        for (const auto &face : cell->face_iterators())
+          if (face->has_children())
+            for (unsigned int c = 0; c < face->n_children(); ++c)
+              for (const unsigned int v : face->child(c)->vertex_indices())
+                vertices.push_back(face->child(c)->vertex_index(v));
+
+      if (dim == 3)
+        for (unsigned int l = 0; l < cell->n_lines(); ++l)
+          if (cell->line(l)->has_children())
+            vertices.push_back(cell->line(l)->child(0)->vertex_index(1));
+    }
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
     : update_flags(update_all)
     , tria(&tria)
     , mapping(&mapping)
+    , incremental_update_flags(update_nothing)
+    , refinement_handled(false)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signal = tria.signals.any_change.connect([&]() {
+      if (refinement_handled)
+        refinement_handled = false;
+      else
+        mark_for_update(update_all);
+    });
+
+    // For serial triangulations, follow the changes of the active cells
+    // during refinement. Parallel triangulations also change the ownership
+    // of cells, so we rebuild everything for them. The post_refinement
+    // signal needs to be connected at the front, such that it runs before
+    // the any_change signal that is triggered by it.
+    if (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+          &tria) == nullptr)
+      {
+        using cell_iterator =
+          typename Triangulation<dim, spacedim>::cell_iterator;
+        refinement_signals.push_back(
+          tria.signals.pre_refinement.connect([&]() { pre_refinement(); }));
+        refinement_signals.push_back(
+          tria.signals.pre_coarsening_on_cell.connect(
+            [&](const cell_iterator &cell) { pre_coarsening_on_cell(cell); }));
+        refinement_signals.push_back(
+          tria.signals.post_refinement_on_cell.connect(
+            [&](const cell_iterator &cell) { post_refinement_on_cell(cell); }));
+        refinement_signals.push_back(tria.signals.post_refinement.connect(
+          [&]() { post_refinement(); }, boost::signals2::at_front));
+      }
   }
 
   template <int dim, int spacedim>
@@ -42,6 +110,251 @@ namespace GridTools
     // is removed here.
     if (tria_signal.connected())
       tria_signal.disconnect();
+    for (auto &signal : refinement_signals)
+      if (signal.connected())
+        signal.disconnect();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::pre_refinement()
+  {
+    // only the objects that are currently up to date need to be updated
+    incremental_update_flags = update_nothing;
+    for (const CacheUpdateFlags flag : {update_vertex_to_cell_map,
+                                        update_used_vertices,
+                                        update_used_vertices_rtree,
+                                        update_cell_bounding_boxes_rtree})
+      if ((update_flags & flag) == 0)
+        incremental_update_flags |= flag;
+
+    // the R-tree of the vertices is updated together with the map of used
+    // vertices
+    if (update_flags & update_used_vertices)
+      incremental_update_flags &= ~update_used_vertices_rtree;
+
+    removed_cells.clear();
+    coarsened_cells.clear();
+    refined_cells.clear();
+    affected_vertices.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::pre_coarsening_on_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    coarsened_cells.push_back(cell);
+    for (const auto &child : cell->child_iterators())
+      {
+        removed_cells.emplace_back(child, BoundingBox<spacedim>());
+        if (incremental_update_flags & update_cell_bounding_boxes_rtree)
+          removed_cells.back().second = mapping->get_bounding_box(child);
+        append_vertices_and_hanging_vertices<dim, spacedim>(child,
+                                                            affected_vertices);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::post_refinement_on_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    // the vertices of the cell itself are collected at the end of the
+    // refinement cycle together with the ones of its children
+    refined_cells.push_back(cell);
+    removed_cells.emplace_back(cell, BoundingBox<spacedim>());
+    if (incremental_update_flags & update_cell_bounding_boxes_rtree)
+      removed_cells.back().second = mapping->get_bounding_box(cell);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::post_refinement()
+  {
+    using cell_iterator =
+      typename Triangulation<dim, spacedim>::cell_iterator;
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const CacheUpdateFlags incremental_flags = incremental_update_flags;
+    incremental_update_flags                 = update_nothing;
+
+    // mark everything that is not updated here, and make sure that the
+    // any_change signal following this one does not mark the rest
+    mark_for_update(update_all & ~incremental_flags);
+    refinement_handled = true;
+    if (incremental_flags == update_nothing)
+      return;
+
+    std::vector<active_cell_iterator> added_cells;
+    for (const auto &cell : coarsened_cells)
+      added_cells.emplace_back(cell);
+    for (const auto &cell : refined_cells)
+      {
+        append_vertices_and_hanging_vertices<dim, spacedim>(cell,
+                                                            affected_vertices);
+        for (const auto &child : cell->child_iterators())
+          added_cells.emplace_back(child);
+      }
+    for (const auto &cell : added_cells)
+      append_vertices_and_hanging_vertices<dim, spacedim>(cell,
+                                                          affected_vertices);
+    std::sort(affected_vertices.begin(), affected_vertices.end());
+    affected_vertices.erase(std::unique(affected_vertices.begin(),
+                                        affected_vertices.end()),
+                            affected_vertices.end());
+
+    const std::set<cell_iterator> removed_cell_set = [&]() {
+      std::set<cell_iterator> cells;
+      for (const auto &cell : removed_cells)
+        cells.insert(cell.first);
+      return cells;
+    }();
+
+    if (incremental_flags & update_vertex_to_cell_map)
+      {
+        // The entries of the vertices around the cells that changed are
+        // computed again in the same way as GridTools::vertex_to_cell_map()
+        // does, using only the cells that list one of these vertices. These
+        // are the cells that are still active of the present entries, and
+        // the new cells.
+        vertex_to_cells.resize(tria->n_vertices());
+        std::vector<bool> vertex_affected(tria->n_vertices(), false);
+        std::set<active_cell_iterator> cells(added_cells.begin(),
+                                             added_cells.end());
+        for (const unsigned int v : affected_vertices)
+          if (v < vertex_to_cells.size())
+            {
+              vertex_affected[v] = true;
+              for (const auto &cell : vertex_to_cells[v])
+                if (removed_cell_set.find(cell) == removed_cell_set.end())
+                  cells.insert(cell);
+              vertex_to_cells[v].clear();
+            }
+
+        for (const auto &cell : cells)
+          {
+            for (const unsigned int v : cell->vertex_indices())
+              if (vertex_affected[cell->vertex_index(v)])
+                vertex_to_cells[cell->vertex_index(v)].insert(cell);
+
+            for (const unsigned int f : cell->face_indices())
+              if (cell->at_boundary(f) == false &&
+                  cell->neighbor(f)->is_active())
+                for (const unsigned int v : cell->face(f)->vertex_indices())
+                  if (vertex_affected[cell->face(f)->vertex_index(v)])
+                    vertex_to_cells[cell->face(f)->vertex_index(v)].insert(
+                      cell->neighbor(f));
+
+            if (dim == 3)
+              for (unsigned int l = 0; l < cell->n_lines(); ++l)
+                if (cell->line(l)->has_children() &&
+                    vertex_affected[cell->line(l)->child(0)->vertex_index(1)])
+                  vertex_to_cells[cell->line(l)->child(0)->vertex_index(1)]
+                    .insert(cell);
+          }
+      }
+
+    if (incremental_flags & update_used_vertices)
+      {
+        const bool update_rtree =
+          (incremental_flags & update_used_vertices_rtree) != 0;
+
+        // remove the vertices that are no longer used
+        for (const unsigned int v : affected_vertices)
+          if (v >= tria->n_vertices() || tria->vertex_used(v) == false)
+            {
+              const auto entry = used_vertices.find(v);
+              if (entry != used_vertices.end())
+                {
+                  if (update_rtree)
+                    used_vertices_rtree.remove(
+                      std::make_pair(entry->second, entry->first));
+                  used_vertices.erase(entry);
+                }
+            }
+
+        // then add the vertices of the new cells. as vertex indices can be
+        // re-used within a refinement cycle, also replace existing entries
+        // whose location has changed
+        for (const auto &cell : added_cells)
+          {
+            const auto vertices = mapping->get_vertices(cell);
+            for (unsigned int i = 0; i < vertices.size(); ++i)
+              {
+                const unsigned int v     = cell->vertex_index(i);
+                const auto         entry = used_vertices.find(v);
+                if (entry != used_vertices.end() &&
+                    entry->second == vertices[i])
+                  continue;
+                if (entry != used_vertices.end())
+                  {
+                    if (update_rtree)
+                      used_vertices_rtree.remove(
+                        std::make_pair(entry->second, entry->first));
+                    used_vertices.erase(entry);
+                  }
+                used_vertices.emplace(v, vertices[i]);
+                if (update_rtree)
+                  used_vertices_rtree.insert(std::make_pair(vertices[i], v));
+              }
+          }
+      }
+
+    if (incremental_flags & update_cell_bounding_boxes_rtree)
+      {
+        namespace bgi = boost::geometry::index;
+
+        // the bounding boxes of the removed cells are only used to find
+        // the entries in the tree, which are identified by the cell
+        bool all_found = true;
+        for (const auto &removed : removed_cells)
+          {
+            std::vector<std::pair<BoundingBox<spacedim>, active_cell_iterator>>
+              entries;
+            cell_bounding_boxes_rtree.query(
+              bgi::intersects(removed.second) &&
+                bgi::satisfies(
+                  [&](const std::pair<BoundingBox<spacedim>,
+                                      active_cell_iterator> &entry) {
+                    return cell_iterator(entry.second) == removed.first;
+                  }),
+              std::back_inserter(entries));
+            if (entries.size() != 1)
+              {
+                all_found = false;
+                break;
+              }
+            cell_bounding_boxes_rtree.remove(entries[0]);
+          }
+
+        if (all_found)
+          for (const auto &cell : added_cells)
+            cell_bounding_boxes_rtree.insert(
+              std::make_pair(mapping->get_bounding_box(cell), cell));
+        else
+          mark_for_update(update_cell_bounding_boxes_rtree);
+      }
+
+    removed_cells.clear();
+    coarsened_cells.clear();
+    refined_cells.clear();
+    affected_vertices.clear();
   }
 
 
@@ -218,6 +531,20 @@ namespace GridTools
     return vertex_to_neighbor_subdomain;
   }
 
+
+
+  template <int dim, int spacedim>
+  const ActiveCellTopology<dim, spacedim> &
+  Cache<dim, spacedim>::get_active_cell_topology() const
+  {
+    if (update_flags & update_active_cell_topology)
+      {
+        active_cell_topology.reinit(*tria);
+        update_flags = update_flags & ~update_active_cell_topology;
+      }
+    return active_cell_topology;
+  }
+
 #include "grid_tools_cache.inst"
 
 } // namespace GridTools
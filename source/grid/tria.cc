@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -5041,6 +5042,38 @@ namespace internal
       }
 
 
+      /**
+       * Compute the locations of the vertices that are created in the
+       * centers of the given objects upon refinement, respecting the
+       * manifold attached to each object. Simplices do not get a new vertex
+       * in their interior, so the entries for them are left at the origin.
+       *
+       * Evaluating the manifold is the most expensive part of the
+       * refinement of a mesh, and the new points of different objects are
+       * independent of each other. Hence, the work is distributed to the
+       * available threads. Only the points are computed here; the children
+       * are still created one object after the other by the caller.
+       */
+      template <typename Iterator>
+      static std::vector<Point<Iterator::AccessorType::space_dimension>>
+      compute_new_vertex_locations(const std::vector<Iterator> &objects,
+                                   const bool use_interpolation)
+      {
+        std::vector<Point<Iterator::AccessorType::space_dimension>> locations(
+          objects.size());
+        dealii::parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(objects.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              if (objects[i]->reference_cell().is_hyper_cube())
+                locations[i] = objects[i]->center(true, use_interpolation);
+          },
+          128);
+        return locations;
+      }
+
+
       template <int spacedim>
       static typename Triangulation<3, spacedim>::DistortedCellList
       execute_refinement_isotropic(Triangulation<3, spacedim> &triangulation,
@@ -5268,21 +5301,32 @@ namespace internal
 
         // LINES
         {
-          typename Triangulation<dim, spacedim>::active_line_iterator
-            line = triangulation.begin_active_line(),
-            endl = triangulation.end_line();
+          // the new vertices on the lines only depend on the existing
+          // vertices, so they can all be computed before creating the
+          // children
+          std::vector<
+            typename Triangulation<dim, spacedim>::active_line_iterator>
+            refined_lines;
+          for (typename Triangulation<dim, spacedim>::active_line_iterator
+                 line = triangulation.begin_active_line();
+               line != triangulation.end_line();
+               ++line)
+            if (line->user_flag_set())
+              refined_lines.push_back(line);
+          const std::vector<Point<spacedim>> line_centers =
+            compute_new_vertex_locations(refined_lines, false);
+
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
-          for (; line != endl; ++line)
+          for (unsigned int l = 0; l < refined_lines.size(); ++l)
             {
-              if (line->user_flag_set() == false)
-                continue;
+              const auto &line = refined_lines[l];
 
               current_vertex =
                 get_next_unused_vertex(current_vertex,
                                        triangulation.vertices_used);
-              triangulation.vertices[current_vertex] = line->center(true);
+              triangulation.vertices[current_vertex] = line_centers[l];
 
               next_unused_line =
                 triangulation.faces->lines.template next_free_pair_object<1>(
@@ -5327,18 +5371,27 @@ namespace internal
 
         // QUADS
         {
-          typename Triangulation<dim, spacedim>::quad_iterator
-            quad = triangulation.begin_quad(),
-            endq = triangulation.end_quad();
+          // the new vertices in the centers of the quads are interpolated
+          // from the vertices and the line midpoints created above
+          std::vector<typename Triangulation<dim, spacedim>::quad_iterator>
+            refined_quads;
+          for (typename Triangulation<dim, spacedim>::quad_iterator quad =
+                 triangulation.begin_quad();
+               quad != triangulation.end_quad();
+               ++quad)
+            if (quad->user_flag_set())
+              refined_quads.push_back(quad);
+          const std::vector<Point<spacedim>> quad_centers =
+            compute_new_vertex_locations(refined_quads, true);
+
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
           typename Triangulation<dim, spacedim>::raw_quad_iterator
             next_unused_quad = triangulation.begin_raw_quad();
 
-          for (; quad != endq; ++quad)
+          for (unsigned int q = 0; q < refined_quads.size(); ++q)
             {
-              if (quad->user_flag_set() == false)
-                continue;
+              const auto &quad = refined_quads[q];
 
               const auto reference_face_type = quad->reference_cell();
 
@@ -5348,8 +5401,7 @@ namespace internal
                   current_vertex =
                     get_next_unused_vertex(current_vertex,
                                            triangulation.vertices_used);
-                  triangulation.vertices[current_vertex] =
-                    quad->center(true, true);
+                  triangulation.vertices[current_vertex] = quad_centers[q];
                 }
 
               // 2) create new lines (property is set later)
@@ -5626,6 +5678,18 @@ namespace internal
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // the new vertices in the centers of the cells are interpolated from
+        // the vertices on the lines and faces, which all exist by now. the
+        // cells are collected in the same order as they are refined below
+        std::vector<typename Triangulation<dim, spacedim>::active_hex_iterator>
+          refined_hexes;
+        for (const auto &hex : triangulation.active_cell_iterators())
+          if (hex->refine_flag_set() != RefinementCase<dim>::no_refinement)
+            refined_hexes.push_back(hex);
+        const std::vector<Point<spacedim>> hex_centers =
+          compute_new_vertex_locations(refined_hexes, true);
+        unsigned int n_refined_hexes = 0;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -5641,6 +5705,11 @@ namespace internal
                     RefinementCase<dim>::no_refinement)
                   continue;
 
+                Assert(hex == refined_hexes[n_refined_hexes],
+                       ExcInternalError());
+                const Point<spacedim> &hex_center =
+                  hex_centers[n_refined_hexes++];
+
                 const auto &reference_cell_type = hex->reference_cell();
 
                 const RefinementCase<dim> ref_case = hex->refine_flag_set();
@@ -5672,8 +5741,7 @@ namespace internal
                     current_vertex =
                       get_next_unused_vertex(current_vertex,
                                              triangulation.vertices_used);
-                    triangulation.vertices[current_vertex] =
-                      hex->center(true, true);
+                    triangulation.vertices[current_vertex] = hex_center;
                   }
 
                 boost::container::small_vector<
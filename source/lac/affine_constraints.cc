@@ -52,27 +52,43 @@ DEAL_II_NAMESPACE_OPEN
     const FullMatrix<VectorType::value_type> &,                                \
     bool) const
 
-#define INSTANTIATE_DLTG_VECTORMATRIX(MatrixType, VectorType) \
-  template void AffineConstraints<MatrixType::value_type>::   \
-    distribute_local_to_global<MatrixType, VectorType>(       \
-      const FullMatrix<MatrixType::value_type> &,             \
-      const Vector<VectorType::value_type> &,                 \
-      const std::vector<AffineConstraints::size_type> &,      \
-      MatrixType &,                                           \
-      VectorType &,                                           \
-      bool,                                                   \
-      std::integral_constant<bool, false>) const
-
-#define INSTANTIATE_DLTG_BLOCK_VECTORMATRIX(MatrixType, VectorType) \
-  template void AffineConstraints<MatrixType::value_type>::         \
-    distribute_local_to_global<MatrixType, VectorType>(             \
-      const FullMatrix<MatrixType::value_type> &,                   \
-      const Vector<VectorType::value_type> &,                       \
-      const std::vector<AffineConstraints::size_type> &,            \
-      MatrixType &,                                                 \
-      VectorType &,                                                 \
-      bool,                                                         \
-      std::integral_constant<bool, true>) const
+#define INSTANTIATE_DLTG_VECTORMATRIX(MatrixType, VectorType)             \
+  template void AffineConstraints<MatrixType::value_type>::               \
+    distribute_local_to_global<MatrixType, VectorType>(                   \
+      const FullMatrix<MatrixType::value_type> &,                         \
+      const Vector<VectorType::value_type> &,                             \
+      const std::vector<AffineConstraints::size_type> &,                  \
+      MatrixType &,                                                       \
+      VectorType &,                                                       \
+      bool,                                                               \
+      std::integral_constant<bool, false>) const;                         \
+  template void AffineConstraints<MatrixType::value_type>::               \
+    distribute_local_to_global<MatrixType, VectorType>(                   \
+      const ArrayView<const FullMatrix<MatrixType::value_type>> &,        \
+      const ArrayView<const Vector<MatrixType::value_type>> &,            \
+      const ArrayView<const std::vector<AffineConstraints::size_type>> &, \
+      MatrixType &,                                                       \
+      VectorType &,                                                       \
+      bool) const
+
+#define INSTANTIATE_DLTG_BLOCK_VECTORMATRIX(MatrixType, VectorType)       \
+  template void AffineConstraints<MatrixType::value_type>::               \
+    distribute_local_to_global<MatrixType, VectorType>(                   \
+      const FullMatrix<MatrixType::value_type> &,                         \
+      const Vector<VectorType::value_type> &,                             \
+      const std::vector<AffineConstraints::size_type> &,                  \
+      MatrixType &,                                                       \
+      VectorType &,                                                       \
+      bool,                                                               \
+      std::integral_constant<bool, true>) const;                          \
+  template void AffineConstraints<MatrixType::value_type>::               \
+    distribute_local_to_global<MatrixType, VectorType>(                   \
+      const ArrayView<const FullMatrix<MatrixType::value_type>> &,        \
+      const ArrayView<const Vector<MatrixType::value_type>> &,            \
+      const ArrayView<const std::vector<AffineConstraints::size_type>> &, \
+      MatrixType &,                                                       \
+      VectorType &,                                                       \
+      bool) const
 
 #define INSTANTIATE_DLTG_MATRIX(MatrixType)                              \
   template void                                                          \
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -37,6 +38,35 @@ __declspec(selectany) // Weak extern binding due to multiple link error
   const SparsityPatternBase::size_type SparsityPatternBase::invalid_entry;
 
 
+
+namespace internal
+{
+  namespace SparsityPatternImplementation
+  {
+    /**
+     * Run the function @p f on subranges of the rows [0, @p n_rows), possibly
+     * in parallel. The subranges are formed with the same grain size as the
+     * ones of the matrix-vector products of SparseMatrix, such that the
+     * memory pages of the row data that are touched first by a thread in the
+     * setup of the sparsity pattern tend to be the ones that the same thread
+     * later works on in SparseMatrix::vmult(). With first-touch memory
+     * policies on NUMA systems, this places the pages close to that thread.
+     */
+    template <typename Function>
+    void
+    apply_to_row_subranges(const SparsityPatternBase::size_type n_rows,
+                           const Function &                     f)
+    {
+      parallel::apply_to_subranges(
+        SparsityPatternBase::size_type(0),
+        n_rows,
+        f,
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    }
+  } // namespace SparsityPatternImplementation
+} // namespace internal
+
+
 SparsityPatternBase::SparsityPatternBase()
   : max_dim(0)
   , rows(0)
@@ -294,40 +324,58 @@ SparsityPattern::reinit(const size_type                      m,
   // case we get an exception and the destructor of this object will be called
   // -- where we look at the non-nullness of the (now invalid) pointer again
   // and try to delete the memory a second time.
+  //
+  // the arrays are allocated without initialization here; their entries are
+  // written below on the threads that will later work on the respective
+  // rows, which is important for the placement of the memory on NUMA systems
   if (rows > max_dim)
     {
-      max_dim  = rows;
-      rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
+      max_dim = rows;
+      rowstart.reset(new std::size_t[max_dim + 1]);
     }
 
   // allocate memory for the column numbers if necessary
   if (vec_len > max_vec_len)
     {
       max_vec_len = vec_len;
-      colnums     = std::make_unique<size_type[]>(max_vec_len);
+      colnums.reset(new size_type[max_vec_len]);
     }
 
-  // set the rowstart array
-  rowstart[0] = 0;
-  for (size_type i = 1; i <= rows; ++i)
-    rowstart[i] =
-      rowstart[i - 1] +
-      (store_diagonal_first_in_row ?
-         std::max(std::min(static_cast<size_type>(row_lengths[i - 1]), n),
-                  static_cast<size_type>(1U)) :
-         std::min(static_cast<size_type>(row_lengths[i - 1]), n));
+  // set the rowstart array: first write the length of each row on the
+  // threads that own the rows, then form the row starts by a prefix sum
+  // over the memory that has been touched already
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    rows, [this, &row_lengths, n](const size_type begin, const size_type end) {
+      if (begin == 0)
+        rowstart[0] = 0;
+      for (size_type i = begin; i < end; ++i)
+        rowstart[i + 1] =
+          (store_diagonal_first_in_row ?
+             std::max(std::min(static_cast<size_type>(row_lengths[i]), n),
+                      static_cast<size_type>(1U)) :
+             std::min(static_cast<size_type>(row_lengths[i]), n));
+    });
+  std::partial_sum(rowstart.get(),
+                   rowstart.get() + rows + 1,
+                   rowstart.get());
   Assert((rowstart[rows] == vec_len) ||
            ((vec_len == 1) && (rowstart[rows] == 0)),
          ExcInternalError());
 
-  // preset the column numbers by a value indicating it is not in use
-  std::fill_n(colnums.get(), vec_len, invalid_entry);
-
-  // if diagonal elements are special: let the first entry in each row be the
+  // preset the column numbers by a value indicating it is not in use. if
+  // diagonal elements are special: let the first entry in each row be the
   // diagonal value
-  if (store_diagonal_first_in_row)
-    for (size_type i = 0; i < rows; ++i)
-      colnums[rowstart[i]] = i;
+  if (rowstart[rows] == 0)
+    colnums[0] = invalid_entry;
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    rows, [this](const size_type begin, const size_type end) {
+      std::fill(colnums.get() + rowstart[begin],
+                colnums.get() + rowstart[end],
+                invalid_entry);
+      if (store_diagonal_first_in_row)
+        for (size_type i = begin; i < end; ++i)
+          colnums[rowstart[i]] = i;
+    });
 
   compressed = false;
 }
@@ -348,83 +396,88 @@ SparsityPattern::compress()
   if (compressed)
     return;
 
-  size_type next_free_entry = 0, next_row_start = 0, row_length = 0;
-
-  // first find out how many non-zero elements there are, in order to allocate
-  // the right amount of memory
-  const std::size_t nonzero_elements =
-    std::count_if(&colnums[rowstart[0]],
-                  &colnums[rowstart[rows]],
-                  [](const size_type col) { return col != invalid_entry; });
-  // now allocate the respective memory
+  // first find out how many non-zero elements there are in each row, in
+  // order to allocate the right amount of memory. the used entries of a row
+  // are the ones before the first unused entry
+  std::vector<std::size_t> new_rowstart(rows + 1);
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    rows, [this, &new_rowstart](const size_type begin, const size_type end) {
+      for (size_type line = begin; line < end; ++line)
+        new_rowstart[line + 1] =
+          std::find(&colnums[rowstart[line]],
+                    &colnums[rowstart[line + 1]],
+                    invalid_entry) -
+          &colnums[rowstart[line]];
+    });
+  new_rowstart[0] = 0;
+  std::partial_sum(new_rowstart.begin(),
+                   new_rowstart.end(),
+                   new_rowstart.begin());
+  const std::size_t nonzero_elements = new_rowstart[rows];
+
+  // now allocate the respective memory. do not initialize the memory here,
+  // as the first touch should happen on the threads filling the rows below
   std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
 
-
-  // reserve temporary storage to store the entries of one row
-  std::vector<size_type> tmp_entries(max_row_length);
-
-  // Traverse all rows
-  for (size_type line = 0; line < rows; ++line)
-    {
-      // copy used entries, break if first unused entry is reached
-      row_length = 0;
-      for (size_type j = rowstart[line]; j < rowstart[line + 1];
-           ++j, ++row_length)
-        if (colnums[j] != invalid_entry)
-          tmp_entries[row_length] = colnums[j];
-        else
-          break;
-      // now @p{rowstart} is the number of entries in this line
-
-      // Sort only beginning at the second entry, if optimized storage of
-      // diagonal entries is on.
-
-      // if this line is empty or has only one entry, don't sort
-      if (row_length > 1)
-        std::sort((store_diagonal_first_in_row) ? tmp_entries.begin() + 1 :
-                                                  tmp_entries.begin(),
-                  tmp_entries.begin() + row_length);
-
-      // insert column numbers into the new field
-      for (size_type j = 0; j < row_length; ++j)
-        new_colnums[next_free_entry++] = tmp_entries[j];
-
-      // note new start of this and the next row
-      rowstart[line] = next_row_start;
-      next_row_start = next_free_entry;
-
-      // some internal checks: either the matrix is not quadratic, or if it
-      // is, then the first element of this row must be the diagonal element
-      // (i.e. with column index==line number)
-      // this test only makes sense if we have written to the index
-      // rowstart_line in new_colnums which is the case if row_length is not 0,
-      // so check this first
-      Assert((!store_diagonal_first_in_row) ||
-               (row_length != 0 && new_colnums[rowstart[line]] == line),
-             ExcInternalError());
-      // assert that the first entry does not show up in the remaining ones
-      // and that the remaining ones are unique among themselves (this handles
-      // both cases, quadratic and rectangular matrices)
-      //
-      // the only exception here is if the row contains no entries at all
-      Assert((rowstart[line] == next_row_start) ||
-               (std::find(&new_colnums[rowstart[line] + 1],
-                          &new_colnums[next_row_start],
-                          new_colnums[rowstart[line]]) ==
-                &new_colnums[next_row_start]),
-             ExcInternalError());
-      Assert((rowstart[line] == next_row_start) ||
-               (std::adjacent_find(&new_colnums[rowstart[line] + 1],
-                                   &new_colnums[next_row_start]) ==
-                &new_colnums[next_row_start]),
-             ExcInternalError());
-    }
-
-  // assert that we have used all allocated space, no more and no less
-  Assert(next_free_entry == nonzero_elements, ExcInternalError());
-
-  // set iterator-past-the-end
-  rowstart[rows] = next_row_start;
+  // Traverse all rows and copy the used entries, sorted
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    rows,
+    [this, &new_rowstart, &new_colnums](const size_type begin,
+                                        const size_type end) {
+      for (size_type line = begin; line < end; ++line)
+        {
+          const std::size_t row_start      = new_rowstart[line];
+          const std::size_t next_row_start = new_rowstart[line + 1];
+          const size_type   row_length     = next_row_start - row_start;
+          std::copy(&colnums[rowstart[line]],
+                    &colnums[rowstart[line]] + row_length,
+                    &new_colnums[row_start]);
+
+          // Sort only beginning at the second entry, if optimized storage of
+          // diagonal entries is on.
+
+          // if this line is empty or has only one entry, don't sort
+          if (row_length > 1)
+            std::sort(&new_colnums[row_start] +
+                        (store_diagonal_first_in_row ? 1 : 0),
+                      &new_colnums[next_row_start]);
+
+          // some internal checks: either the matrix is not quadratic, or if
+          // it is, then the first element of this row must be the diagonal
+          // element (i.e. with column index==line number)
+          // this test only makes sense if we have written to the index
+          // row_start in new_colnums which is the case if row_length is not
+          // 0, so check this first
+          Assert((!store_diagonal_first_in_row) ||
+                   (row_length != 0 && new_colnums[row_start] == line),
+                 ExcInternalError());
+          // assert that the first entry does not show up in the remaining
+          // ones and that the remaining ones are unique among themselves
+          // (this handles both cases, quadratic and rectangular matrices)
+          //
+          // the only exception here is if the row contains no entries at all
+          Assert((row_start == next_row_start) ||
+                   (std::find(&new_colnums[row_start + 1],
+                              &new_colnums[next_row_start],
+                              new_colnums[row_start]) ==
+                    &new_colnums[next_row_start]),
+                 ExcInternalError());
+          Assert((row_start == next_row_start) ||
+                   (std::adjacent_find(&new_colnums[row_start + 1],
+                                       &new_colnums[next_row_start]) ==
+                    &new_colnums[next_row_start]),
+                 ExcInternalError());
+        }
+    });
+
+  // set the new row starts, again on the threads that own the rows
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    rows, [this, &new_rowstart](const size_type begin, const size_type end) {
+      std::copy(new_rowstart.begin() + begin + 1,
+                new_rowstart.begin() + end + 1,
+                rowstart.get() + begin + 1);
+    });
+  rowstart[0] = 0;
 
   // set colnums to the newly allocated array and delete previous content
   // in the process
@@ -494,20 +547,14 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
   std::vector<unsigned int> row_lengths(dsp.n_rows());
 
-  if (row_index_set.size() == 0)
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
+  // make sure the index set is compressed before it is queried from several
+  // threads
+  row_index_set.compress();
+  internal::SparsityPatternImplementation::apply_to_row_subranges(
+    dsp.n_rows(), [&](const size_type begin, const size_type end) {
+      for (size_type i = begin; i < end; ++i)
         {
-          row_lengths[i] = dsp.row_length(i);
-          if (do_diag_optimize && !dsp.exists(i, i))
-            ++row_lengths[i];
-        }
-    }
-  else
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
-        {
-          if (row_index_set.is_element(i))
+          if (row_index_set.size() == 0 || row_index_set.is_element(i))
             {
               row_lengths[i] = dsp.row_length(i);
               if (do_diag_optimize && !dsp.exists(i, i))
@@ -522,21 +569,27 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
               row_lengths[i] = do_diag_optimize ? 1 : 0;
             }
         }
-    }
+    });
   reinit(dsp.n_rows(), dsp.n_cols(), row_lengths);
 
+  // fill the rows with the same subranges as in reinit(), in order to let
+  // the threads work on the memory they touched first
   if (n_rows() != 0 && n_cols() != 0)
-    for (size_type row = 0; row < dsp.n_rows(); ++row)
-      {
-        size_type *cols = &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
-        const unsigned int row_length = dsp.row_length(row);
-        for (unsigned int index = 0; index < row_length; ++index)
+    internal::SparsityPatternImplementation::apply_to_row_subranges(
+      dsp.n_rows(), [&](const size_type begin, const size_type end) {
+        for (size_type row = begin; row < end; ++row)
           {
-            const size_type col = dsp.column_number(row, index);
-            if ((col != row) || !do_diag_optimize)
-              *cols++ = col;
+            size_type *cols =
+              &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+            const unsigned int row_length = dsp.row_length(row);
+            for (unsigned int index = 0; index < row_length; ++index)
+              {
+                const size_type col = dsp.column_number(row, index);
+                if ((col != row) || !do_diag_optimize)
+                  *cols++ = col;
+              }
           }
-      }
+      });
 
   // do not need to compress the sparsity pattern since we already have
   // allocated the right amount of data, and the SparsityPatternType data is
@@ -847,6 +847,76 @@ namespace internal
 
 
 
+    void
+    DoFInfo::increase_vectorization_length(const unsigned int n_lanes)
+    {
+      Assert(n_lanes >= vectorization_length,
+             ExcMessage("The vectorization length can only be increased."));
+      if (n_lanes == vectorization_length)
+        return;
+
+      const unsigned int n_components = start_components.back();
+      const unsigned int old_lanes    = vectorization_length;
+      const unsigned int n_batches =
+        n_vectorization_lanes_filled[dof_access_cell].size();
+      AssertDimension(row_starts.size(),
+                      n_batches * old_lanes * n_components + 1);
+
+      // the rows of the new lanes are empty and start where the next batch
+      // starts
+      std::vector<std::pair<unsigned int, unsigned int>> new_row_starts(
+        n_batches * n_lanes * n_components + 1);
+      for (unsigned int i = 0; i < n_batches; ++i)
+        for (unsigned int j = 0; j < n_lanes; ++j)
+          for (unsigned int comp = 0; comp < n_components; ++comp)
+            new_row_starts[(i * n_lanes + j) * n_components + comp] =
+              row_starts[j < old_lanes ?
+                           (i * old_lanes + j) * n_components + comp :
+                           (i + 1) * old_lanes * n_components];
+      new_row_starts.back() = row_starts.back();
+      row_starts.swap(new_row_starts);
+
+      // fill the data stored per lane into the new layout
+      const auto spread_lanes = [&](auto &data, const auto &empty_value) {
+        std::remove_reference_t<decltype(data)> new_data(
+          data.size() / old_lanes * n_lanes, empty_value);
+        for (unsigned int i = 0; i < data.size() / old_lanes; ++i)
+          for (unsigned int j = 0; j < old_lanes; ++j)
+            new_data[i * n_lanes + j] = data[i * old_lanes + j];
+        data.swap(new_data);
+      };
+
+      spread_lanes(hanging_node_constraint_masks,
+                   unconstrained_compressed_constraint_kind);
+      if (row_starts_plain_indices.empty() == false)
+        {
+          row_starts_plain_indices.pop_back();
+          spread_lanes(row_starts_plain_indices, numbers::invalid_unsigned_int);
+          row_starts_plain_indices.push_back(numbers::invalid_unsigned_int);
+        }
+      for (auto &indices : dof_indices_contiguous_sm)
+        spread_lanes(indices,
+                     std::make_pair(numbers::invalid_unsigned_int,
+                                    numbers::invalid_unsigned_int));
+
+      std::vector<unsigned char> irregular_cells(n_batches);
+      for (unsigned int i = 0; i < n_batches; ++i)
+        irregular_cells[i] = n_vectorization_lanes_filled[dof_access_cell][i];
+
+      vectorization_length = n_lanes;
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+          index_storage_variants[i].clear();
+          dof_indices_contiguous[i].clear();
+          dof_indices_interleave_strides[i].clear();
+          n_vectorization_lanes_filled[i].clear();
+        }
+      dof_indices_interleaved.clear();
+      compute_cell_index_compression(irregular_cells);
+    }
+
+
+
     void
     DoFInfo::compute_tight_partitioners(
       const Table<2, ShapeInfo<double>> &       shape_info,
@@ -1496,6 +1566,15 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
     }
+
+
+
+    std::size_t
+    DoFInfoCollection::memory_consumption() const
+    {
+      return sizeof(*this) + MemoryConsumption::memory_consumption(*data);
+    }
+
   } // namespace MatrixFreeFunctions
 } // namespace internal
 
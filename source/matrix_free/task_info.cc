@@ -28,11 +28,15 @@
 #  include <tbb/blocked_range.h>
 #  include <tbb/parallel_for.h>
 #  include <tbb/task.h>
+#  include <tbb/task_group.h>
 #  ifndef DEAL_II_TBB_WITH_ONEAPI
 #    include <tbb/task_scheduler_init.h>
 #  endif
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <set>
 
@@ -344,6 +348,131 @@ namespace internal
 
 
 
+#ifdef DEAL_II_WITH_TBB
+
+    // This defines the scheduler of the work_stealing variant. Rather than
+    // building a static tree of tasks, each task of the graph set up in
+    // TaskInfo::setup_work_stealing_graph() has a counter of unfinished
+    // predecessors. Once the counter reaches zero, the task is handed to a
+    // tbb::task_group, whose threads steal work from each other when they run
+    // idle.
+
+    namespace work_stealing
+    {
+      class Scheduler
+      {
+      public:
+        Scheduler(MFWorkerInterface &worker,
+                  const TaskInfo &   task_info,
+                  const bool         record_times)
+          : worker(worker)
+          , task_info(task_info)
+          , priorities(task_info.get_task_priorities())
+          , record_times(record_times)
+          , n_chunks(task_info.partition_row_index.back())
+          , n_pending(task_info.task_n_predecessors.size())
+        {
+          for (unsigned int i = 0; i < n_pending.size(); ++i)
+            n_pending[i].store(task_info.task_n_predecessors[i],
+                               std::memory_order_relaxed);
+        }
+
+        void
+        run()
+        {
+          // spawn the tasks without predecessors with the highest priority
+          // first, as idle threads steal the oldest tasks
+          std::vector<unsigned int> ready_tasks;
+          for (unsigned int i = 0; i < n_pending.size(); ++i)
+            if (task_info.task_n_predecessors[i] == 0)
+              ready_tasks.push_back(i);
+          std::stable_sort(ready_tasks.begin(),
+                           ready_tasks.end(),
+                           [&](const unsigned int a, const unsigned int b) {
+                             return (*priorities)[a] > (*priorities)[b];
+                           });
+          for (const unsigned int task : ready_tasks)
+            task_group.run([this, task]() { execute(task); });
+          task_group.wait();
+        }
+
+      private:
+        void
+        execute(unsigned int task)
+        {
+          while (task != numbers::invalid_unsigned_int)
+            {
+              const auto start_time = std::chrono::steady_clock::now();
+              run_task(task);
+              if (record_times)
+                task_info.task_times[task] =
+                  std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start_time)
+                    .count();
+
+              // release the successors. One of the tasks that become ready is
+              // run right away on the present thread, because the successors
+              // of a chunk are the neighboring chunks that work on the same
+              // vector entries that are still in cache. Among several ready
+              // successors, keep the one with highest priority and hand the
+              // others to the task group.
+              unsigned int next_task = numbers::invalid_unsigned_int;
+              for (unsigned int j = task_info.task_successor_row_index[task];
+                   j < task_info.task_successor_row_index[task + 1];
+                   ++j)
+                {
+                  unsigned int successor = task_info.task_successors[j];
+                  if (n_pending[successor].fetch_sub(1) != 1)
+                    continue;
+                  if (next_task == numbers::invalid_unsigned_int)
+                    next_task = successor;
+                  else
+                    {
+                      if ((*priorities)[successor] > (*priorities)[next_task])
+                        std::swap(successor, next_task);
+                      task_group.run(
+                        [this, successor]() { execute(successor); });
+                    }
+                }
+              task = next_task;
+            }
+        }
+
+        void
+        run_task(const unsigned int task)
+        {
+          const unsigned int n_partitions =
+            task_info.partition_row_index.size() - 1;
+          if (task < n_chunks)
+            {
+              worker.cell(task);
+              if (task_info.face_partition_data.empty() == false)
+                {
+                  worker.face(task);
+                  worker.boundary(task);
+                }
+            }
+          else if (task == n_chunks + n_partitions)
+            worker.vector_update_ghosts_finish();
+          else if (task == n_chunks + n_partitions + 1)
+            worker.vector_compress_start();
+          // the remaining tasks only collect the dependencies of partitions
+        }
+
+        MFWorkerInterface &                              worker;
+        const TaskInfo &                                 task_info;
+        const std::shared_ptr<const std::vector<double>> priorities;
+        const bool                                       record_times;
+        const unsigned int                               n_chunks;
+        std::vector<std::atomic<unsigned int>>           n_pending;
+        tbb::task_group                                  task_group;
+      };
+    } // end of namespace work_stealing
+
+#endif // DEAL_II_WITH_TBB
+
+
+
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
@@ -359,6 +488,32 @@ namespace internal
 
       funct.vector_update_ghosts_start();
 
+#ifdef DEAL_II_WITH_TBB
+      if (scheme == work_stealing)
+        {
+          funct.zero_dst_vector_range(numbers::invalid_unsigned_int);
+          if (task_n_predecessors.empty() == false)
+            {
+              // only record the times if no other loop is running at the
+              // same time
+              std::unique_lock<std::mutex> lock(task_times_mutex,
+                                                std::try_to_lock);
+              work_stealing::Scheduler scheduler(funct,
+                                                 *this,
+                                                 lock.owns_lock());
+              scheduler.run();
+              if (lock.owns_lock())
+                update_task_priorities();
+            }
+          else
+            {
+              // no cells: still call the vector communication routines
+              funct.vector_update_ghosts_finish();
+              funct.vector_compress_start();
+            }
+        }
+      else
+#endif
 #if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
 
       if (scheme != none)
@@ -676,6 +831,12 @@ namespace internal
       partition_odds.clear();
       partition_n_blocked_workers.clear();
       partition_n_workers.clear();
+      task_n_predecessors.clear();
+      task_successor_row_index.clear();
+      task_successors.clear();
+      task_topological_order.clear();
+      task_times.clear();
+      task_priorities.reset();
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
@@ -711,7 +872,15 @@ namespace internal
         MemoryConsumption::memory_consumption(partition_evens) +
         MemoryConsumption::memory_consumption(partition_odds) +
         MemoryConsumption::memory_consumption(partition_n_blocked_workers) +
-        MemoryConsumption::memory_consumption(partition_n_workers));
+        MemoryConsumption::memory_consumption(partition_n_workers) +
+        MemoryConsumption::memory_consumption(task_n_predecessors) +
+        MemoryConsumption::memory_consumption(task_successor_row_index) +
+        MemoryConsumption::memory_consumption(task_successors) +
+        MemoryConsumption::memory_consumption(task_topological_order) +
+        MemoryConsumption::memory_consumption(task_times) +
+        (task_priorities ?
+           MemoryConsumption::memory_consumption(*task_priorities) :
+           0));
     }
 
 
@@ -1368,7 +1537,7 @@ namespace internal
       // make_partitioning defines that the no. of cells in each partition
       // should be a multiple of cluster_size.
       unsigned int cluster_size = 1;
-      if (scheme == partition_partition)
+      if (scheme == partition_partition || scheme == work_stealing)
         cluster_size = block_size * vectorization_length;
 
       // Make the partitioning of the first layer of the blocks of cells.
@@ -1388,7 +1557,7 @@ namespace internal
                           partition);
 
       // Partition or color second layer
-      if (scheme == partition_partition)
+      if (scheme == partition_partition || scheme == work_stealing)
 
         {
           // Partition within partitions.
@@ -1427,7 +1596,8 @@ namespace internal
       // Set the new renumbering
       std::vector<unsigned int> renumbering_in(n_active_cells, 0);
       renumbering_in.swap(renumbering);
-      if (scheme == partition_partition) // blocking_connectivity == false
+      if (scheme == partition_partition ||
+          scheme == work_stealing) // blocking_connectivity == false
         {
           // This is the simple case. The renumbering is just a combination of
           // the renumbering that we were given as an input and the
@@ -2276,6 +2446,147 @@ namespace internal
                                       partition_odds[part] -
                                       partition_n_blocked_workers[part];
         }
+
+      if (scheme == work_stealing)
+        setup_work_stealing_graph();
+    }
+
+
+
+    void
+    TaskInfo::setup_work_stealing_graph()
+    {
+      // The dependencies are the ones of the partition_partition scheme: The
+      // partitions form a sequence where only neighboring partitions access
+      // the same vector entries, and the same holds for the chunks within a
+      // partition. The odd partitions (chunks) can hence run first, and an
+      // even partition (chunk) can start as soon as its two odd neighbors are
+      // done. As opposed to the nested trees of tbb::task in the
+      // partition_partition scheme, all chunks are part of one graph, so no
+      // thread waits for the completion of a partition.
+      const unsigned int n_partitions = partition_row_index.size() - 1;
+      const unsigned int n_chunks     = cell_partition_data.size() - 1;
+      AssertDimension(partition_row_index.back(), n_chunks);
+      const unsigned int ghost_task    = n_chunks + n_partitions;
+      const unsigned int compress_task = ghost_task + 1;
+      const unsigned int n_tasks       = compress_task + 1;
+
+      std::vector<std::vector<unsigned int>> successors(n_tasks);
+      for (unsigned int part = 0; part < n_partitions; ++part)
+        for (unsigned int chunk = partition_row_index[part];
+             chunk < partition_row_index[part + 1];
+             ++chunk)
+          {
+            // the task of the partition completes with all its chunks
+            successors[chunk].push_back(n_chunks + part);
+
+            const unsigned int local_chunk = chunk - partition_row_index[part];
+            if (local_chunk % 2 == 1)
+              {
+                successors[chunk].push_back(chunk - 1);
+                if (chunk + 1 < partition_row_index[part + 1])
+                  successors[chunk].push_back(chunk + 1);
+              }
+
+            // chunks without dependencies inside even partitions wait for the
+            // neighboring partitions, and the first partition also for the
+            // import of ghost values
+            const bool has_local_predecessor =
+              local_chunk % 2 == 0 &&
+              (chunk > partition_row_index[part] ||
+               chunk + 1 < partition_row_index[part + 1]);
+            if (part % 2 == 0 && has_local_predecessor == false)
+              {
+                if (part > 0)
+                  successors[n_chunks + part - 1].push_back(chunk);
+                if (part + 1 < n_partitions)
+                  successors[n_chunks + part + 1].push_back(chunk);
+                if (part == 0)
+                  successors[ghost_task].push_back(chunk);
+              }
+          }
+      if (n_partitions > 0)
+        successors[n_chunks].push_back(compress_task);
+      else
+        successors[ghost_task].push_back(compress_task);
+
+      task_n_predecessors.clear();
+      task_n_predecessors.resize(n_tasks, 0);
+      task_successor_row_index.resize(n_tasks + 1);
+      task_successors.clear();
+      task_successor_row_index[0] = 0;
+      for (unsigned int task = 0; task < n_tasks; ++task)
+        {
+          for (const unsigned int successor : successors[task])
+            {
+              task_successors.push_back(successor);
+              ++task_n_predecessors[successor];
+            }
+          task_successor_row_index[task + 1] = task_successors.size();
+        }
+
+      // sort the tasks topologically, which is needed to compute the
+      // priorities
+      task_topological_order.clear();
+      task_topological_order.reserve(n_tasks);
+      std::vector<unsigned int> n_pending(task_n_predecessors);
+      for (unsigned int task = 0; task < n_tasks; ++task)
+        if (n_pending[task] == 0)
+          task_topological_order.push_back(task);
+      for (unsigned int i = 0; i < task_topological_order.size(); ++i)
+        {
+          const unsigned int task = task_topological_order[i];
+          for (unsigned int j = task_successor_row_index[task];
+               j < task_successor_row_index[task + 1];
+               ++j)
+            if (--n_pending[task_successors[j]] == 0)
+              task_topological_order.push_back(task_successors[j]);
+        }
+      AssertDimension(task_topological_order.size(), n_tasks);
+
+      // before the first loop, estimate the time of the chunks by the number
+      // of cell batches, as the faces are only set up later
+      task_times.clear();
+      task_times.resize(n_tasks, 0.);
+      for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+        task_times[chunk] =
+          cell_partition_data[chunk + 1] - cell_partition_data[chunk];
+      update_task_priorities();
+    }
+
+
+
+    void
+    TaskInfo::update_task_priorities() const
+    {
+      // compute the priorities in a new vector, as other loops might be
+      // reading the current one
+      const auto priorities =
+        std::make_shared<std::vector<double>>(task_times.size());
+      for (auto task = task_topological_order.rbegin();
+           task != task_topological_order.rend();
+           ++task)
+        {
+          double longest_path = 0;
+          for (unsigned int j = task_successor_row_index[*task];
+               j < task_successor_row_index[*task + 1];
+               ++j)
+            longest_path =
+              std::max(longest_path, (*priorities)[task_successors[j]]);
+          (*priorities)[*task] = task_times[*task] + longest_path;
+        }
+
+      std::lock_guard<std::mutex> lock(task_priorities_mutex);
+      task_priorities = priorities;
+    }
+
+
+
+    std::shared_ptr<const std::vector<double>>
+    TaskInfo::get_task_priorities() const
+    {
+      std::lock_guard<std::mutex> lock(task_priorities_mutex);
+      return task_priorities;
     }
   } // namespace MatrixFreeFunctions
 } // namespace internal
@@ -41,7 +41,63 @@ namespace internal
       PartitionerWrapper::PartitionerWrapper(
         const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
         : partitioner(partitioner)
-      {}
+      {
+        // split the ranges of ghost indices within the (possibly larger)
+        // ghost array by the processes they are received from, and find the
+        // import ranges of each process, for the aggregated exchange of
+        // several vectors
+        const auto &ghost_ranges =
+          partitioner->ghost_indices_within_larger_ghost_set();
+        auto         ghost_range = ghost_ranges.begin();
+        unsigned int offset      = 0;
+        ghost_ranges_by_rank_ptr.resize(1, 0);
+        ghost_offsets_by_rank.resize(1, 0);
+        for (const auto &target : partitioner->ghost_targets())
+          {
+            unsigned int n_remaining = target.second;
+            while (n_remaining > 0)
+              {
+                Assert(ghost_range != ghost_ranges.end(), ExcInternalError());
+                const unsigned int n_entries =
+                  std::min(n_remaining,
+                           ghost_range->second - ghost_range->first - offset);
+                if (n_entries > 0)
+                  ghost_ranges_by_rank.emplace_back(ghost_range->first + offset,
+                                                    ghost_range->first +
+                                                      offset + n_entries);
+                n_remaining -= n_entries;
+                offset += n_entries;
+                if (offset == ghost_range->second - ghost_range->first)
+                  {
+                    ++ghost_range;
+                    offset = 0;
+                  }
+              }
+            ghost_ranges_by_rank_ptr.push_back(ghost_ranges_by_rank.size());
+            ghost_offsets_by_rank.push_back(ghost_offsets_by_rank.back() +
+                                            target.second);
+          }
+
+        const auto &import_ranges = partitioner->import_indices();
+        unsigned int import_range = 0;
+        import_ranges_by_rank_ptr.resize(1, 0);
+        import_offsets_by_rank.resize(1, 0);
+        for (const auto &target : partitioner->import_targets())
+          {
+            // the import ranges do not span several processes
+            unsigned int n_entries = 0;
+            for (; n_entries < target.second; ++import_range)
+              {
+                AssertIndexRange(import_range, import_ranges.size());
+                n_entries += import_ranges[import_range].second -
+                             import_ranges[import_range].first;
+              }
+            AssertDimension(n_entries, target.second);
+            import_ranges_by_rank_ptr.push_back(import_range);
+            import_offsets_by_rank.push_back(import_offsets_by_rank.back() +
+                                             target.second);
+          }
+      }
 
 
 
@@ -320,6 +376,447 @@ namespace internal
 
 
 
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_start(
+        const unsigned int                          communication_channel,
+        const std::vector<ArrayView<const double>> &locally_owned_arrays,
+        const std::vector<ArrayView<double>> &      ghost_arrays,
+        const ArrayView<double> &                   temporary_storage,
+        std::vector<MPI_Request> &                  requests) const
+      {
+        export_to_ghosted_arrays_start_impl(communication_channel,
+                                            locally_owned_arrays,
+                                            ghost_arrays,
+                                            temporary_storage,
+                                            requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_finish(
+        const std::vector<ArrayView<double>> &ghost_arrays,
+        const ArrayView<const double> &       temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+        export_to_ghosted_arrays_finish_impl(ghost_arrays,
+                                             temporary_storage,
+                                             requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_start(
+        const unsigned int                    communication_channel,
+        const std::vector<ArrayView<double>> &ghost_arrays,
+        const ArrayView<double> &             temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+        import_from_ghosted_arrays_start_impl(communication_channel,
+                                              ghost_arrays,
+                                              temporary_storage,
+                                              requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_finish(
+        const std::vector<ArrayView<double>> &locally_owned_arrays,
+        const std::vector<ArrayView<double>> &ghost_arrays,
+        const ArrayView<const double> &       temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+        import_from_ghosted_arrays_finish_impl(locally_owned_arrays,
+                                               ghost_arrays,
+                                               temporary_storage,
+                                               requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_start(
+        const unsigned int                         communication_channel,
+        const std::vector<ArrayView<const float>> &locally_owned_arrays,
+        const std::vector<ArrayView<float>> &      ghost_arrays,
+        const ArrayView<float> &                   temporary_storage,
+        std::vector<MPI_Request> &                 requests) const
+      {
+        export_to_ghosted_arrays_start_impl(communication_channel,
+                                            locally_owned_arrays,
+                                            ghost_arrays,
+                                            temporary_storage,
+                                            requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_finish(
+        const std::vector<ArrayView<float>> &ghost_arrays,
+        const ArrayView<const float> &       temporary_storage,
+        std::vector<MPI_Request> &           requests) const
+      {
+        export_to_ghosted_arrays_finish_impl(ghost_arrays,
+                                             temporary_storage,
+                                             requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_start(
+        const unsigned int                   communication_channel,
+        const std::vector<ArrayView<float>> &ghost_arrays,
+        const ArrayView<float> &             temporary_storage,
+        std::vector<MPI_Request> &           requests) const
+      {
+        import_from_ghosted_arrays_start_impl(communication_channel,
+                                              ghost_arrays,
+                                              temporary_storage,
+                                              requests);
+      }
+
+
+
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_finish(
+        const std::vector<ArrayView<float>> &locally_owned_arrays,
+        const std::vector<ArrayView<float>> &ghost_arrays,
+        const ArrayView<const float> &       temporary_storage,
+        std::vector<MPI_Request> &           requests) const
+      {
+        import_from_ghosted_arrays_finish_impl(locally_owned_arrays,
+                                               ghost_arrays,
+                                               temporary_storage,
+                                               requests);
+      }
+
+
+
+
+      template <typename Number>
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_start_impl(
+        const unsigned int                          communication_channel,
+        const std::vector<ArrayView<const Number>> &locally_owned_arrays,
+        const std::vector<ArrayView<Number>> &      ghost_arrays,
+        const ArrayView<Number> &                   temporary_storage,
+        std::vector<MPI_Request> &                  requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)communication_channel;
+        (void)locally_owned_arrays;
+        (void)ghost_arrays;
+        (void)temporary_storage;
+        (void)requests;
+#else
+        const unsigned int n_blocks = locally_owned_arrays.size();
+        AssertDimension(ghost_arrays.size(), n_blocks);
+        (void)ghost_arrays;
+        AssertDimension(temporary_storage.size(),
+                        n_blocks * (n_import_indices() + n_ghost_indices()));
+        AssertIndexRange(communication_channel, 200);
+        Assert(requests.size() == 0,
+               ExcMessage("Another operation seems to still be running. "
+                          "Call update_ghost_values_finish() first."));
+
+        const auto &ghost_targets  = partitioner->ghost_targets();
+        const auto &import_targets = partitioner->import_targets();
+        const auto &import_ranges  = partitioner->import_indices();
+
+        const unsigned int mpi_tag =
+          Utilities::MPI::internal::Tags::partitioner_export_start +
+          communication_channel;
+        Assert(mpi_tag <=
+                 Utilities::MPI::internal::Tags::partitioner_export_end,
+               ExcInternalError());
+
+        requests.resize(ghost_targets.size() + import_targets.size());
+
+        // receive the data of all vectors from a process with one message
+        // into the back part of the temporary storage
+        Number *receive_ptr =
+          temporary_storage.data() + n_blocks * n_import_indices();
+        for (unsigned int i = 0; i < ghost_targets.size(); ++i)
+          {
+            const std::size_t n_entries =
+              static_cast<std::size_t>(n_blocks) * ghost_targets[i].second;
+            AssertThrow(
+              n_entries * sizeof(Number) <
+                static_cast<std::size_t>(std::numeric_limits<int>::max()),
+              ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
+                         "The number of ghost entries times the number of "
+                         "vectors and the size of 'Number' exceeds this "
+                         "value. This is not supported."));
+            const int ierr =
+              MPI_Irecv(receive_ptr,
+                        n_entries * sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets[i].first,
+                        mpi_tag,
+                        partitioner->get_mpi_communicator(),
+                        &requests[i]);
+            AssertThrowMPI(ierr);
+            receive_ptr += n_entries;
+          }
+
+        // pack the data of all vectors for a process one after the other
+        Number *send_ptr = temporary_storage.data();
+        for (unsigned int i = 0; i < import_targets.size(); ++i)
+          {
+            Number *const message_start = send_ptr;
+            for (unsigned int b = 0; b < n_blocks; ++b)
+              for (unsigned int r = import_ranges_by_rank_ptr[i];
+                   r < import_ranges_by_rank_ptr[i + 1];
+                   ++r)
+                send_ptr =
+                  std::copy(locally_owned_arrays[b].data() +
+                              import_ranges[r].first,
+                            locally_owned_arrays[b].data() +
+                              import_ranges[r].second,
+                            send_ptr);
+            AssertDimension(send_ptr - message_start,
+                            n_blocks * import_targets[i].second);
+
+            const int ierr =
+              MPI_Isend(message_start,
+                        (send_ptr - message_start) * sizeof(Number),
+                        MPI_BYTE,
+                        import_targets[i].first,
+                        mpi_tag,
+                        partitioner->get_mpi_communicator(),
+                        &requests[ghost_targets.size() + i]);
+            AssertThrowMPI(ierr);
+          }
+#endif
+      }
+
+
+
+      template <typename Number>
+      void
+      PartitionerWrapper::export_to_ghosted_arrays_finish_impl(
+        const std::vector<ArrayView<Number>> &ghost_arrays,
+        const ArrayView<const Number> &       temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)ghost_arrays;
+        (void)temporary_storage;
+        (void)requests;
+#else
+        const unsigned int n_blocks = ghost_arrays.size();
+        const unsigned int n_ghost_targets =
+          partitioner->ghost_targets().size();
+        AssertDimension(requests.size(),
+                        n_ghost_targets + partitioner->import_targets().size());
+        AssertDimension(temporary_storage.size(),
+                        n_blocks * (n_import_indices() + n_ghost_indices()));
+
+        // copy the data of a process into the ghost arrays as soon as its
+        // message has arrived, rather than waiting for all of them
+        const Number *receive_data =
+          temporary_storage.data() + n_blocks * n_import_indices();
+        for (unsigned int c = 0; c < n_ghost_targets; ++c)
+          {
+            int       i    = 0;
+            const int ierr = MPI_Waitany(n_ghost_targets,
+                                         requests.data(),
+                                         &i,
+                                         MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            AssertIndexRange(i, n_ghost_targets);
+
+            const Number *read_ptr =
+              receive_data + n_blocks * ghost_offsets_by_rank[i];
+            for (unsigned int b = 0; b < n_blocks; ++b)
+              for (unsigned int r = ghost_ranges_by_rank_ptr[i];
+                   r < ghost_ranges_by_rank_ptr[i + 1];
+                   ++r)
+                {
+                  const unsigned int chunk_size =
+                    ghost_ranges_by_rank[r].second -
+                    ghost_ranges_by_rank[r].first;
+                  std::copy(read_ptr,
+                            read_ptr + chunk_size,
+                            ghost_arrays[b].data() +
+                              ghost_ranges_by_rank[r].first);
+                  read_ptr += chunk_size;
+                }
+          }
+
+        if (requests.size() > n_ghost_targets)
+          {
+            const int ierr = MPI_Waitall(requests.size() - n_ghost_targets,
+                                         requests.data() + n_ghost_targets,
+                                         MPI_STATUSES_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+        requests.resize(0);
+#endif
+      }
+
+
+
+      template <typename Number>
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_start_impl(
+        const unsigned int                    communication_channel,
+        const std::vector<ArrayView<Number>> &ghost_arrays,
+        const ArrayView<Number> &             temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)communication_channel;
+        (void)ghost_arrays;
+        (void)temporary_storage;
+        (void)requests;
+#else
+        const unsigned int n_blocks = ghost_arrays.size();
+        AssertDimension(temporary_storage.size(),
+                        n_blocks * (n_import_indices() + n_ghost_indices()));
+        AssertIndexRange(communication_channel, 200);
+        Assert(requests.size() == 0,
+               ExcMessage("Another compress operation seems to still be "
+                          "running. Call compress_finish() first."));
+
+        const auto &ghost_targets  = partitioner->ghost_targets();
+        const auto &import_targets = partitioner->import_targets();
+
+        const unsigned int mpi_tag =
+          Utilities::MPI::internal::Tags::partitioner_import_start +
+          communication_channel;
+        Assert(mpi_tag <=
+                 Utilities::MPI::internal::Tags::partitioner_import_end,
+               ExcInternalError());
+
+        requests.resize(import_targets.size() + ghost_targets.size());
+
+        // receive the contributions of all vectors from a process with one
+        // message into the front part of the temporary storage
+        for (unsigned int i = 0; i < import_targets.size(); ++i)
+          {
+            const std::size_t n_entries =
+              static_cast<std::size_t>(n_blocks) * import_targets[i].second;
+            AssertThrow(
+              n_entries * sizeof(Number) <
+                static_cast<std::size_t>(std::numeric_limits<int>::max()),
+              ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
+                         "The number of ghost entries times the number of "
+                         "vectors and the size of 'Number' exceeds this "
+                         "value. This is not supported."));
+            const int ierr =
+              MPI_Irecv(temporary_storage.data() +
+                          n_blocks * import_offsets_by_rank[i],
+                        n_entries * sizeof(Number),
+                        MPI_BYTE,
+                        import_targets[i].first,
+                        mpi_tag,
+                        partitioner->get_mpi_communicator(),
+                        &requests[i]);
+            AssertThrowMPI(ierr);
+          }
+
+        // pack the ghost values of all vectors for a process one after the
+        // other into the back part of the temporary storage
+        Number *send_ptr =
+          temporary_storage.data() + n_blocks * n_import_indices();
+        for (unsigned int i = 0; i < ghost_targets.size(); ++i)
+          {
+            Number *const message_start = send_ptr;
+            for (unsigned int b = 0; b < n_blocks; ++b)
+              for (unsigned int r = ghost_ranges_by_rank_ptr[i];
+                   r < ghost_ranges_by_rank_ptr[i + 1];
+                   ++r)
+                send_ptr = std::copy(ghost_arrays[b].data() +
+                                       ghost_ranges_by_rank[r].first,
+                                     ghost_arrays[b].data() +
+                                       ghost_ranges_by_rank[r].second,
+                                     send_ptr);
+            AssertDimension(send_ptr - message_start,
+                            n_blocks * ghost_targets[i].second);
+
+            const int ierr =
+              MPI_Isend(message_start,
+                        (send_ptr - message_start) * sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets[i].first,
+                        mpi_tag,
+                        partitioner->get_mpi_communicator(),
+                        &requests[import_targets.size() + i]);
+            AssertThrowMPI(ierr);
+          }
+#endif
+      }
+
+
+
+      template <typename Number>
+      void
+      PartitionerWrapper::import_from_ghosted_arrays_finish_impl(
+        const std::vector<ArrayView<Number>> &locally_owned_arrays,
+        const std::vector<ArrayView<Number>> &ghost_arrays,
+        const ArrayView<const Number> &       temporary_storage,
+        std::vector<MPI_Request> &            requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)locally_owned_arrays;
+        (void)ghost_arrays;
+        (void)temporary_storage;
+        (void)requests;
+#else
+        const unsigned int n_blocks = locally_owned_arrays.size();
+        AssertDimension(ghost_arrays.size(), n_blocks);
+        AssertDimension(temporary_storage.size(),
+                        n_blocks * (n_import_indices() + n_ghost_indices()));
+        const unsigned int n_import_targets =
+          partitioner->import_targets().size();
+        AssertDimension(requests.size(),
+                        n_import_targets + partitioner->ghost_targets().size());
+
+        // add the contributions of a process as soon as its message has
+        // arrived, rather than waiting for all of them
+        const auto &import_ranges = partitioner->import_indices();
+        for (unsigned int c = 0; c < n_import_targets; ++c)
+          {
+            int       i    = 0;
+            const int ierr = MPI_Waitany(n_import_targets,
+                                         requests.data(),
+                                         &i,
+                                         MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            AssertIndexRange(i, n_import_targets);
+
+            const Number *read_ptr =
+              temporary_storage.data() + n_blocks * import_offsets_by_rank[i];
+            for (unsigned int b = 0; b < n_blocks; ++b)
+              for (unsigned int r = import_ranges_by_rank_ptr[i];
+                   r < import_ranges_by_rank_ptr[i + 1];
+                   ++r)
+                for (unsigned int j = import_ranges[r].first;
+                     j < import_ranges[r].second;
+                     ++j)
+                  locally_owned_arrays[b][j] += *read_ptr++;
+          }
+
+        if (requests.size() > n_import_targets)
+          {
+            const int ierr = MPI_Waitall(requests.size() - n_import_targets,
+                                         requests.data() + n_import_targets,
+                                         MPI_STATUSES_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+        requests.resize(0);
+#endif
+
+        for (const auto &ghost_array : ghost_arrays)
+          reset_ghost_values_impl(ghost_array);
+      }
+
+
       namespace internal
       {
         std::pair<std::vector<unsigned int>,
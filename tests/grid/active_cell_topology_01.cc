@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check GridTools::ActiveCellTopology against the information obtained
+// through the cell accessors on adaptively refined meshes, and check that
+// GridTools::Cache rebuilds it after refinement
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools_active_cell_topology.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int spacedim>
+void
+check(const Triangulation<dim, spacedim> &                 tria,
+      const GridTools::ActiveCellTopology<dim, spacedim> &topology)
+{
+  deallog << "Number of cells: " << topology.n_cells() << std::endl;
+  AssertDimension(topology.n_cells(), tria.n_active_cells());
+
+  unsigned int n_errors = 0, n_neighbors = 0, n_boundary_faces = 0;
+  for (const unsigned int c : topology.cell_indices())
+    {
+      const auto cell = topology.cell_iterator(c);
+      if (cell->active_cell_index() != c)
+        ++n_errors;
+
+      const auto vertices = topology.vertex_indices(c);
+      if (vertices.size() != cell->n_vertices())
+        ++n_errors;
+      else
+        for (const unsigned int v : cell->vertex_indices())
+          if (vertices[v] != cell->vertex_index(v))
+            ++n_errors;
+
+      if (topology.n_faces(c) != cell->n_faces())
+        ++n_errors;
+      for (const unsigned int f : topology.face_indices(c))
+        {
+          if (topology.combined_face_orientation(c, f) !=
+              cell->combined_face_orientation(f))
+            ++n_errors;
+          if (topology.at_boundary(c, f) != cell->at_boundary(f))
+            ++n_errors;
+          if (cell->at_boundary(f))
+            {
+              ++n_boundary_faces;
+              continue;
+            }
+
+          // every neighbor must share the face with the present cell, and
+          // the present cell must appear as a neighbor of the neighbor
+          for (const unsigned int n : topology.face_neighbors(c, f))
+            {
+              ++n_neighbors;
+              const auto neighbor = topology.cell_iterator(n);
+              if (!neighbor->is_active())
+                ++n_errors;
+
+              bool found = false;
+              for (const unsigned int nf : topology.face_indices(n))
+                for (const unsigned int nn : topology.face_neighbors(n, nf))
+                  if (nn == c)
+                    found = true;
+              if (!found)
+                ++n_errors;
+            }
+          if (!cell->neighbor(f)->has_children() &&
+              (topology.face_neighbors(c, f).size() != 1 ||
+               topology.face_neighbors(c, f)[0] !=
+                 cell->neighbor(f)->active_cell_index()))
+            ++n_errors;
+        }
+    }
+  deallog << "Number of neighbor entries: " << n_neighbors << std::endl;
+  deallog << "Number of boundary faces: " << n_boundary_faces << std::endl;
+  deallog << "Errors: " << n_errors << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void
+refine_adaptively(Triangulation<dim, spacedim> &tria)
+{
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.3 * cell->center()[spacedim - 1])
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim, int spacedim>
+void
+test()
+{
+  deallog << "Hypercube mesh in " << dim << "d/" << spacedim << "d"
+          << std::endl;
+  Triangulation<dim, spacedim> tria;
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(2);
+  refine_adaptively(tria);
+  refine_adaptively(tria);
+
+  const GridTools::Cache<dim, spacedim> cache(tria);
+  check(tria, cache.get_active_cell_topology());
+
+  // the cache must notice the change of the mesh
+  refine_adaptively(tria);
+  check(tria, cache.get_active_cell_topology());
+}
+
+
+
+template <int dim>
+void
+test_simplex()
+{
+  deallog << "Simplex mesh in " << dim << "d" << std::endl;
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+  tria.refine_global(1);
+
+  const GridTools::ActiveCellTopology<dim> topology(tria);
+  check(tria, topology);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1, 1>();
+  test<1, 2>();
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 3>();
+  test_simplex<2>();
+  test_simplex<3>();
+}
@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check GridTools::compute_point_locations_batched() against
+// GridTools::compute_point_locations_try_all() for random points, some of
+// which lie outside of the mesh, on adaptively refined, curved and simplex
+// meshes. Also check that points close to a curved boundary and points
+// outside of the mesh by less than the tolerance are found.
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test(const Triangulation<dim> &tria, const Mapping<dim> &mapping)
+{
+  const GridTools::Cache<dim> cache(tria, mapping);
+
+  std::vector<Point<dim>> points(1000);
+  for (auto &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = 2.4 * random_value<double>() - 1.2;
+
+  const auto [cells, qpoints, maps, missing] =
+    GridTools::compute_point_locations_batched(cache, points);
+  const auto [cells_ref, qpoints_ref, maps_ref, missing_ref] =
+    GridTools::compute_point_locations_try_all(cache, points);
+
+  // every point must be assigned to a cell that contains it, or be listed
+  // as missing
+  std::vector<unsigned int> n_found(points.size(), 0);
+  unsigned int              n_errors = 0;
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      if (c > 0 && !(cells[c - 1] < cells[c]))
+        ++n_errors;
+      for (unsigned int q = 0; q < qpoints[c].size(); ++q)
+        {
+          ++n_found[maps[c][q]];
+          if (!cells[c]->reference_cell().contains_point(qpoints[c][q], 1e-10))
+            ++n_errors;
+          if (mapping.transform_unit_to_real_cell(cells[c], qpoints[c][q])
+                .distance(points[maps[c][q]]) > 1e-10)
+            ++n_errors;
+        }
+    }
+  for (const unsigned int i : missing)
+    ++n_found[i];
+  for (const unsigned int n : n_found)
+    if (n != 1)
+      ++n_errors;
+
+  // the same points must be found as with the reference function
+  std::vector<unsigned int> missing_sorted = missing_ref;
+  std::sort(missing_sorted.begin(), missing_sorted.end());
+  if (missing_sorted != missing)
+    ++n_errors;
+
+  unsigned int n_points = 0;
+  for (const auto &q : qpoints)
+    n_points += q.size();
+  deallog << "Points found: " << n_points << ", missing: " << missing.size()
+          << ", cells: " << cells.size() << ", errors: " << n_errors
+          << std::endl;
+}
+
+
+
+void
+test_boundary_points()
+{
+  // points just inside the arcs of a curved boundary described by a
+  // high-order mapping, half-way between two boundary vertices
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(3);
+    const MappingQ<2>         mapping(4);
+    const GridTools::Cache<2> cache(tria, mapping);
+
+    std::vector<Point<2>> points;
+    for (unsigned int k = 0; k < 32; ++k)
+      {
+        const double angle = numbers::PI / 4. + (k + 0.5) * numbers::PI / 16.;
+        points.emplace_back(0.9999 * std::cos(angle),
+                            0.9999 * std::sin(angle));
+      }
+
+    const auto [cells, qpoints, maps, missing] =
+      GridTools::compute_point_locations_batched(cache, points);
+    deallog << "Points near curved boundary found: "
+            << points.size() - missing.size() << " of " << points.size()
+            << std::endl;
+  }
+
+  // points outside of the mesh by roundoff
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(2);
+    const MappingQ<2>         mapping(1);
+    const GridTools::Cache<2> cache(tria, mapping);
+
+    const std::vector<Point<2>> points = {Point<2>(1. + 1e-13, 0.3),
+                                          Point<2>(-0.7, -1. - 1e-13),
+                                          Point<2>(1. + 1e-13, 1. + 1e-13)};
+
+    const auto [cells, qpoints, maps, missing] =
+      GridTools::compute_point_locations_batched(cache, points);
+    deallog << "Points outside by roundoff found: "
+            << points.size() - missing.size() << " of " << points.size()
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(3);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->center()[0] < cell->center()[1])
+        cell->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+    test(tria, MappingQ<2>(1));
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(3);
+    test(tria, MappingQ<2>(4));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+    test(tria, MappingQ<3>(3));
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 8, -1., 1.);
+    test(tria, MappingFE<2>(FE_SimplexP<2>(1)));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 4, -1., 1.);
+    test(tria, MappingFE<3>(FE_SimplexP<3>(1)));
+  }
+
+  test_boundary_points();
+}
@@ -0,0 +1,197 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// GridTools::Cache updates the vertex to cell map, the used vertices and
+// the R-trees of the vertices and cell bounding boxes incrementally after
+// refinement and coarsening of a serial triangulation. Check that the
+// result is the same as the one of a cache that builds them from scratch
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int spacedim>
+void
+compare(const GridTools::Cache<dim, spacedim> &cache)
+{
+  const GridTools::Cache<dim, spacedim> reference(cache.get_triangulation(),
+                                                  cache.get_mapping());
+
+  deallog << "Cells: " << cache.get_triangulation().n_active_cells()
+          << ", vertex to cell map "
+          << (cache.get_vertex_to_cell_map() ==
+                  reference.get_vertex_to_cell_map() ?
+                "ok" :
+                "wrong")
+          << ", used vertices "
+          << (cache.get_used_vertices() == reference.get_used_vertices() ?
+                "ok" :
+                "wrong");
+
+  const auto sort_by_index = [](auto entries) {
+    std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+      return a.second < b.second;
+    });
+    return entries;
+  };
+
+  {
+    const auto &tree = cache.get_used_vertices_rtree();
+    const auto &reference_tree = reference.get_used_vertices_rtree();
+    const auto  entries        = sort_by_index(
+      std::vector<std::pair<Point<spacedim>, unsigned int>>(tree.begin(),
+                                                            tree.end()));
+    const auto reference_entries = sort_by_index(
+      std::vector<std::pair<Point<spacedim>, unsigned int>>(
+        reference_tree.begin(), reference_tree.end()));
+    deallog << ", vertex tree "
+            << (entries == reference_entries ? "ok" : "wrong");
+  }
+
+  {
+    using Entry =
+      std::pair<BoundingBox<spacedim>,
+                typename Triangulation<dim, spacedim>::active_cell_iterator>;
+    const auto &tree           = cache.get_cell_bounding_boxes_rtree();
+    const auto &reference_tree = reference.get_cell_bounding_boxes_rtree();
+    const auto  entries = sort_by_index(std::vector<Entry>(tree.begin(),
+                                                          tree.end()));
+    const auto  reference_entries = sort_by_index(
+      std::vector<Entry>(reference_tree.begin(), reference_tree.end()));
+    bool identical = entries.size() == reference_entries.size();
+    for (unsigned int i = 0; identical && i < entries.size(); ++i)
+      identical = entries[i].second == reference_entries[i].second &&
+                  entries[i].first.get_boundary_points() ==
+                    reference_entries[i].first.get_boundary_points();
+    deallog << ", cell tree " << (identical ? "ok" : "wrong");
+  }
+
+  // the vertex to cell centers directions are rebuilt on top of the
+  // incrementally updated vertex to cell map
+  const auto &directions = cache.get_vertex_to_cell_centers_directions();
+  deallog << ", directions "
+          << (directions == reference.get_vertex_to_cell_centers_directions() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void
+refine_and_coarsen(Triangulation<dim, spacedim> &tria, const unsigned int cycle)
+{
+  Point<spacedim> center;
+  center[0] = -0.6 + 0.3 * cycle;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().distance(center) < 0.45)
+      cell->set_refine_flag();
+    else if (cell->level() > 2)
+      cell->set_coarsen_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim, int spacedim>
+void
+test(Triangulation<dim, spacedim> &tria,
+     const Mapping<dim, spacedim> &mapping =
+       ReferenceCells::get_hypercube<dim>()
+         .template get_default_linear_mapping<dim, spacedim>())
+{
+  deallog << "Mesh in " << dim << "d/" << spacedim << "d" << std::endl;
+  const GridTools::Cache<dim, spacedim> cache(tria, mapping);
+  compare(cache);
+  for (unsigned int cycle = 0; cycle < 5; ++cycle)
+    {
+      refine_and_coarsen(tria, cycle);
+      compare(cache);
+    }
+
+  // only some of the objects are kept up to date
+  const GridTools::Cache<dim, spacedim> partial_cache(tria, mapping);
+  partial_cache.get_cell_bounding_boxes_rtree();
+  refine_and_coarsen(tria, 0);
+  compare(partial_cache);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<1> tria;
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(3);
+    test(tria);
+  }
+  {
+    Triangulation<2> tria(Triangulation<2>::limit_level_difference_at_vertices);
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(2);
+    test(tria);
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+    test(tria, MappingQ<2>(3));
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(2);
+    test(tria);
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_cube(tria, -1., 1.);
+    tria.refine_global(2);
+    test(tria);
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+    tria.refine_global(1);
+    test(tria, MappingQ<3>(2));
+  }
+  {
+    deallog << "Simplex mesh" << std::endl;
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2, -1., 1.);
+    const GridTools::Cache<3> cache(
+      tria,
+      ReferenceCells::get_simplex<3>()
+        .template get_default_linear_mapping<3, 3>());
+    compare(cache);
+    tria.refine_global(1);
+    compare(cache);
+  }
+}
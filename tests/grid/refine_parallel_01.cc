@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The new vertices created by isotropic refinement in 3d are computed by
+// several threads. Check that adaptive refinement and coarsening of curved
+// hexahedral meshes and of tetrahedral meshes gives exactly the same mesh,
+// including the numbering of vertices and cells, independently of the
+// number of threads
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+void
+refine(Triangulation<3> &tria, const bool adaptive)
+{
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (!adaptive ||
+            cell->center()[0] + 0.3 * cell->center()[1] > 0.1 * cycle)
+          cell->set_refine_flag();
+        else if (cycle > 0 && cell->center()[2] > 0.)
+          cell->set_coarsen_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+}
+
+
+
+void
+test(const std::function<void(Triangulation<3> &)> &create_mesh,
+     const bool                                       adaptive)
+{
+  const auto smoothing =
+    adaptive ? Triangulation<3>::limit_level_difference_at_vertices :
+               Triangulation<3>::none;
+  Triangulation<3> tria_serial(smoothing);
+  Triangulation<3> tria_parallel(smoothing);
+  create_mesh(tria_serial);
+  create_mesh(tria_parallel);
+
+  MultithreadInfo::set_thread_limit(1);
+  refine(tria_serial, adaptive);
+  MultithreadInfo::set_thread_limit(4);
+  refine(tria_parallel, adaptive);
+
+  deallog << "Number of active cells: " << tria_parallel.n_active_cells()
+          << std::endl;
+  deallog << "Number of vertices: " << tria_parallel.n_used_vertices()
+          << std::endl;
+
+  bool identical =
+    tria_serial.n_active_cells() == tria_parallel.n_active_cells() &&
+    tria_serial.get_vertices() == tria_parallel.get_vertices() &&
+    tria_serial.get_used_vertices() == tria_parallel.get_used_vertices();
+  for (auto cell_s = tria_serial.begin_active(),
+            cell_p = tria_parallel.begin_active();
+       identical && cell_s != tria_serial.end();
+       ++cell_s, ++cell_p)
+    {
+      identical = identical && cell_s->level() == cell_p->level() &&
+                  cell_s->index() == cell_p->index();
+      for (const unsigned int v : cell_s->vertex_indices())
+        identical =
+          identical && cell_s->vertex_index(v) == cell_p->vertex_index(v);
+    }
+  deallog << "Meshes identical: " << (identical ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog << "hyper_shell" << std::endl;
+  test(
+    [](Triangulation<3> &tria) {
+      GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+    },
+    true);
+
+  deallog << "hyper_ball_balanced" << std::endl;
+  test(
+    [](Triangulation<3> &tria) {
+      GridGenerator::hyper_ball_balanced(tria);
+      tria.refine_global(1);
+    },
+    true);
+
+  // simplex meshes only support global refinement
+  deallog << "subdivided_hyper_cube_with_simplices" << std::endl;
+  test(
+    [](Triangulation<3> &tria) {
+      GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2, -1., 1.);
+    },
+    false);
+}
@@ -0,0 +1,208 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test GridTools::reorder_cells_and_vertices_hilbert(): shuffle the cells
+// and vertices of a coarse mesh, reorder them along the Hilbert curve, and
+// check that the resulting triangulation describes the same mesh with
+// improved locality of the cell and vertex numbering
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <numeric>
+
+#include "../tests.h"
+
+
+
+// a deterministic permutation that scatters the entries of a list
+std::vector<unsigned int>
+scattering_permutation(const unsigned int n)
+{
+  unsigned int stride = n / 3 + 1;
+  while (std::gcd(stride, n) != 1)
+    ++stride;
+  std::vector<unsigned int> permutation(n);
+  for (unsigned int i = 0; i < n; ++i)
+    permutation[i] = (i * stride) % n;
+  return permutation;
+}
+
+
+
+template <int dim, int spacedim>
+void
+shuffle(std::vector<Point<spacedim>> &vertices,
+        std::vector<CellData<dim>> &  cells,
+        SubCellData &                 subcelldata)
+{
+  std::vector<CellData<dim>> new_cells;
+  for (const unsigned int c : scattering_permutation(cells.size()))
+    new_cells.push_back(cells[c]);
+  cells = new_cells;
+
+  const std::vector<unsigned int> permutation =
+    scattering_permutation(vertices.size());
+  std::vector<Point<spacedim>> new_vertices(vertices.size());
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    new_vertices[permutation[v]] = vertices[v];
+  vertices = new_vertices;
+
+  for (auto &cell : cells)
+    for (auto &v : cell.vertices)
+      v = permutation[v];
+  for (auto &line : subcelldata.boundary_lines)
+    for (auto &v : line.vertices)
+      v = permutation[v];
+  for (auto &quad : subcelldata.boundary_quads)
+    for (auto &v : quad.vertices)
+      v = permutation[v];
+}
+
+
+
+// return the average distance between the centers of consecutive cells and
+// the average spread of the vertex indices of the cells
+template <int dim, int spacedim>
+std::pair<double, double>
+compute_locality(const Triangulation<dim, spacedim> &tria)
+{
+  double          distance = 0, spread = 0;
+  Point<spacedim> previous_center = tria.begin_active()->center();
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      distance += cell->center().distance(previous_center);
+      previous_center = cell->center();
+
+      unsigned int min_index = numbers::invalid_unsigned_int, max_index = 0;
+      for (const unsigned int v : cell->vertex_indices())
+        {
+          min_index = std::min(min_index, cell->vertex_index(v));
+          max_index = std::max(max_index, cell->vertex_index(v));
+        }
+      spread += max_index - min_index;
+    }
+  return {distance / tria.n_active_cells(), spread / tria.n_active_cells()};
+}
+
+
+
+template <int dim, int spacedim>
+void
+print_mesh_info(const Triangulation<dim, spacedim> &tria)
+{
+  double                                     volume = 0;
+  std::map<types::boundary_id, unsigned int> boundary_faces;
+  std::map<types::material_id, unsigned int> material_ids;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      volume += cell->measure();
+      ++material_ids[cell->material_id()];
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary())
+          ++boundary_faces[face->boundary_id()];
+    }
+  deallog << "Number of cells: " << tria.n_active_cells()
+          << ", number of vertices: " << tria.n_vertices()
+          << ", volume: " << volume << std::endl;
+  deallog << "Boundary faces per id:";
+  for (const auto &entry : boundary_faces)
+    deallog << " " << static_cast<unsigned int>(entry.first) << ":"
+            << entry.second;
+  deallog << std::endl << "Cells per material id:";
+  for (const auto &entry : material_ids)
+    deallog << " " << static_cast<unsigned int>(entry.first) << ":"
+            << entry.second;
+  deallog << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void
+test(const Triangulation<dim, spacedim> &tria)
+{
+  print_mesh_info(tria);
+
+  auto [vertices, cells, subcelldata] =
+    GridTools::get_coarse_mesh_description(tria);
+  // get_coarse_mesh_description() stores triangular faces with four
+  // vertices, so skip the boundary description of simplex meshes, which
+  // only have the default boundary id anyway
+  if (tria.all_reference_cells_are_hyper_cube() == false)
+    subcelldata = SubCellData();
+  shuffle(vertices, cells, subcelldata);
+
+  Triangulation<dim, spacedim> tria_shuffled;
+  tria_shuffled.create_triangulation(vertices, cells, subcelldata);
+
+  GridTools::reorder_cells_and_vertices_hilbert(vertices, cells, subcelldata);
+  Triangulation<dim, spacedim> tria_reordered;
+  tria_reordered.create_triangulation(vertices, cells, subcelldata);
+  print_mesh_info(tria_reordered);
+
+  const auto locality_shuffled  = compute_locality(tria_shuffled);
+  const auto locality_reordered = compute_locality(tria_reordered);
+  deallog << "Cell distance improved: "
+          << (locality_reordered.first < locality_shuffled.first ? "yes" :
+                                                                   "no")
+          << std::endl;
+  deallog << "Vertex spread improved: "
+          << (locality_reordered.second < locality_shuffled.second ? "yes" :
+                                                                     "no")
+          << std::endl;
+  deallog << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {12, 9}, Point<2>(), Point<2>(1.2, 0.9), true);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->center()[0] < 0.4)
+        cell->set_material_id(5);
+    test(tria);
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {10, 10}, Point<2>(), Point<2>(1., 1.));
+    GridTools::transform(
+      [](const Point<3> &p) { return Point<3>(p[0], p[1], p[0] * p[1]); },
+      tria);
+    test(tria);
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {6, 5, 4}, Point<3>(), Point<3>(1., 1., 1.), true);
+    test(tria);
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 4);
+    test(tria);
+  }
+}
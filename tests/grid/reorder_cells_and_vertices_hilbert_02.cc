@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test GridTools::reorder_cells_and_vertices_hilbert() with vertices that
+// are not referenced by any cell: they must be numbered after the used
+// vertices in their original order, and the mesh must stay the same
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <set>
+
+#include "../tests.h"
+
+
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            {3, 2},
+                                            Point<2>(),
+                                            Point<2>(3., 2.));
+
+  auto [vertices, cells, subcelldata] =
+    GridTools::get_coarse_mesh_description(tria);
+
+  // put two unused vertices at the front and one in the middle of the list
+  const std::vector<Point<2>> unused_points = {Point<2>(-1., -1.),
+                                               Point<2>(-2., -2.),
+                                               Point<2>(-3., -3.)};
+  std::vector<Point<2>> new_vertices = {unused_points[0], unused_points[1]};
+  new_vertices.insert(new_vertices.end(),
+                      vertices.begin(),
+                      vertices.begin() + vertices.size() / 2);
+  new_vertices.push_back(unused_points[2]);
+  new_vertices.insert(new_vertices.end(),
+                      vertices.begin() + vertices.size() / 2,
+                      vertices.end());
+  const auto shift = [&](unsigned int &v) {
+    v += (v < vertices.size() / 2 ? 2 : 3);
+  };
+  for (auto &cell : cells)
+    for (auto &v : cell.vertices)
+      shift(v);
+  for (auto &line : subcelldata.boundary_lines)
+    for (auto &v : line.vertices)
+      shift(v);
+  const unsigned int n_used_vertices = vertices.size();
+  vertices                           = new_vertices;
+
+  GridTools::reorder_cells_and_vertices_hilbert(vertices, cells, subcelldata);
+
+  deallog << "Number of vertices: " << vertices.size() << std::endl;
+  deallog << "Unused vertices at the end:";
+  for (unsigned int v = n_used_vertices; v < vertices.size(); ++v)
+    deallog << " " << vertices[v];
+  deallog << std::endl;
+
+  unsigned int max_used_index = 0;
+  for (const auto &cell : cells)
+    for (const unsigned int v : cell.vertices)
+      max_used_index = std::max(max_used_index, v);
+  deallog << "Largest vertex index used by cells: " << max_used_index
+          << std::endl;
+
+  Triangulation<2> tria_reordered;
+  tria_reordered.create_triangulation(vertices, cells, subcelldata);
+  double                 volume = 0;
+  std::set<unsigned int> referenced_vertices;
+  for (const auto &cell : tria_reordered.active_cell_iterators())
+    {
+      volume += cell->measure();
+      for (const unsigned int v : cell->vertex_indices())
+        referenced_vertices.insert(cell->vertex_index(v));
+    }
+  deallog << "Number of cells: " << tria_reordered.n_active_cells()
+          << ", number of vertices referenced by cells: "
+          << referenced_vertices.size() << ", volume: " << volume
+          << std::endl;
+}
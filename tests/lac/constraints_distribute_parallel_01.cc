@@ -0,0 +1,146 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check AffineConstraints::distribute() and AffineConstraints::set_zero() on
+// a set of constraints that is large enough to be worked on by several
+// threads, for different vector types. compare against a reference
+// computed from the lines as returned by get_lines(). also check that the
+// compressed storage used by these functions is kept up to date by
+// set_inhomogeneity(), shift(), and copy_from()
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+template <typename VectorType>
+void
+check(const AffineConstraints<double> &constraints, const unsigned int size)
+{
+  VectorType vec;
+  vec.reinit(size);
+  for (unsigned int i = 0; i < size; ++i)
+    vec(i) = random_value<double>();
+
+  // reference solution computed serially from the lines of the closed
+  // object
+  Vector<double> reference(size);
+  for (unsigned int i = 0; i < size; ++i)
+    reference(i) = vec(i);
+  for (const auto &line : constraints.get_lines())
+    {
+      double value = line.inhomogeneity;
+      for (const auto &entry : line.entries)
+        value += reference(entry.first) * entry.second;
+      reference(line.index) = value;
+    }
+
+  constraints.distribute(vec);
+  double error = 0;
+  for (unsigned int i = 0; i < size; ++i)
+    error = std::max(error, std::abs(vec(i) - reference(i)));
+  deallog << "Error distribute: " << error << std::endl;
+
+  constraints.set_zero(vec);
+  unsigned int n_nonzero = 0;
+  for (const auto &line : constraints.get_lines())
+    if (vec(line.index) != 0.)
+      ++n_nonzero;
+  deallog << "Nonzero constrained entries after set_zero: " << n_nonzero
+          << std::endl;
+}
+
+
+
+void
+test()
+{
+  const unsigned int      size = 30000;
+  AffineConstraints<double> constraints;
+
+  // constrain every third index to its two neighbors, and let every
+  // fifteenth constraint depend on another constrained index to create a
+  // chain that needs to be resolved by close()
+  for (unsigned int i = 1; i < size - 1; i += 3)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, i - 1, 0.5);
+      constraints.add_entry(i, i + 1, 0.25);
+      if (i % 15 == 1 && i + 3 < size - 1)
+        constraints.add_entry(i, i + 3, 0.125);
+      if (i % 7 == 0)
+        constraints.set_inhomogeneity(i, 1. + 0.001 * i);
+    }
+  constraints.close();
+  deallog << "Number of constraints: " << constraints.n_constraints()
+          << std::endl;
+
+  check<Vector<double>>(constraints, size);
+  check<LinearAlgebra::distributed::Vector<double>>(constraints, size);
+
+  // change the inhomogeneities after closing the object, as done for
+  // time-dependent boundary values
+  for (unsigned int i = 1; i < size - 1; i += 6)
+    constraints.set_inhomogeneity(i, -2.);
+  check<Vector<double>>(constraints, size);
+
+  // shift the constraints into the second block of a block vector
+  AffineConstraints<double> shifted;
+  shifted.copy_from(constraints);
+  shifted.shift(size);
+  BlockVector<double> block_vector(2, size);
+  {
+    Vector<double> reference(2 * size);
+    for (unsigned int i = 0; i < 2 * size; ++i)
+      reference(i) = block_vector(i) = random_value<double>();
+    for (const auto &line : shifted.get_lines())
+      {
+        double value = line.inhomogeneity;
+        for (const auto &entry : line.entries)
+          value += reference(entry.first) * entry.second;
+        reference(line.index) = value;
+      }
+    shifted.distribute(block_vector);
+    double error = 0;
+    for (unsigned int i = 0; i < 2 * size; ++i)
+      error = std::max(error, std::abs(block_vector(i) - reference(i)));
+    deallog << "Error distribute shifted block vector: " << error
+            << std::endl;
+  }
+
+  // the memory consumption must account for the compressed storage, so it
+  // should be larger than the one of a cleared object
+  const std::size_t memory = constraints.memory_consumption();
+  constraints.clear();
+  deallog << "Memory consumption decreased after clear: "
+          << (constraints.memory_consumption() < memory) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
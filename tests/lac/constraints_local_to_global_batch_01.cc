@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the variant of AffineConstraints::distribute_local_to_global()
+// that works on a batch of cells gives the same result as calling the
+// function for each cell individually. use a chain of one-dimensional
+// "cells" of degree four with vertex indices first, which creates cells
+// with and without constraints and cells with the same or with a different
+// relative order of indices
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+test()
+{
+  const unsigned int degree  = 4;
+  const unsigned int n_cells = 50;
+  const unsigned int n_dofs  = n_cells * degree + 1;
+
+  std::vector<std::vector<types::global_dof_index>> dof_indices(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    {
+      dof_indices[c].push_back(c * degree);
+      dof_indices[c].push_back((c + 1) * degree);
+      for (unsigned int i = 1; i < degree; ++i)
+        dof_indices[c].push_back(c * degree + i);
+    }
+  AffineConstraints<double> constraints;
+  constraints.add_line(0);
+  constraints.set_inhomogeneity(0, 1.);
+  constraints.add_line(n_dofs - 1);
+  constraints.add_line(10 * degree + 2);
+  constraints.add_entry(10 * degree + 2, 10 * degree, 0.5);
+  constraints.add_entry(10 * degree + 2, 11 * degree, 0.5);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(n_dofs);
+  for (const auto &indices : dof_indices)
+    constraints.add_entries_local_to_global(indices, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  // reverse the order of the interior indices on some cells, so that the
+  // sorting permutation cannot be reused from one cell to the next
+  for (unsigned int c = 15; c < n_cells; c += 7)
+    std::reverse(dof_indices[c].begin() + 2, dof_indices[c].end());
+
+  std::vector<FullMatrix<double>> local_matrices(n_cells);
+  std::vector<Vector<double>>     local_vectors(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    {
+      local_matrices[c].reinit(degree + 1, degree + 1);
+      local_vectors[c].reinit(degree + 1);
+      for (unsigned int i = 0; i <= degree; ++i)
+        {
+          for (unsigned int j = 0; j <= degree; ++j)
+            local_matrices[c](i, j) = random_value<double>();
+          local_matrices[c](i, i) += 5.;
+          local_vectors[c](i) = random_value<double>();
+        }
+    }
+
+  SparseMatrix<double> matrix_ref(sparsity), matrix(sparsity),
+    matrix_only(sparsity);
+  Vector<double> vector_ref(n_dofs), vector(n_dofs);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    constraints.distribute_local_to_global(local_matrices[c],
+                                           local_vectors[c],
+                                           dof_indices[c],
+                                           matrix_ref,
+                                           vector_ref);
+
+  // write the cells in batches of different sizes
+  for (unsigned int start = 0, batch = 1; start < n_cells;
+       start += batch, batch = std::min(batch + 3, n_cells - start))
+    {
+      constraints.distribute_local_to_global(
+        make_array_view(local_matrices.cbegin() + start,
+                        local_matrices.cbegin() + start + batch),
+        make_array_view(local_vectors.cbegin() + start,
+                        local_vectors.cbegin() + start + batch),
+        make_array_view(dof_indices.cbegin() + start,
+                        dof_indices.cbegin() + start + batch),
+        matrix,
+        vector);
+    }
+  constraints.distribute_local_to_global(
+    make_array_view(local_matrices), make_array_view(dof_indices), matrix_only);
+
+  for (const auto &entry : matrix_ref)
+    if (std::abs(entry.value() - matrix.el(entry.row(), entry.column())) >
+          1e-14 ||
+        std::abs(entry.value() - matrix_only.el(entry.row(), entry.column())) >
+          1e-14)
+      deallog << "Matrix entries differ in " << entry.row() << ' '
+              << entry.column() << std::endl;
+  vector -= vector_ref;
+  deallog << "Matrix Frobenius norm: " << matrix_ref.frobenius_norm()
+          << std::endl;
+  deallog << "Vector norm: " << vector_ref.l2_norm()
+          << ", error: " << vector.l2_norm() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
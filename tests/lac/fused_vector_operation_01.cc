@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that LinearAlgebra::FusedVectorOperation gives the same result as
+// the individual vector operations, for Vector and
+// LinearAlgebra::distributed::Vector and for vector sizes that are split
+// into several chunks and blocks in the fused implementation
+
+
+#include <deal.II/lac/fused_vector_operation.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename VectorType>
+void
+test(const unsigned int size)
+{
+  VectorType x, y, z, v, w;
+  x.reinit(size);
+  y.reinit(size);
+  z.reinit(size);
+  v.reinit(size);
+  w.reinit(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      x(i) = std::sin(0.1 * i);
+      y(i) = 1. + 0.01 * (i % 7);
+      z(i) = std::cos(0.05 * i);
+      v(i) = 0.5 - 0.001 * (i % 13);
+      w(i) = 0.1 * (i % 3);
+    }
+
+  // reference result with the individual operations
+  VectorType x_ref(x), y_ref(y), z_ref(z);
+  x_ref.add(0.3, v);
+  y_ref.sadd(-0.7, 1.5, x_ref);
+  y_ref.add(2., w);
+  z_ref.equ(0.5, y_ref);
+  z_ref.add(-1., v);
+  const double xy_ref = x_ref * y_ref;
+  const double zz_ref = z_ref * z_ref;
+  const double wz_ref = w * z_ref;
+
+  LinearAlgebra::FusedVectorOperation<VectorType> operation;
+  operation.add(x, 0.3, v);
+  operation.sadd(y, -0.7, 1.5, x, 2., w);
+  operation.sadd(z, 0., 0.5, y, -1., v);
+  AssertDimension(operation.dot(x, y), 0);
+  AssertDimension(operation.dot(z, z), 1);
+  AssertDimension(operation.dot(w, z), 2);
+  AssertDimension(operation.n_updates(), 3);
+  AssertDimension(operation.n_dots(), 3);
+  const auto results = operation.apply();
+  AssertDimension(operation.n_updates(), 0);
+  AssertDimension(operation.n_dots(), 0);
+
+  x -= x_ref;
+  y -= y_ref;
+  z -= z_ref;
+  const double vector_error =
+    std::max(x.linfty_norm(), std::max(y.linfty_norm(), z.linfty_norm()));
+  const double dot_error =
+    std::max(std::abs(results[0] - xy_ref) / (1. + std::abs(xy_ref)),
+             std::max(std::abs(results[1] - zz_ref) / (1. + std::abs(zz_ref)),
+                      std::abs(results[2] - wz_ref) / (1. + std::abs(wz_ref))));
+  deallog << "Size " << size << ": updates "
+          << (vector_error < 1e-14 ? "ok" : "wrong") << ", inner products "
+          << (dot_error < 1e-12 ? "ok" : "wrong") << std::endl;
+
+  // a single update followed by an inner product of the updated vector,
+  // which corresponds to add_and_dot()
+  VectorType a(v), b(v);
+  const double dot_ref = a.add_and_dot(-0.2, w, y_ref);
+  operation.add(b, -0.2, w);
+  operation.dot(b, y_ref);
+  const double dot = operation.apply()[0];
+  b -= a;
+  deallog << "Size " << size << ": add_and_dot "
+          << (b.linfty_norm() < 1e-14 &&
+                  std::abs(dot - dot_ref) < 1e-12 * (1. + std::abs(dot_ref)) ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int size : {1U, 17U, 255U, 1000U, 30000U, 100001U})
+    {
+      deallog.push("Vector");
+      test<Vector<double>>(size);
+      deallog.pop();
+      deallog.push("LA::distributed::Vector");
+      test<LinearAlgebra::distributed::Vector<double>>(size);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check the s-step variant of SolverGMRES on a nonsymmetric matrix with left
+// and right preconditioning, including restarts within a block, against the
+// classical variant
+
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A,
+     const PreconditionerType &  preconditioner,
+     const bool                  right_preconditioning,
+     const unsigned int          max_iterations)
+{
+  VectorType rhs, reference;
+  rhs.reinit(A.m());
+  reference.reinit(A.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = 1. + 0.01 * (i % 7);
+
+  for (const unsigned int s : {1, 2, 3, 5})
+    {
+      VectorType sol;
+      sol.reinit(A.m());
+
+      SolverControl control(500, 1e-8 * rhs.l2_norm(), false, false);
+      typename SolverGMRES<VectorType>::AdditionalData data(
+        22, right_preconditioning, true, false, s);
+      SolverGMRES<VectorType> solver(control, data);
+      solver.solve(A, sol, rhs, preconditioner);
+
+      // the s-step basis changes the rounding, so only check that the
+      // iteration count stays below a bound and that the true residual is
+      // small
+      VectorType residual;
+      residual.reinit(A.m());
+      A.vmult(residual, sol);
+      residual -= rhs;
+
+      deallog << "s = " << s << ": converged in at most " << max_iterations
+              << " iterations: " << (control.last_step() <= max_iterations)
+              << ", relative residual below 1e-6: "
+              << (residual.l2_norm() < 1e-6 * rhs.l2_norm()) << std::endl;
+
+      if (s == 1)
+        reference = sol;
+      sol -= reference;
+      deallog << "s = " << s << ": difference to s = 1 small: "
+              << (sol.l2_norm() < 1e-6 * reference.l2_norm()) << std::endl;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 24;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  deallog.push("left");
+  test<Vector<double>>(A, ssor, false, 25);
+  deallog.pop();
+  deallog.push("right");
+  test<Vector<double>>(A, ssor, true, 25);
+  deallog.pop();
+  deallog.push("identity");
+  test<Vector<double>>(A, PreconditionIdentity(), false, 130);
+  test<LinearAlgebra::distributed::Vector<double>>(A,
+                                                   PreconditionIdentity(),
+                                                   false,
+                                                   130);
+  deallog.pop();
+}
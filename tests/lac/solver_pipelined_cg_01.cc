@@ -0,0 +1,95 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that SolverPipelinedCG gives the same iterates as SolverCG on a
+// Laplace matrix, with and without preconditioner, for Vector and
+// LinearAlgebra::distributed::Vector, and that it reports the same estimate
+// of the condition number
+
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A, const PreconditionerType &preconditioner)
+{
+  VectorType rhs, sol_cg, sol_pipelined;
+  rhs.reinit(A.m());
+  sol_cg.reinit(A.m());
+  sol_pipelined.reinit(A.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = 1. + 0.01 * (i % 7);
+
+  {
+    SolverControl        control(200, 1e-10, false, false);
+    SolverCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [](const double cond) { deallog << "Condition number " << cond; });
+    solver.solve(A, sol_cg, rhs, preconditioner);
+    deallog << ", SolverCG converged in " << control.last_step()
+            << " iterations" << std::endl;
+  }
+
+  {
+    SolverControl                 control(200, 1e-10, false, false);
+    SolverPipelinedCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [](const double cond) { deallog << "Condition number " << cond; });
+    solver.solve(A, sol_pipelined, rhs, preconditioner);
+    deallog << ", SolverPipelinedCG converged in " << control.last_step()
+            << " iterations" << std::endl;
+  }
+
+  sol_pipelined -= sol_cg;
+  deallog << "Difference between solutions relative to tolerance: "
+          << (sol_pipelined.l2_norm() < 1e-8 * sol_cg.l2_norm()) << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  test<Vector<double>>(A, PreconditionIdentity());
+  test<LinearAlgebra::distributed::Vector<double>>(A, PreconditionIdentity());
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  test<Vector<double>>(A, ssor);
+}
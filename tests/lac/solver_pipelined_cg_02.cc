@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SolverPipelinedCG gives the same iterates as SolverCG for
+// LinearAlgebra::distributed::Vector distributed over several MPI
+// processes, where the inner products are summed by the non-blocking
+// reduction
+
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// a one-dimensional Laplace operator with a variable coefficient and a
+// reaction term on a vector distributed in contiguous ranges, with the
+// neighbors of each range as ghost entries
+class LaplaceOperator
+{
+public:
+  LaplaceOperator(const types::global_dof_index size)
+    : size(size)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const types::global_dof_index i : dst.locally_owned_elements())
+      {
+        double value = (0.05 + coefficient(i) + coefficient(i + 1)) * src(i);
+        if (i > 0)
+          value -= coefficient(i) * src(i - 1);
+        if (i + 1 < size)
+          value -= coefficient(i + 1) * src(i + 1);
+        dst(i) = value;
+      }
+    src.zero_out_ghost_values();
+  }
+
+private:
+  // coefficient between the entries i-1 and i
+  static double
+  coefficient(const types::global_dof_index i)
+  {
+    return 1. + 0.5 * (i % 3);
+  }
+
+  const types::global_dof_index size;
+};
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+  deallog << std::setprecision(4);
+
+  const unsigned int my_id   = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  const types::global_dof_index size  = 400;
+  const types::global_dof_index begin = size * my_id / n_procs;
+  const types::global_dof_index end   = size * (my_id + 1) / n_procs;
+
+  IndexSet owned(size);
+  owned.add_range(begin, end);
+  IndexSet ghost(size);
+  if (begin > 0)
+    ghost.add_index(begin - 1);
+  if (end < size)
+    ghost.add_index(end);
+
+  VectorType rhs(owned, ghost, MPI_COMM_WORLD);
+  for (const types::global_dof_index i : owned)
+    rhs(i) = 1. + 0.01 * (i % 7);
+  VectorType sol_cg(rhs), sol_pipelined(rhs);
+  sol_cg        = 0.;
+  sol_pipelined = 0.;
+
+  const LaplaceOperator A(size);
+
+  {
+    SolverControl        control(1000, 1e-10, false, false);
+    SolverCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [](const double cond) { deallog << "Condition number " << cond; });
+    solver.solve(A, sol_cg, rhs, PreconditionIdentity());
+    deallog << ", SolverCG converged in " << control.last_step()
+            << " iterations" << std::endl;
+  }
+
+  {
+    SolverControl                 control(1000, 1e-10, false, false);
+    SolverPipelinedCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [](const double cond) { deallog << "Condition number " << cond; });
+    solver.solve(A, sol_pipelined, rhs, PreconditionIdentity());
+    deallog << ", SolverPipelinedCG converged in " << control.last_step()
+            << " iterations" << std::endl;
+  }
+
+  // check the residual of the solution of the pipelined variant
+  VectorType residual(rhs);
+  A.vmult(residual, sol_pipelined);
+  residual -= rhs;
+  deallog << "Residual below tolerance: " << (residual.l2_norm() < 1e-8)
+          << std::endl;
+
+  sol_pipelined -= sol_cg;
+  deallog << "Difference between solutions relative to tolerance: "
+          << (sol_pipelined.l2_norm() < 1e-8 * sol_cg.l2_norm()) << std::endl;
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check SparseMatrixSELL::vmult, vmult_add, Tvmult, Tvmult_add, el and
+// precondition_Jacobi against SparseMatrix for a nonsymmetric matrix and
+// different values of sigma
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename number>
+void
+print_error(const std::string &   name,
+            const Vector<number> &difference,
+            const Vector<number> &reference)
+{
+  const number error     = difference.l2_norm() / reference.l2_norm();
+  const number tolerance = 100 * std::numeric_limits<number>::epsilon();
+  deallog << name << " error: " << (error < tolerance ? 0 : error)
+          << std::endl;
+}
+
+
+
+template <typename number>
+void
+check(const unsigned int sigma)
+{
+  const unsigned int size = 13;
+  FDMatrix           testproblem(size, size);
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  SparsityPattern sparsity(dim, dim, 10);
+  testproblem.nine_point_structure(sparsity);
+  // add some entries to get rows of different lengths
+  for (unsigned int i = 0; i < dim; i += 7)
+    sparsity.add(i, (i * 13) % dim);
+  sparsity.compress();
+
+  SparseMatrix<number> A(sparsity);
+  testproblem.nine_point(A, true);
+  for (unsigned int i = 0; i < dim; i += 7)
+    A.add(i, (i * 13) % dim, 0.5);
+
+  SparseMatrixSELL<number> B;
+  B.reinit(sparsity,
+           typename SparseMatrixSELL<number>::AdditionalData(sigma));
+  B.copy_from(A);
+  deallog << "sigma=" << sigma << " m=" << B.m() << " n=" << B.n()
+          << " nnz=" << B.n_nonzero_elements() << std::endl;
+  AssertThrow(B.n_stored_elements() >= B.n_nonzero_elements(),
+              ExcInternalError());
+
+  Vector<number> src(dim), dst1(dim), dst2(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    src(i) = random_value<number>();
+
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  dst2 -= dst1;
+  print_error("vmult", dst2, dst1);
+
+  dst1 = 1.;
+  dst2 = 1.;
+  A.vmult_add(dst1, src);
+  B.vmult_add(dst2, src);
+  dst2 -= dst1;
+  print_error("vmult_add", dst2, dst1);
+
+  A.Tvmult(dst1, src);
+  B.Tvmult(dst2, src);
+  dst2 -= dst1;
+  print_error("Tvmult", dst2, dst1);
+
+  dst1 = 1.;
+  dst2 = 1.;
+  A.Tvmult_add(dst1, src);
+  B.Tvmult_add(dst2, src);
+  dst2 -= dst1;
+  print_error("Tvmult_add", dst2, dst1);
+
+  A.precondition_Jacobi(dst1, src, 0.8);
+  B.precondition_Jacobi(dst2, src, 0.8);
+  dst2 -= dst1;
+  print_error("precondition_Jacobi", dst2, dst1);
+
+  number el_error = 0;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      el_error += std::abs(A.el(i, j) - B.el(i, j));
+  deallog << "el error: " << el_error << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  deallog.push("double");
+  check<double>(1);
+  check<double>(8);
+  check<double>(64);
+  deallog.pop();
+  deallog.push("float");
+  check<float>(1);
+  check<float>(64);
+  deallog.pop();
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Solve a Laplace problem with SolverCG on a SparseMatrixSELL, using
+// PreconditionJacobi and PreconditionChebyshev, and compare with the
+// iteration counts obtained with SparseMatrix
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename MatrixType>
+void
+solve(const MatrixType &A, const Vector<double> &rhs)
+{
+  Vector<double> sol(rhs.size());
+
+  {
+    SolverControl                  control(200, 1e-10 * rhs.l2_norm());
+    SolverCG<Vector<double>>       solver(control);
+    PreconditionJacobi<MatrixType> prec;
+    prec.initialize(A, 0.8);
+    check_solver_within_range(solver.solve(A, sol, rhs, prec),
+                              control.last_step(),
+                              60,
+                              70);
+  }
+
+  {
+    sol = 0;
+    SolverControl            control(200, 1e-10 * rhs.l2_norm());
+    SolverCG<Vector<double>> solver(control);
+    PreconditionChebyshev<MatrixType, Vector<double>> prec;
+    typename PreconditionChebyshev<MatrixType, Vector<double>>::AdditionalData
+      data;
+    data.degree          = 3;
+    data.smoothing_range = 20.;
+    prec.initialize(A, data);
+    check_solver_within_range(solver.solve(A, sol, rhs, prec),
+                              control.last_step(),
+                              20,
+                              30);
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  const unsigned int size = 32;
+  FDMatrix           testproblem(size, size);
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  SparsityPattern sparsity(dim, dim, 5);
+  testproblem.five_point_structure(sparsity);
+  sparsity.compress();
+  SparseMatrix<double> A(sparsity);
+  testproblem.five_point(A);
+
+  Vector<double> rhs(dim);
+  rhs = 1.;
+
+  deallog.push("SparseMatrix");
+  solve(A, rhs);
+  deallog.pop();
+
+  deallog.push("SparseMatrixSELL");
+  SparseMatrixSELL<double> B(A);
+  solve(B, rhs);
+  deallog.pop();
+
+  return 0;
+}
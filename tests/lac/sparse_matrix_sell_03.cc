@@ -0,0 +1,97 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check SparseMatrixSELL<float> applied to vectors of type Vector<double>
+// with and without compressed column indices, on a rectangular matrix where
+// some chunks span more than 65536 columns and hence cannot be compressed
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+check(const bool compress)
+{
+  const unsigned int n_rows = 1000;
+  const unsigned int n_cols = 100000;
+
+  DynamicSparsityPattern dsp(n_rows, n_cols);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    {
+      for (unsigned int j = 0; j < 1 + i % 7; ++j)
+        dsp.add(i, 50 * i + 3 * j);
+      // every 50th row gets an entry far away from the others
+      if (i % 50 == 0)
+        dsp.add(i, (50 * i + 80000) % n_cols);
+    }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<float> A(sparsity);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (auto it = A.begin(i); it != A.end(i); ++it)
+      it->value() = random_value<float>();
+
+  SparseMatrixSELL<float> B;
+  B.reinit(sparsity, SparseMatrixSELL<float>::AdditionalData(64, compress));
+  B.copy_from(A);
+
+  Vector<double> src(n_cols), dst1(n_rows), dst2(n_rows);
+  for (unsigned int i = 0; i < n_cols; ++i)
+    src(i) = random_value<double>();
+
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  dst2 -= dst1;
+  deallog << "compress=" << compress << " vmult error: "
+          << (dst2.l2_norm() < 1e-14 * dst1.l2_norm() ? 0. : dst2.l2_norm())
+          << std::endl;
+
+  Vector<double> tsrc(n_rows), tdst1(n_cols), tdst2(n_cols);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    tsrc(i) = random_value<double>();
+  A.Tvmult(tdst1, tsrc);
+  B.Tvmult(tdst2, tsrc);
+  tdst2 -= tdst1;
+  deallog << "compress=" << compress << " Tvmult error: "
+          << (tdst2.l2_norm() < 1e-14 * tdst1.l2_norm() ? 0. : tdst2.l2_norm())
+          << std::endl;
+
+  float el_error = 0;
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (auto it = A.begin(i); it != A.end(i); ++it)
+      el_error += std::abs(it->value() - B.el(i, it->column()));
+  deallog << "compress=" << compress << " el error: " << el_error << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  check(false);
+  check(true);
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the geometry data of Cartesian cells is deduplicated across all
+// cell batches and faces of a block-structured mesh, including the face data
+// by cells, and that the values accessed through FEEvaluation and
+// FEFaceEvaluation still match the ones computed by FEValues and
+// FEFaceValues
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  // two blocks of cells of the same size, shifted against each other
+  Triangulation<dim> tria, block_1, block_2;
+  Point<dim>         p1, p2, p3;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      p2[d] = 1.;
+      p3[d] = 1.;
+    }
+  p3[0] = 2.;
+  std::vector<unsigned int> subdivisions(dim, 3);
+  subdivisions[0] = 4;
+  GridGenerator::subdivided_hyper_rectangle(block_1, subdivisions, p1, p2);
+  Point<dim> p4 = p2;
+  p4[0]         = 1.;
+  for (unsigned int d = 1; d < dim; ++d)
+    p4[d] = 0.;
+  GridGenerator::subdivided_hyper_rectangle(block_2, subdivisions, p4, p3);
+  GridGenerator::merge_triangulations(block_1, block_2, tria);
+
+  FE_DGQ<dim>     fe(2);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const MappingQ<dim>                      mapping(1);
+  MatrixFree<dim>                          mf;
+  typename MatrixFree<dim>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim>::AdditionalData::none;
+  data.mapping_update_flags  = update_gradients | update_JxW_values;
+  data.mapping_update_flags_inner_faces =
+    update_JxW_values | update_normal_vectors | update_gradients;
+  data.mapping_update_flags_boundary_faces =
+    update_JxW_values | update_normal_vectors | update_gradients;
+  data.mapping_update_flags_faces_by_cells =
+    update_JxW_values | update_normal_vectors | update_gradients;
+  mf.reinit(mapping, dof, constraints, QGauss<1>(3), data);
+
+  const auto &mapping_info = mf.get_mapping_info();
+
+  // all cells have the same Jacobian, stored in two slots, and the faces by
+  // cells only differ in the face number
+  deallog << "Number of cell data entries: "
+          << mapping_info.cell_data[0].JxW_values.size() << std::endl;
+  deallog << "Number of face-by-cell data entries: "
+          << mapping_info.face_data_by_cells[0].JxW_values.size() << std::endl;
+  deallog << "Face data compressed: "
+          << (mapping_info.face_data[0].JxW_values.size() <
+                mf.n_inner_face_batches() + mf.n_boundary_face_batches() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  const QGauss<dim>     quadrature(3);
+  const QGauss<dim - 1> face_quadrature(3);
+  FEValues<dim>         fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_inverse_jacobians | update_JxW_values);
+  FEFaceValues<dim>     fe_face_values(mapping,
+                                   fe,
+                                   face_quadrature,
+                                   update_JxW_values | update_normal_vectors);
+
+  FEEvaluation<dim, 2>     phi(mf);
+  FEFaceEvaluation<dim, 2> phi_face(mf, true);
+
+  double error = 0;
+  for (unsigned int cell = 0; cell < mf.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      for (unsigned int v = 0; v < mf.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          fe_values.reinit(mf.get_cell_iterator(cell, v));
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            {
+              error += std::abs(phi.JxW(q)[v] - fe_values.JxW(q));
+              for (unsigned int d = 0; d < dim; ++d)
+                for (unsigned int e = 0; e < dim; ++e)
+                  error += std::abs(phi.inverse_jacobian(q)[d][e][v] -
+                                    fe_values.inverse_jacobian(q)[e][d]);
+            }
+        }
+
+      for (const unsigned int f : GeometryInfo<dim>::face_indices())
+        {
+          phi_face.reinit(cell, f);
+          for (unsigned int v = 0;
+               v < mf.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              fe_face_values.reinit(mf.get_cell_iterator(cell, v), f);
+              for (unsigned int q = 0; q < phi_face.n_q_points; ++q)
+                {
+                  error +=
+                    std::abs(phi_face.JxW(q)[v] - fe_face_values.JxW(q));
+                  for (unsigned int d = 0; d < dim; ++d)
+                    error += std::abs(phi_face.get_normal_vector(q)[d][v] -
+                                      fe_face_values.normal_vector(q)[d]);
+                }
+            }
+        }
+    }
+
+  deallog << "Error geometry: " << (error < 1e-10 ? "ok" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,253 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test MatrixFreeTools::compute_diagonal_sum_factorized() for a
+// variable-coefficient mass plus Laplace operator on a curved mesh with
+// hanging nodes and Dirichlet constraints against
+// MatrixFreeTools::compute_diagonal(), and
+// MatrixFreeTools::compute_inverse_cell_blocks_sum_factorized() against the
+// cell matrices computed by applying the operator to unit vectors
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, typename Number>
+void
+compute_coefficients(const Point<dim, Number> &p,
+                     Number &                  mass_coefficient,
+                     Tensor<2, dim, Number> &  diffusion_coefficient)
+{
+  mass_coefficient = 1. + p.square();
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int e = 0; e < dim; ++e)
+      diffusion_coefficient[d][e] =
+        (d == e) ? Number(1. + p[d] * p[d]) : Number(0.1 * (d + 2 * e + 1));
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+test()
+{
+  using VectorizedArrayType = VectorizedArray<Number>;
+  using FEEval =
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number, VectorizedArrayType>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 2 * dim);
+  tria.refine_global(1);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const MappingQ<dim> mapping(3);
+
+  const auto coefficients = [](const FEEval &              phi,
+                               const unsigned int          q,
+                               VectorizedArrayType &       mass_coefficient,
+                               Tensor<2, dim, VectorizedArrayType> &diffusion) {
+    compute_coefficients(phi.quadrature_point(q), mass_coefficient, diffusion);
+  };
+
+  // continuous elements: compare the diagonal against the one computed by
+  // applying the operator to all unit vectors
+  {
+    FE_Q<dim>       fe(fe_degree);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+
+    AffineConstraints<Number> constraints;
+    DoFTools::make_hanging_node_constraints(dof, constraints);
+    DoFTools::make_zero_boundary_constraints(dof, 0, constraints);
+    constraints.close();
+
+    deallog << "Testing " << fe.get_name() << std::endl;
+
+    typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+      additional_data;
+    additional_data.mapping_update_flags =
+      update_values | update_gradients | update_JxW_values |
+      update_quadrature_points;
+    MatrixFree<dim, Number, VectorizedArrayType> matrix_free;
+    matrix_free.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+
+    LinearAlgebra::distributed::Vector<Number> diagonal, diagonal_ref;
+    matrix_free.initialize_dof_vector(diagonal);
+    matrix_free.initialize_dof_vector(diagonal_ref);
+
+    MatrixFreeTools::compute_diagonal<dim,
+                                      fe_degree,
+                                      fe_degree + 1,
+                                      1,
+                                      Number,
+                                      VectorizedArrayType>(
+      matrix_free, diagonal_ref, [](FEEval &phi) {
+        phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          {
+            VectorizedArrayType                 mass_coefficient;
+            Tensor<2, dim, VectorizedArrayType> diffusion;
+            compute_coefficients(phi.quadrature_point(q),
+                                 mass_coefficient,
+                                 diffusion);
+            phi.submit_value(mass_coefficient * phi.get_value(q), q);
+            phi.submit_gradient(diffusion * phi.get_gradient(q), q);
+          }
+        phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+      });
+
+    MatrixFreeTools::compute_diagonal_sum_factorized<dim,
+                                                     fe_degree,
+                                                     fe_degree + 1,
+                                                     Number,
+                                                     VectorizedArrayType>(
+      matrix_free, diagonal, coefficients);
+
+    diagonal -= diagonal_ref;
+    deallog << "Error diagonal: "
+            << (diagonal.linfty_norm() <
+                    1000. * std::numeric_limits<Number>::epsilon() *
+                      diagonal_ref.linfty_norm() ?
+                  "ok" :
+                  "wrong")
+            << std::endl;
+  }
+
+  // discontinuous elements: check that the inverse cell blocks times the
+  // cell matrices give the identity matrix
+  {
+    FE_DGQ<dim>     fe(fe_degree);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+
+    AffineConstraints<Number> constraints;
+    constraints.close();
+
+    deallog << "Testing " << fe.get_name() << std::endl;
+
+    typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+      additional_data;
+    additional_data.mapping_update_flags =
+      update_values | update_gradients | update_JxW_values |
+      update_quadrature_points;
+    MatrixFree<dim, Number, VectorizedArrayType> matrix_free;
+    matrix_free.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+
+    AlignedVector<VectorizedArrayType> inverse_blocks;
+    MatrixFreeTools::compute_inverse_cell_blocks_sum_factorized<
+      dim,
+      fe_degree,
+      fe_degree + 1,
+      Number,
+      VectorizedArrayType>(matrix_free, inverse_blocks, coefficients);
+
+    FEEval             phi(matrix_free);
+    const unsigned int n = phi.dofs_per_cell;
+    AssertDimension(inverse_blocks.size(),
+                    matrix_free.n_cell_batches() * n * n);
+
+    double                             error = 0;
+    AlignedVector<VectorizedArrayType> matrix(n * n);
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        phi.reinit(cell);
+        for (unsigned int j = 0; j < n; ++j)
+          {
+            for (unsigned int i = 0; i < n; ++i)
+              phi.begin_dof_values()[i] = Number(i == j);
+            phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              {
+                VectorizedArrayType                 mass_coefficient;
+                Tensor<2, dim, VectorizedArrayType> diffusion;
+                compute_coefficients(phi.quadrature_point(q),
+                                     mass_coefficient,
+                                     diffusion);
+                phi.submit_value(mass_coefficient * phi.get_value(q), q);
+                phi.submit_gradient(diffusion * phi.get_gradient(q), q);
+              }
+            phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+            for (unsigned int i = 0; i < n; ++i)
+              matrix[i * n + j] = phi.begin_dof_values()[i];
+          }
+
+        const VectorizedArrayType *inverse =
+          inverse_blocks.data() + cell * n * n;
+        for (unsigned int v = 0;
+             v < matrix_free.n_active_entries_per_cell_batch(cell);
+             ++v)
+          for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+              {
+                double sum = 0;
+                for (unsigned int k = 0; k < n; ++k)
+                  sum += inverse[i * n + k][v] * matrix[k * n + j][v];
+                error += std::abs(sum - (i == j ? 1. : 0.));
+              }
+      }
+
+    deallog << "Error inverse blocks: "
+            << (error < 1e4 * std::numeric_limits<Number>::epsilon() *
+                          matrix_free.n_physical_cells() * n ?
+                  "ok" :
+                  "wrong")
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 1, double>();
+  test<2, 4, double>();
+  test<2, 3, float>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3, 2, double>();
+  test<3, 3, float>();
+  deallog.pop();
+}
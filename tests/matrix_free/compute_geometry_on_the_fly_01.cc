@@ -0,0 +1,210 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that MatrixFree::AdditionalData::compute_geometry_on_the_fly gives
+// the same results as the stored geometry on a curved mesh with MappingQ,
+// for values, gradients and hessians (that need the Jacobian gradients) and
+// the quadrature points, using both FEEvaluation::reinit() on a cell batch
+// and on a list of cells, and that the geometry uses less memory.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+apply_operator(const MatrixFree<dim, Number> &                   data,
+               LinearAlgebra::distributed::Vector<Number> &      dst,
+               const LinearAlgebra::distributed::Vector<Number> &src)
+{
+  data.template cell_loop<LinearAlgebra::distributed::Vector<Number>,
+                          LinearAlgebra::distributed::Vector<Number>>(
+    [](const MatrixFree<dim, Number> &                   data,
+       LinearAlgebra::distributed::Vector<Number> &      dst,
+       const LinearAlgebra::distributed::Vector<Number> &src,
+       const std::pair<unsigned int, unsigned int> &     cell_range) {
+      FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients |
+                                EvaluationFlags::hessians);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            {
+              const Point<dim, VectorizedArray<Number>> p =
+                phi.quadrature_point(q);
+              phi.submit_value(phi.get_value(q) * p.square() +
+                                 phi.get_laplacian(q),
+                               q);
+              phi.submit_gradient(phi.get_gradient(q), q);
+            }
+          phi.integrate_scatter(EvaluationFlags::values |
+                                  EvaluationFlags::gradients,
+                                dst);
+        }
+    },
+    dst,
+    src,
+    true);
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+check_lanes(const MatrixFree<dim, Number> &data,
+            const MatrixFree<dim, Number> &data_ref)
+{
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_ref(data_ref);
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+
+  double error = 0, norm = 0;
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      // use the cells of two consecutive batches in reverse order
+      std::array<unsigned int, n_lanes> cell_ids;
+      cell_ids.fill(numbers::invalid_unsigned_int);
+      const unsigned int other = (cell + 1) % data.n_cell_batches();
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int batch = v % 2 ? cell : other;
+          const unsigned int lane  = n_lanes - 1 - v / 2;
+          if (lane < data.n_active_entries_per_cell_batch(batch))
+            cell_ids[v] = batch * n_lanes + lane;
+        }
+      phi.reinit(cell_ids);
+      phi_ref.reinit(cell_ids);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          if (cell_ids[v] != numbers::invalid_unsigned_int)
+            {
+              error += std::abs(phi.JxW(q)[v] - phi_ref.JxW(q)[v]);
+              norm += std::abs(phi_ref.JxW(q)[v]);
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  error += std::abs(phi.quadrature_point(q)[d][v] -
+                                    phi_ref.quadrature_point(q)[d][v]);
+                  norm += std::abs(phi_ref.quadrature_point(q)[d][v]);
+                  for (unsigned int e = 0; e < dim; ++e)
+                    {
+                      error += std::abs(phi.inverse_jacobian(q)[d][e][v] -
+                                        phi_ref.inverse_jacobian(q)[d][e][v]);
+                      norm += std::abs(phi_ref.inverse_jacobian(q)[d][e][v]);
+                    }
+                }
+            }
+    }
+  deallog << "Error geometry on cell lists: "
+          << (error < 100. * std::numeric_limits<Number>::epsilon() * norm ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 2 * dim);
+  tria.refine_global(4 - dim);
+
+  const MappingQ<dim> mapping(4);
+  FE_Q<dim>           fe(fe_degree);
+  DoFHandler<dim>     dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << " with "
+          << (std::is_same<Number, float>::value ? "float" : "double")
+          << std::endl;
+
+  MatrixFree<dim, Number> data_ref, data;
+  {
+    typename MatrixFree<dim, Number>::AdditionalData additional_data;
+    additional_data.mapping_update_flags =
+      update_values | update_gradients | update_hessians | update_JxW_values |
+      update_quadrature_points;
+    data_ref.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+    additional_data.compute_geometry_on_the_fly = true;
+    data.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+  }
+
+  deallog << "Geometry memory reduced: "
+          << (data.get_mapping_info().memory_consumption() <
+              data_ref.get_mapping_info().memory_consumption())
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<Number> in, out, ref;
+  data.initialize_dof_vector(in);
+  data.initialize_dof_vector(out);
+  data.initialize_dof_vector(ref);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    in.local_element(i) = random_value<Number>();
+
+  apply_operator<dim, fe_degree>(data_ref, ref, in);
+  apply_operator<dim, fe_degree>(data, out, in);
+  out -= ref;
+  deallog << "Error operator evaluation: "
+          << (out.linfty_norm() <
+                  1000. * std::numeric_limits<Number>::epsilon() *
+                    ref.linfty_norm() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+
+  check_lanes<dim, fe_degree>(data, data_ref);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2, double>();
+  test<2, 4, float>();
+  test<3, 3, double>();
+  test<3, 2, float>();
+}
@@ -0,0 +1,157 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check MatrixFree::copy_from() from a MatrixFree<dim, double> object to a
+// MatrixFree<dim, float> object with the same number of SIMD lanes: The
+// DoFInfo must be shared and a Laplace operator in float, applied to both
+// float and double vectors, must match the one from a float object set up
+// with reinit().
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename VectorType>
+void
+apply_laplace(const MatrixFree<dim, float, VectorizedArray<float, 1>> &data,
+              VectorType &                                             dst,
+              const VectorType &                                       src)
+{
+  // loop over the cells by hand rather than with MatrixFree::cell_loop(),
+  // which requires the vector type to match the number type of MatrixFree
+  dst = 0;
+  FEEvaluation<dim,
+               fe_degree,
+               fe_degree + 1,
+               1,
+               float,
+               VectorizedArray<float, 1>>
+    phi(data);
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.gather_evaluate(src, EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        phi.submit_gradient(phi.get_gradient(q), q);
+      phi.integrate_scatter(EvaluationFlags::gradients, dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(4 - dim);
+
+  const MappingQ<dim> mapping(3);
+  FE_Q<dim>           fe(fe_degree);
+  DoFHandler<dim>     dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  MatrixFree<dim, double, VectorizedArray<double, 1>> data_double;
+  MatrixFree<dim, float, VectorizedArray<float, 1>>   data_float, data_copy;
+  {
+    typename MatrixFree<dim, double, VectorizedArray<double, 1>>::AdditionalData
+      additional_data;
+    additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+    data_double.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+  }
+  {
+    typename MatrixFree<dim, float, VectorizedArray<float, 1>>::AdditionalData
+      additional_data;
+    additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+    data_float.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+  }
+  data_copy.copy_from(data_double);
+
+  deallog << "DoFInfo shared: "
+          << (&data_copy.get_dof_info() == &data_double.get_dof_info())
+          << std::endl;
+  deallog << "Geometry memory reduced: "
+          << (data_copy.get_mapping_info().memory_consumption() <
+              data_double.get_mapping_info().memory_consumption())
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<float> in, out, ref;
+  data_float.initialize_dof_vector(in);
+  data_float.initialize_dof_vector(out);
+  data_float.initialize_dof_vector(ref);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    in.local_element(i) = random_value<float>();
+
+  apply_laplace<dim, fe_degree>(data_float, ref, in);
+  apply_laplace<dim, fe_degree>(data_copy, out, in);
+  out -= ref;
+  deallog << "Error float vectors: "
+          << (out.linfty_norm() <
+                  100. * std::numeric_limits<float>::epsilon() *
+                    ref.linfty_norm() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+
+  // mixed precision: float data, double vectors
+  LinearAlgebra::distributed::Vector<double> in_d, out_d;
+  data_double.initialize_dof_vector(in_d);
+  data_double.initialize_dof_vector(out_d);
+  in_d = in;
+  apply_laplace<dim, fe_degree>(data_copy, out_d, in_d);
+  out = out_d;
+  out -= ref;
+  deallog << "Error double vectors: "
+          << (out.linfty_norm() <
+                  100. * std::numeric_limits<float>::epsilon() *
+                    ref.linfty_norm() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 3>();
+  test<3, 2>();
+}
@@ -0,0 +1,230 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check MatrixFree::copy_from() from a MatrixFree<dim, double> object to a
+// MatrixFree<dim, float> object with the default SIMD types, where the float
+// type usually has more lanes than the double type. A Laplace operator with
+// hanging node constraints and a DG operator with face integrals in float
+// must match the ones from a float object set up with reinit(). The output
+// assumes a build with vectorization, where the DoFInfo can not be shared.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+apply_laplace(const MatrixFree<dim, float> &                   data,
+              LinearAlgebra::distributed::Vector<float> &      dst,
+              const LinearAlgebra::distributed::Vector<float> &src)
+{
+  dst = 0;
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, float> phi(data);
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.gather_evaluate(src, EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        phi.submit_gradient(phi.get_gradient(q), q);
+      phi.integrate_scatter(EvaluationFlags::gradients, dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree>
+void
+apply_dg(const MatrixFree<dim, float> &                   data,
+         LinearAlgebra::distributed::Vector<float> &      dst,
+         const LinearAlgebra::distributed::Vector<float> &src)
+{
+  dst = 0;
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, float> phi(data);
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.gather_evaluate(src, EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        phi.submit_gradient(phi.get_gradient(q), q);
+      phi.integrate_scatter(EvaluationFlags::gradients, dst);
+    }
+
+  // penalize the jump of the values on inner faces and the values on the
+  // boundary
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, float> phi_m(data, true);
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, float> phi_p(data,
+                                                                  false);
+  for (unsigned int face = 0; face < data.n_inner_face_batches(); ++face)
+    {
+      phi_m.reinit(face);
+      phi_p.reinit(face);
+      phi_m.gather_evaluate(src, EvaluationFlags::values);
+      phi_p.gather_evaluate(src, EvaluationFlags::values);
+      for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+        {
+          const auto jump = phi_m.get_value(q) - phi_p.get_value(q);
+          phi_m.submit_value(jump, q);
+          phi_p.submit_value(-jump, q);
+        }
+      phi_m.integrate_scatter(EvaluationFlags::values, dst);
+      phi_p.integrate_scatter(EvaluationFlags::values, dst);
+    }
+  for (unsigned int face = data.n_inner_face_batches();
+       face < data.n_inner_face_batches() + data.n_boundary_face_batches();
+       ++face)
+    {
+      phi_m.reinit(face);
+      phi_m.gather_evaluate(src, EvaluationFlags::values);
+      for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+        phi_m.submit_value(phi_m.get_value(q), q);
+      phi_m.integrate_scatter(EvaluationFlags::values, dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename ApplyFunction>
+void
+compare(const DoFHandler<dim> &                                   dof,
+        const AffineConstraints<double> &                         constraints,
+        const typename MatrixFree<dim, double>::AdditionalData &data_in,
+        const ApplyFunction &                                     apply)
+{
+  const MappingQ<dim> mapping(3);
+
+  MatrixFree<dim, double> data_double;
+  MatrixFree<dim, float>  data_float, data_copy;
+  data_double.reinit(
+    mapping, dof, constraints, QGauss<1>(fe_degree + 1), data_in);
+  {
+    typename MatrixFree<dim, float>::AdditionalData additional_data;
+    additional_data.mapping_update_flags = data_in.mapping_update_flags;
+    additional_data.mapping_update_flags_inner_faces =
+      data_in.mapping_update_flags_inner_faces;
+    additional_data.mapping_update_flags_boundary_faces =
+      data_in.mapping_update_flags_boundary_faces;
+    data_float.reinit(
+      mapping, dof, constraints, QGauss<1>(fe_degree + 1), additional_data);
+  }
+  data_copy.copy_from(data_double);
+
+  // with the default types, float has more SIMD lanes than double on all
+  // platforms with vectorization, so the index data is converted to the
+  // wider layout rather than shared
+  deallog << "DoFInfo shared: "
+          << (&data_copy.get_dof_info() == &data_double.get_dof_info())
+          << std::endl;
+  deallog << "Batches kept: "
+          << (data_copy.n_cell_batches() == data_double.n_cell_batches() &&
+              data_copy.n_inner_face_batches() ==
+                data_double.n_inner_face_batches())
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<float> in, out, ref;
+  data_float.initialize_dof_vector(in);
+  data_float.initialize_dof_vector(out);
+  data_float.initialize_dof_vector(ref);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    if (constraints.is_constrained(i) == false)
+      in.local_element(i) = random_value<float>();
+
+  apply(data_float, ref, in);
+  apply(data_copy, out, in);
+  out -= ref;
+  deallog << "Error: "
+          << (out.linfty_norm() <
+                  100. * std::numeric_limits<float>::epsilon() *
+                    ref.linfty_norm() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3 - dim);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  {
+    FE_Q<dim>       fe(fe_degree);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+    AffineConstraints<double> constraints;
+    DoFTools::make_hanging_node_constraints(dof, constraints);
+    DoFTools::make_zero_boundary_constraints(dof, constraints);
+    constraints.close();
+
+    deallog << "Testing " << fe.get_name() << std::endl;
+    typename MatrixFree<dim, double>::AdditionalData additional_data;
+    additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+    compare<dim, fe_degree>(dof,
+                            constraints,
+                            additional_data,
+                            apply_laplace<dim, fe_degree>);
+  }
+  {
+    FE_DGQ<dim>     fe(fe_degree);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+    AffineConstraints<double> constraints;
+    constraints.close();
+
+    deallog << "Testing " << fe.get_name() << std::endl;
+    typename MatrixFree<dim, double>::AdditionalData additional_data;
+    additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+    additional_data.mapping_update_flags_inner_faces    = update_JxW_values;
+    additional_data.mapping_update_flags_boundary_faces = update_JxW_values;
+    compare<dim, fe_degree>(dof,
+                            constraints,
+                            additional_data,
+                            apply_dg<dim, fe_degree>);
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 3>();
+  test<3, 2>();
+}
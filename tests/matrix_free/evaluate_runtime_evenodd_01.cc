@@ -0,0 +1,286 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check FEEvaluation and FEFaceEvaluation with polynomial degree and number
+// of quadrature points only known at run time for combinations that are not
+// pre-compiled (over-integration and high degrees), which use the even-odd
+// kernels with run time sizes, against FEValues and FEFaceValues
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test(const unsigned int degree, const unsigned int n_q_points_1d)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(4 - dim);
+
+  // affine but not Cartesian mesh
+  GridTools::transform(
+    [](const Point<dim> &p) {
+      Point<dim> result = p;
+      result[0] += 0.3 * p[dim - 1];
+      result[dim - 1] *= 1.2;
+      return result;
+    },
+    tria);
+
+  FE_DGQ<dim>     fe(degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << " with " << n_q_points_1d
+          << " quadrature points" << std::endl;
+
+  const MappingQ<dim>                      mapping(1);
+  MatrixFree<dim>                          mf;
+  typename MatrixFree<dim>::AdditionalData data;
+  data.mapping_update_flags =
+    update_values | update_gradients | update_hessians | update_JxW_values;
+  data.mapping_update_flags_inner_faces =
+    update_values | update_gradients | update_JxW_values;
+  data.mapping_update_flags_boundary_faces =
+    update_values | update_gradients | update_JxW_values;
+  data.mapping_update_flags_faces_by_cells =
+    update_values | update_gradients | update_JxW_values;
+  mf.reinit(mapping, dof, constraints, QGauss<1>(n_q_points_1d), data);
+
+  Vector<double> src(dof.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  const QGauss<dim>     quadrature(n_q_points_1d);
+  const QGauss<dim - 1> face_quadrature(n_q_points_1d);
+  FEValues<dim>         fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients | update_hessians |
+                            update_JxW_values);
+  FEFaceValues<dim>     fe_face_values(mapping,
+                                   fe,
+                                   face_quadrature,
+                                   update_values | update_gradients |
+                                     update_JxW_values);
+
+  const unsigned int          dofs_per_cell = fe.n_dofs_per_cell();
+  std::vector<double>         values(quadrature.size());
+  std::vector<Tensor<1, dim>> gradients(quadrature.size());
+  std::vector<Tensor<2, dim>> hessians(quadrature.size());
+  std::vector<double>         face_values(face_quadrature.size());
+  std::vector<Tensor<1, dim>> face_gradients(face_quadrature.size());
+  Vector<double>              cell_src(dofs_per_cell);
+
+  FEEvaluation<dim, -1>     phi(mf);
+  FEFaceEvaluation<dim, -1> phi_face(mf, true);
+
+  double error_cell_eval = 0, error_cell_int = 0, error_face_eval = 0,
+         error_face_int = 0, norm_eval = 0, norm_int = 0, norm_face_eval = 0,
+         norm_face_int = 0;
+  for (unsigned int cell = 0; cell < mf.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      for (unsigned int v = 0; v < mf.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          mf.get_cell_iterator(cell, v)->get_dof_values(src, cell_src);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            phi.begin_dof_values()[i][v] = cell_src(i);
+        }
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients |
+                   EvaluationFlags::hessians);
+      for (unsigned int v = 0; v < mf.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          fe_values.reinit(mf.get_cell_iterator(cell, v));
+          fe_values.get_function_values(src, values);
+          fe_values.get_function_gradients(src, gradients);
+          fe_values.get_function_hessians(src, hessians);
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            {
+              error_cell_eval += std::abs(phi.get_value(q)[v] - values[q]);
+              norm_eval += std::abs(values[q]);
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  error_cell_eval +=
+                    std::abs(phi.get_gradient(q)[d][v] - gradients[q][d]);
+                  norm_eval += std::abs(gradients[q][d]);
+                  for (unsigned int e = 0; e < dim; ++e)
+                    {
+                      error_cell_eval += std::abs(phi.get_hessian(q)[d][e][v] -
+                                                  hessians[q][d][e]);
+                      norm_eval += std::abs(hessians[q][d][e]);
+                    }
+                }
+            }
+        }
+
+      // test with the same function, giving the entries of a mass plus
+      // Laplace plus biharmonic-type operator
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        {
+          phi.submit_value(phi.get_value(q), q);
+          phi.submit_gradient(phi.get_gradient(q), q);
+          phi.submit_hessian(phi.get_hessian(q), q);
+        }
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients |
+                    EvaluationFlags::hessians);
+      for (unsigned int v = 0; v < mf.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          fe_values.reinit(mf.get_cell_iterator(cell, v));
+          fe_values.get_function_values(src, values);
+          fe_values.get_function_gradients(src, gradients);
+          fe_values.get_function_hessians(src, hessians);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              double sum = 0;
+              for (unsigned int q = 0; q < quadrature.size(); ++q)
+                sum += (fe_values.shape_value(i, q) * values[q] +
+                        fe_values.shape_grad(i, q) * gradients[q] +
+                        scalar_product(fe_values.shape_hessian(i, q),
+                                       hessians[q])) *
+                       fe_values.JxW(q);
+              error_cell_int += std::abs(phi.begin_dof_values()[i][v] - sum);
+              norm_int += std::abs(sum);
+            }
+        }
+
+      for (const unsigned int f : GeometryInfo<dim>::face_indices())
+        {
+          phi_face.reinit(cell, f);
+          for (unsigned int v = 0;
+               v < mf.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              mf.get_cell_iterator(cell, v)->get_dof_values(src, cell_src);
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                phi_face.begin_dof_values()[i][v] = cell_src(i);
+            }
+          phi_face.evaluate(EvaluationFlags::values |
+                            EvaluationFlags::gradients);
+          for (unsigned int v = 0;
+               v < mf.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              fe_face_values.reinit(mf.get_cell_iterator(cell, v), f);
+              fe_face_values.get_function_values(src, face_values);
+              fe_face_values.get_function_gradients(src, face_gradients);
+              for (unsigned int q = 0; q < face_quadrature.size(); ++q)
+                {
+                  error_face_eval +=
+                    std::abs(phi_face.get_value(q)[v] - face_values[q]);
+                  norm_face_eval += std::abs(face_values[q]);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      error_face_eval += std::abs(
+                        phi_face.get_gradient(q)[d][v] - face_gradients[q][d]);
+                      norm_face_eval += std::abs(face_gradients[q][d]);
+                    }
+                }
+            }
+
+          for (unsigned int q = 0; q < phi_face.n_q_points; ++q)
+            {
+              phi_face.submit_value(phi_face.get_value(q), q);
+              phi_face.submit_gradient(phi_face.get_gradient(q), q);
+            }
+
+          phi_face.integrate(EvaluationFlags::values |
+                             EvaluationFlags::gradients);
+          for (unsigned int v = 0;
+               v < mf.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              fe_face_values.reinit(mf.get_cell_iterator(cell, v), f);
+              fe_face_values.get_function_values(src, face_values);
+              fe_face_values.get_function_gradients(src, face_gradients);
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                {
+                  double sum = 0;
+                  for (unsigned int q = 0; q < face_quadrature.size(); ++q)
+                    sum +=
+                      (fe_face_values.shape_value(i, q) * face_values[q] +
+                       fe_face_values.shape_grad(i, q) * face_gradients[q]) *
+                      fe_face_values.JxW(q);
+                  error_face_int +=
+                    std::abs(phi_face.begin_dof_values()[i][v] - sum);
+                  norm_face_int += std::abs(sum);
+                }
+            }
+        }
+    }
+
+  const double tolerance = 1e-12;
+  deallog << "Error cell evaluate: "
+          << (error_cell_eval < tolerance * norm_eval ? "ok" : "wrong")
+          << std::endl;
+  deallog << "Error cell integrate: "
+          << (error_cell_int < tolerance * norm_int ? "ok" : "wrong")
+          << std::endl;
+  deallog << "Error face evaluate: "
+          << (error_face_eval < tolerance * norm_face_eval ? "ok" : "wrong")
+          << std::endl;
+  deallog << "Error face integrate: "
+          << (error_face_int < tolerance * norm_face_int ? "ok" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(1, 4);
+  test<2>(2, 5);
+  test<2>(3, 6);
+  test<2>(4, 9);
+  test<2>(7, 8);
+  test<2>(8, 13);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(2, 5);
+  test<3>(3, 7);
+  test<3>(4, 8);
+  deallog.pop();
+}
@@ -0,0 +1,249 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// tests FEFaceEvaluation::gather_evaluate() for bases that are not nodal at
+// the cell boundaries (FE_DGQLegendre, FE_DGQArbitraryNodes with Gauss
+// points), which interpolates to the face while reading the vector entries,
+// against read_dof_values() and evaluate() for values, gradients and
+// hessians. The degrees of freedom are interleaved between the cells of a
+// cell batch, for which gather_evaluate() takes this path.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim, int fe_degree, typename number>
+class MatrixFreeTest
+{
+public:
+  MatrixFreeTest(const MatrixFree<dim, number> &data)
+    : data(data)
+    , max_difference(0.)
+    , sum_norms(0.)
+  {}
+
+  ~MatrixFreeTest()
+  {
+    deallog << "Sum of absolute face values and derivatives: " << sum_norms
+            << std::endl;
+    deallog << "Maximum relative difference between variants: "
+            << filter_out_small_numbers(max_difference, 1e-12) << std::endl;
+  }
+
+  void
+  check_error(Vector<number> &src) const
+  {
+    data.loop(&MatrixFreeTest::local_apply,
+              &MatrixFreeTest::local_apply_face,
+              &MatrixFreeTest::local_apply_face,
+              this,
+              src,
+              src);
+  }
+
+private:
+  void
+  local_apply(const MatrixFree<dim, number> &,
+              Vector<number> &,
+              const Vector<number> &,
+              const std::pair<unsigned int, unsigned int> &) const
+  {}
+
+  void
+  compare(FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> &ref,
+          FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> &check,
+          const Vector<number> &                                      src,
+          const unsigned int                                          face,
+          const EvaluationFlags::EvaluationFlags flags) const
+  {
+    ref.reinit(face);
+    check.reinit(face);
+
+    ref.read_dof_values(src);
+    ref.evaluate(flags);
+    check.gather_evaluate(src, flags);
+
+    for (unsigned int q = 0; q < ref.n_q_points; ++q)
+      for (unsigned int v = 0; v < VectorizedArray<number>::size(); ++v)
+        {
+          double diff = 0, norm = 0;
+          if (flags & EvaluationFlags::values)
+            {
+              diff += std::abs(ref.get_value(q)[v] - check.get_value(q)[v]);
+              norm += std::abs(ref.get_value(q)[v]);
+            }
+          if (flags & EvaluationFlags::gradients)
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                diff += std::abs(ref.get_gradient(q)[d][v] -
+                                 check.get_gradient(q)[d][v]);
+                norm += std::abs(ref.get_gradient(q)[d][v]);
+              }
+          if (flags & EvaluationFlags::hessians)
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                {
+                  diff += std::abs(ref.get_hessian(q)[d][e][v] -
+                                   check.get_hessian(q)[d][e][v]);
+                  norm += std::abs(ref.get_hessian(q)[d][e][v]);
+                }
+          max_difference = std::max(max_difference, diff / (1. + norm));
+          sum_norms += norm;
+        }
+  }
+
+  void
+  local_apply_face(
+    const MatrixFree<dim, number> &data,
+    Vector<number> &,
+    const Vector<number> &                       src,
+    const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> ref(data, true);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> check(data,
+                                                                     true);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> refr(data,
+                                                                    false);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, number> checkr(data,
+                                                                      false);
+
+    for (const auto flags :
+         {EvaluationFlags::values,
+          EvaluationFlags::values | EvaluationFlags::gradients,
+          EvaluationFlags::values | EvaluationFlags::gradients |
+            EvaluationFlags::hessians})
+      for (unsigned int face = face_range.first; face < face_range.second;
+           ++face)
+        {
+          compare(ref, check, src, face, flags);
+          if (face < data.n_inner_face_batches())
+            compare(refr, checkr, src, face, flags);
+        }
+  }
+
+  const MatrixFree<dim, number> &data;
+  mutable double                 max_difference;
+  mutable double                 sum_norms;
+};
+
+
+
+// renumber the degrees of freedom such that the k-th degree of freedom of
+// the j-th cell in a cell batch gets the index k * n_lanes + j relative to
+// the first index of the batch, which gives interleaved index storage
+template <int dim, typename number>
+void
+interleave_dofs(const MatrixFree<dim, number> &data, DoFHandler<dim> &dof)
+{
+  const unsigned int dofs_per_cell = dof.get_fe().n_dofs_per_cell();
+  std::vector<types::global_dof_index> renumbering(dof.n_dofs());
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  types::global_dof_index              offset = 0;
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      const unsigned int n_lanes = data.n_active_entries_per_cell_batch(cell);
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          data.get_cell_iterator(cell, v)->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            renumbering[dof_indices[i]] = offset + i * n_lanes + v;
+        }
+      offset += dofs_per_cell * n_lanes;
+    }
+  dof.renumber_dofs(renumbering);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  if (dim == 2)
+    tria.refine_global(1);
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  using number = double;
+
+  MatrixFree<dim, number> mf_data;
+  {
+    const QGauss<1>                                  quad(fe_degree + 1);
+    typename MatrixFree<dim, number>::AdditionalData data;
+    data.tasks_parallel_scheme = MatrixFree<dim, number>::AdditionalData::none;
+    data.mapping_update_flags_inner_faces =
+      (update_gradients | update_hessians | update_JxW_values);
+    data.mapping_update_flags_boundary_faces =
+      (update_gradients | update_hessians | update_JxW_values);
+
+    mf_data.reinit(MappingQ1<dim>(), dof, constraints, quad, data);
+    interleave_dofs(mf_data, dof);
+    mf_data.reinit(MappingQ1<dim>(), dof, constraints, quad, data);
+  }
+
+  MatrixFreeTest<dim, fe_degree, number> mf(mf_data);
+
+  Vector<number> in(dof.n_dofs());
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    in(i) = random_value<double>();
+
+  mf.check_error(in);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 2>(FE_DGQLegendre<2>(2));
+  test<2, 2>(FE_DGQArbitraryNodes<2>(QGauss<1>(3)));
+  test<2, 5>(FE_DGQLegendre<2>(5));
+  deallog.pop();
+  deallog.push("3d");
+  test<3, 1>(FE_DGQArbitraryNodes<3>(QGauss<1>(2)));
+  test<3, 3>(FE_DGQLegendre<3>(3));
+  test<3, 4>(FE_DGQArbitraryNodes<3>(QGauss<1>(5)));
+  deallog.pop();
+}
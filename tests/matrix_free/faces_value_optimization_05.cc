@@ -0,0 +1,449 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// like faces_value_optimization_04, testing FEFaceEvaluation::gather_evaluate()
+// for bases that are not nodal at the cell boundaries against
+// read_dof_values() and evaluate(), but for the remaining code paths of the
+// interpolation to the face while reading the vector entries:
+// - meshes with all kinds of face orientations in 3d,
+// - vectors with the degrees of freedom interleaved between the cells of a
+//   cell batch, which results in interleaved, strided and mixed-stride
+//   storage of the indices on the faces; with contiguous indices,
+//   gather_evaluate() uses read_dof_values() and evaluate() as well,
+// - the element-centric loop, where the lanes of the exterior side can
+//   refer to different faces of the neighbors or to no neighbor at all;
+//   there, the reference are the values computed on the respective face of
+//   the neighbor, re-oriented to the quadrature points of the own face
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+// a mesh of two cells, where the second cell is rotated in one of eight ways
+// against the first one, see also matrix_vector_faces_25
+void
+generate_grid(Triangulation<3> &triangulation, const unsigned int orientation)
+{
+  const Point<3>        vertices_1[] = {Point<3>(-1., -1., -3.),
+                                 Point<3>(+1., -1., -3.),
+                                 Point<3>(-1., +1., -3.),
+                                 Point<3>(+1., +1., -3.),
+                                 Point<3>(-1., -1., -1.),
+                                 Point<3>(+1., -1., -1.),
+                                 Point<3>(-1., +1., -1.),
+                                 Point<3>(+1., +1., -1.),
+                                 Point<3>(-1., -1., +1.),
+                                 Point<3>(+1., -1., +1.),
+                                 Point<3>(-1., +1., +1.),
+                                 Point<3>(+1., +1., +1.)};
+  std::vector<Point<3>> vertices(&vertices_1[0], &vertices_1[12]);
+
+  std::vector<CellData<3>> cells(2, CellData<3>());
+
+  const unsigned int cell_vertices_0[GeometryInfo<3>::vertices_per_cell] = {
+    0, 1, 2, 3, 4, 5, 6, 7};
+  const unsigned int cell_vertices_1[8][GeometryInfo<3>::vertices_per_cell] = {
+    {4, 5, 6, 7, 8, 9, 10, 11},
+    {5, 7, 4, 6, 9, 11, 8, 10},
+    {7, 6, 5, 4, 11, 10, 9, 8},
+    {6, 4, 7, 5, 10, 8, 11, 9},
+    {9, 8, 11, 10, 5, 4, 7, 6},
+    {8, 10, 9, 11, 4, 6, 5, 7},
+    {10, 11, 8, 9, 6, 7, 4, 5},
+    {11, 9, 10, 8, 7, 5, 6, 4}};
+
+  for (const unsigned int j : GeometryInfo<3>::vertex_indices())
+    {
+      cells[0].vertices[j] = cell_vertices_0[j];
+      cells[1].vertices[j] = cell_vertices_1[orientation][j];
+    }
+
+  triangulation.create_triangulation(vertices, cells, SubCellData());
+}
+
+
+
+template <int dim, int fe_degree>
+class MatrixFreeTest
+{
+public:
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+  using FaceEval   = FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, double>;
+
+  MatrixFreeTest(const MatrixFree<dim, double> &data,
+                 const bool                     affine_mesh,
+                 const bool                     interleaved_dofs)
+    : data(data)
+    , affine_mesh(affine_mesh)
+    , interleaved_dofs(interleaved_dofs)
+    , max_difference(0.)
+    , sum_norms(0.)
+  {}
+
+  ~MatrixFreeTest()
+  {
+    deallog << "Sum of absolute face values and derivatives: " << sum_norms
+            << std::endl;
+    deallog << "Maximum relative difference between variants: "
+            << filter_out_small_numbers(max_difference, 1e-12) << std::endl;
+  }
+
+  void
+  check_face_loop(const VectorType &src) const
+  {
+    VectorType dst;
+    data.loop(&MatrixFreeTest::local_apply,
+              &MatrixFreeTest::local_apply_face,
+              &MatrixFreeTest::local_apply_face,
+              this,
+              dst,
+              src);
+  }
+
+  void
+  check_element_centric_loop(const VectorType &src) const
+  {
+    VectorType dst;
+    data.loop_cell_centric(
+      &MatrixFreeTest::local_apply_cell_centric,
+      this,
+      dst,
+      src,
+      false,
+      MatrixFree<dim, double>::DataAccessOnFaces::values);
+  }
+
+private:
+  void
+  local_apply(const MatrixFree<dim, double> &,
+              VectorType &,
+              const VectorType &,
+              const std::pair<unsigned int, unsigned int> &) const
+  {}
+
+  // compare the result of lane v_ref at quadrature point q_ref of the
+  // reference evaluator to lane v at quadrature point q of the evaluator
+  // using gather_evaluate()
+  void
+  compare(const FaceEval &                       ref,
+          const unsigned int                     v_ref,
+          const unsigned int                     q_ref,
+          const FaceEval &                       check,
+          const unsigned int                     v,
+          const unsigned int                     q,
+          const EvaluationFlags::EvaluationFlags flags) const
+  {
+    double diff = 0, norm = 0;
+    if (flags & EvaluationFlags::values)
+      {
+        diff += std::abs(ref.get_value(q_ref)[v_ref] - check.get_value(q)[v]);
+        norm += std::abs(ref.get_value(q_ref)[v_ref]);
+      }
+    if (flags & EvaluationFlags::gradients)
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          diff += std::abs(ref.get_gradient(q_ref)[d][v_ref] -
+                           check.get_gradient(q)[d][v]);
+          norm += std::abs(ref.get_gradient(q_ref)[d][v_ref]);
+        }
+    if (flags & EvaluationFlags::hessians)
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          {
+            diff += std::abs(ref.get_hessian(q_ref)[d][e][v_ref] -
+                             check.get_hessian(q)[d][e][v]);
+            norm += std::abs(ref.get_hessian(q_ref)[d][e][v_ref]);
+          }
+    max_difference = std::max(max_difference, diff / (1. + norm));
+    sum_norms += norm;
+  }
+
+  void
+  compare(FaceEval &                             ref,
+          FaceEval &                             check,
+          const VectorType &                     src,
+          const EvaluationFlags::EvaluationFlags flags) const
+  {
+    ref.read_dof_values(src);
+    ref.evaluate(flags);
+    check.gather_evaluate(src, flags);
+
+    for (unsigned int q = 0; q < ref.n_q_points; ++q)
+      for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+        if (ref.get_cell_ids()[v] != numbers::invalid_unsigned_int)
+          compare(ref, v, q, check, v, q, flags);
+  }
+
+  static std::array<EvaluationFlags::EvaluationFlags, 3>
+  all_flags()
+  {
+    return {{EvaluationFlags::values,
+             EvaluationFlags::values | EvaluationFlags::gradients,
+             EvaluationFlags::values | EvaluationFlags::gradients |
+               EvaluationFlags::hessians}};
+  }
+
+  void
+  local_apply_face(
+    const MatrixFree<dim, double> &data,
+    VectorType &,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FaceEval ref(data, true), check(data, true);
+    FaceEval ref_ext(data, false), check_ext(data, false);
+
+    for (const auto flags : all_flags())
+      for (unsigned int face = face_range.first; face < face_range.second;
+           ++face)
+        {
+          ref.reinit(face);
+          check.reinit(face);
+          compare(ref, check, src, flags);
+          if (face < data.n_inner_face_batches())
+            {
+              ref_ext.reinit(face);
+              check_ext.reinit(face);
+              compare(ref_ext, check_ext, src, flags);
+            }
+        }
+  }
+
+  void
+  local_apply_cell_centric(
+    const MatrixFree<dim, double> &data,
+    VectorType &,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+
+    FaceEval ref(data, true), check(data, true), ref_neighbor(data, true);
+    FaceEval check_ext(data, false);
+
+    for (const auto flags : all_flags())
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        for (const unsigned int face : GeometryInfo<dim>::face_indices())
+          {
+            ref.reinit(cell, face);
+            check.reinit(cell, face);
+            compare(ref, check, src, flags);
+
+            // with contiguous indices, gather_evaluate() falls back to
+            // read_dof_values(), which does not support lanes without a
+            // neighbor on the exterior side
+            if (!interleaved_dofs)
+              continue;
+
+            // on the exterior side, the lanes can refer to different faces
+            // of the neighbors with different orientations, or to no
+            // neighbor at all, which read_dof_values() and evaluate() do not
+            // support. Instead, evaluate the neighbor from its own side and
+            // apply the orientation of the face to the quadrature points.
+            // The mapping data of the exterior side only contains the
+            // Jacobians for affine cells, so derivatives are only compared
+            // there
+            const EvaluationFlags::EvaluationFlags flags_ext =
+              affine_mesh ? (flags & (EvaluationFlags::values |
+                                      EvaluationFlags::gradients)) :
+                            EvaluationFlags::values;
+            check_ext.reinit(cell, face);
+            check_ext.gather_evaluate(src, flags_ext);
+            for (unsigned int v = 0;
+                 v < data.n_active_entries_per_cell_batch(cell);
+                 ++v)
+              {
+                const unsigned int neighbor = check_ext.get_cell_ids()[v];
+                if (neighbor == numbers::invalid_unsigned_int)
+                  continue;
+
+                ref_neighbor.reinit(neighbor / n_lanes,
+                                    check_ext.get_face_no(v));
+                ref_neighbor.read_dof_values(src);
+                ref_neighbor.evaluate(flags_ext);
+
+                const unsigned int orientation =
+                  check_ext.get_face_orientation(v);
+                for (unsigned int q = 0; q < ref.n_q_points; ++q)
+                  compare(ref_neighbor,
+                          neighbor % n_lanes,
+                          q,
+                          check_ext,
+                          v,
+                          orientation == 0 ?
+                            q :
+                            data.get_shape_info()
+                              .face_orientations_quad(orientation, q),
+                          flags_ext);
+              }
+          }
+  }
+
+  const MatrixFree<dim, double> &data;
+  const bool                     affine_mesh;
+  const bool                     interleaved_dofs;
+  mutable double                 max_difference;
+  mutable double                 sum_norms;
+};
+
+
+
+// renumber the degrees of freedom such that they are interleaved between
+// the cells of groups of n_batches cell batches, i.e., the k-th degree of
+// freedom of the j-th cell in a group gets the index k * n_cells + j
+// relative to the first index of the group. For n_batches = 1, this gives
+// the interleaved storage with a stride of the vectorization length, for
+// n_batches = 2 a stride of twice that length, which MatrixFree stores as
+// interleaved indices with mixed strides
+template <int dim>
+void
+interleave_dofs(const MatrixFree<dim, double> &data,
+                DoFHandler<dim> &              dof,
+                const unsigned int             n_batches)
+{
+  const unsigned int dofs_per_cell = dof.get_fe().n_dofs_per_cell();
+  std::vector<types::global_dof_index> renumbering(dof.n_dofs());
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  types::global_dof_index              offset = 0;
+  for (unsigned int batch = 0; batch < data.n_cell_batches();
+       batch += n_batches)
+    {
+      std::vector<typename DoFHandler<dim>::cell_iterator> cells;
+      for (unsigned int cell = batch;
+           cell < std::min(batch + n_batches, data.n_cell_batches());
+           ++cell)
+        for (unsigned int v = 0; v < data.n_active_entries_per_cell_batch(cell);
+             ++v)
+          cells.push_back(data.get_cell_iterator(cell, v));
+
+      for (unsigned int j = 0; j < cells.size(); ++j)
+        {
+          cells[j]->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            renumbering[dof_indices[i]] = offset + i * cells.size() + j;
+        }
+      offset += dofs_per_cell * cells.size();
+    }
+  dof.renumber_dofs(renumbering);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const Triangulation<dim> &tria,
+     const bool                affine_mesh,
+     const unsigned int        n_interleaved_batches)
+{
+  FE_DGQLegendre<dim> fe(fe_degree);
+  DoFHandler<dim>     dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MatrixFree<dim, double> mf_data;
+  const QGauss<1>         quad(fe_degree + 1);
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, double>::AdditionalData::none;
+  data.mapping_update_flags_inner_faces =
+    (update_gradients | update_hessians | update_JxW_values);
+  data.mapping_update_flags_boundary_faces =
+    (update_gradients | update_hessians | update_JxW_values);
+  data.mapping_update_flags_faces_by_cells =
+    (update_gradients | update_hessians | update_JxW_values);
+  data.hold_all_faces_to_owned_cells = true;
+  mf_data.reinit(MappingQ1<dim>(), dof, constraints, quad, data);
+
+  if (n_interleaved_batches > 0)
+    {
+      interleave_dofs(mf_data, dof, n_interleaved_batches);
+      mf_data.reinit(MappingQ1<dim>(), dof, constraints, quad, data);
+    }
+
+  LinearAlgebra::distributed::Vector<double> in;
+  mf_data.initialize_dof_vector(in);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    in.local_element(i) = random_value<double>();
+
+  MatrixFreeTest<dim, fe_degree> mf(mf_data,
+                                    affine_mesh,
+                                    n_interleaved_batches > 0);
+  mf.check_face_loop(in);
+  mf.check_element_centric_loop(in);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+    for (unsigned int n_batches = 0; n_batches < 3; ++n_batches)
+      {
+        deallog << "Hyper ball, interleaved batches: " << n_batches
+                << std::endl;
+        test<2, 3>(tria, false, n_batches);
+      }
+  }
+  deallog.pop();
+
+  deallog.push("3d");
+  for (unsigned int orientation = 0; orientation < 8; ++orientation)
+    {
+      Triangulation<3> tria;
+      generate_grid(tria, orientation);
+      tria.refine_global(1);
+      for (unsigned int n_batches = 0; n_batches < 3; ++n_batches)
+        {
+          deallog << "Orientation case " << orientation
+                  << ", interleaved batches: " << n_batches << std::endl;
+          test<3, 2>(tria, true, n_batches);
+        }
+    }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(1);
+    for (unsigned int n_batches = 0; n_batches < 3; ++n_batches)
+      {
+        deallog << "Hyper ball, interleaved batches: " << n_batches
+                << std::endl;
+        test<3, 3>(tria, false, n_batches);
+      }
+  }
+  deallog.pop();
+}
@@ -0,0 +1,303 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test MatrixFreeOperators::FastDiagonalizationSmoother: for DG elements on
+// an anisotropic Cartesian mesh, the smoother must apply the exact inverses
+// of the cell matrices of the mass plus interior penalty Laplace operator,
+// which are computed here with FEValues and FEFaceValues. For continuous
+// elements, check that the smoother preconditions the conjugate gradient
+// method for the Laplace operator with Dirichlet boundary conditions and
+// hanging nodes, that a Richardson iteration with the smoother reduces the
+// residual, and that the smoother is the relaxed identity on the
+// constrained degrees of freedom.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_richardson.h>
+
+#include <deal.II/matrix_free/fast_diagonalization_smoother.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+test_dg()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  Triangulation<dim> tria;
+  Point<dim>         p1, p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1. + d;
+  std::vector<unsigned int> subdivisions(dim, 3);
+  subdivisions[0] = 5;
+  GridGenerator::subdivided_hyper_rectangle(tria, subdivisions, p1, p2);
+
+  FE_DGQ<dim>     fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  const MappingQ1<dim> mapping;
+  auto                 mf_data = std::make_shared<MatrixFree<dim, Number>>();
+  mf_data->reinit(mapping, dof, constraints, QGauss<1>(fe_degree + 1));
+  const std::shared_ptr<const MatrixFree<dim, Number>> matrix_free = mf_data;
+
+  const double mass_coefficient = 2., laplace_coefficient = 0.5,
+               penalty_factor = 1.5;
+
+  MatrixFreeOperators::FastDiagonalizationSmoother<dim, fe_degree, Number>
+    smoother;
+  smoother.initialize(matrix_free,
+                      typename MatrixFreeOperators::FastDiagonalizationSmoother<
+                        dim,
+                        fe_degree,
+                        Number>::AdditionalData(1.,
+                                                mass_coefficient,
+                                                laplace_coefficient,
+                                                penalty_factor));
+
+  // all cells have the same extents
+  deallog << "Number of stored cell matrices: "
+          << smoother.n_stored_cell_matrices() << std::endl;
+
+  VectorType src, dst;
+  matrix_free->initialize_dof_vector(src);
+  matrix_free->initialize_dof_vector(dst);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<Number>();
+
+  smoother.vmult(dst, src);
+
+  const QGauss<dim>     quadrature(fe_degree + 1);
+  const QGauss<dim - 1> face_quadrature(fe_degree + 1);
+  FEValues<dim>         fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_JxW_values);
+  FEFaceValues<dim>     fe_face_values(mapping,
+                                   fe,
+                                   face_quadrature,
+                                   update_values | update_gradients |
+                                     update_normal_vectors | update_JxW_values);
+
+  const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+  LAPACKFullMatrix<double> cell_matrix(dofs_per_cell, dofs_per_cell);
+  Vector<double>           cell_src(dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+  double error = 0, norm = 0;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell_matrix = 0;
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            cell_matrix(i, j) +=
+              (mass_coefficient * fe_values.shape_value(i, q) *
+                 fe_values.shape_value(j, q) +
+               laplace_coefficient * fe_values.shape_grad(i, q) *
+                 fe_values.shape_grad(j, q)) *
+              fe_values.JxW(q);
+
+      for (const unsigned int f : cell->face_indices())
+        {
+          fe_face_values.reinit(cell, f);
+          const double sigma = penalty_factor * (fe_degree + 1) *
+                               (fe_degree + 1) /
+                               cell->extent_in_direction(f / 2);
+          for (unsigned int q = 0; q < face_quadrature.size(); ++q)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                {
+                  const Tensor<1, dim> normal =
+                    fe_face_values.normal_vector(q);
+                  cell_matrix(i, j) +=
+                    laplace_coefficient *
+                    (sigma * fe_face_values.shape_value(i, q) *
+                       fe_face_values.shape_value(j, q) -
+                     0.5 * (normal * fe_face_values.shape_grad(j, q)) *
+                       fe_face_values.shape_value(i, q) -
+                     0.5 * (normal * fe_face_values.shape_grad(i, q)) *
+                       fe_face_values.shape_value(j, q)) *
+                    fe_face_values.JxW(q);
+                }
+        }
+
+      cell->get_dof_indices(dof_indices);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        cell_src(i) = src(dof_indices[i]);
+      cell_matrix.compute_lu_factorization();
+      cell_matrix.solve(cell_src);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          error += std::abs(dst(dof_indices[i]) - cell_src(i));
+          norm += std::abs(cell_src(i));
+        }
+    }
+
+  deallog << "Error cell inverses: "
+          << (error < 1e3 * std::numeric_limits<Number>::epsilon() * norm ?
+                "ok" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+test_continuous()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  DoFTools::make_zero_boundary_constraints(dof, 0, constraints);
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  auto matrix_free = std::make_shared<MatrixFree<dim, Number>>();
+  matrix_free->reinit(MappingQ1<dim>(),
+                      dof,
+                      constraints,
+                      QGauss<1>(fe_degree + 1));
+
+  MatrixFreeOperators::LaplaceOperator<dim,
+                                       fe_degree,
+                                       fe_degree + 1,
+                                       1,
+                                       VectorType>
+    laplace;
+  laplace.initialize(matrix_free);
+
+  using SmootherType =
+    MatrixFreeOperators::FastDiagonalizationSmoother<dim, fe_degree, Number>;
+  SmootherType smoother;
+  smoother.initialize(laplace, typename SmootherType::AdditionalData(0.8));
+
+  // the cell batches on the two refinement levels share the
+  // eigendecompositions
+  deallog << "Compression of cell matrices: "
+          << (smoother.n_stored_cell_matrices() <
+                matrix_free->n_cell_batches() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+
+  VectorType rhs, solution;
+  matrix_free->initialize_dof_vector(rhs);
+  matrix_free->initialize_dof_vector(solution);
+
+  // the smoother is the relaxed identity on the constrained degrees of
+  // freedom
+  rhs = 1.;
+  smoother.vmult(solution, rhs);
+  bool identity_on_constrained = true;
+  for (const unsigned int i : matrix_free->get_constrained_dofs())
+    if (std::abs(solution.local_element(i) - Number(0.8)) > 1e-12)
+      identity_on_constrained = false;
+  deallog << "Identity on constrained dofs: "
+          << (identity_on_constrained ? "ok" : "wrong") << std::endl;
+  rhs      = 0.;
+  solution = 0.;
+
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    if (!constraints.is_constrained(i))
+      rhs.local_element(i) = random_value<Number>();
+
+  // the smoother is symmetric and positive definite and can thus
+  // precondition the conjugate gradient method
+  SolverControl          control(200, 1e-8 * rhs.l2_norm());
+  SolverCG<VectorType> solver_cg(control);
+  solver_cg.solve(laplace, solution, rhs, smoother);
+  deallog << "CG iteration converged" << std::endl;
+
+  // as a smoother, the Richardson iteration must reduce the residual
+  solution = 0.;
+  SolverControl                control_richardson(10, 0.);
+  SolverRichardson<VectorType> solver_richardson(control_richardson);
+  try
+    {
+      solver_richardson.solve(laplace, solution, rhs, smoother);
+    }
+  catch (const SolverControl::NoConvergence &)
+    {}
+  deallog << "Residual reduction in 10 Richardson iterations: "
+          << control_richardson.last_value() / rhs.l2_norm() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(2);
+
+  deallog.push("2d");
+  test_dg<2, 1, double>();
+  test_dg<2, 3, double>();
+  test_dg<2, 4, float>();
+  test_continuous<2, 2, double>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test_dg<3, 2, double>();
+  test_dg<3, 3, float>();
+  test_continuous<3, 2, double>();
+  deallog.pop();
+}
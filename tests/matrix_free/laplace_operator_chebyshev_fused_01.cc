@@ -0,0 +1,238 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check MatrixFreeOperators::Base::vmult() with operations before and after
+// the matrix-vector product on a mesh with hanging nodes and Dirichlet
+// constraints, and verify that PreconditionChebyshev around a
+// MatrixFreeOperators::LaplaceOperator, which merges the vector updates into
+// the cell loop, gives the same result as the version with separate vector
+// updates.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// A wrapper that only exposes the plain vmult() function of the operator, so
+// that PreconditionChebyshev cannot merge the vector updates into the loop
+template <typename OperatorType>
+class PlainOperator : public Subscriptor
+{
+public:
+  using value_type = typename OperatorType::value_type;
+  using size_type  = typename OperatorType::size_type;
+
+  PlainOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+  size_type
+  m() const
+  {
+    return op.m();
+  }
+
+  value_type
+  el(const size_type row, const size_type col) const
+  {
+    return op.el(row, col);
+  }
+
+  template <typename VectorType>
+  void
+  initialize_dof_vector(VectorType &vec) const
+  {
+    op.initialize_dof_vector(vec);
+  }
+
+private:
+  const OperatorType &op;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  VectorTools::interpolate_boundary_values(dof,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  std::shared_ptr<MatrixFree<dim, number>> mf_data(
+    new MatrixFree<dim, number>());
+  {
+    typename MatrixFree<dim, number>::AdditionalData data;
+    data.tasks_parallel_scheme = MatrixFree<dim, number>::AdditionalData::none;
+    mf_data->reinit(dof, constraints, QGauss<1>(fe_degree + 1), data);
+  }
+
+  using OperatorType = MatrixFreeOperators::
+    LaplaceOperator<dim, fe_degree, fe_degree + 1, 1, VectorType>;
+  OperatorType laplace;
+  laplace.initialize(mf_data);
+  laplace.compute_diagonal();
+
+  VectorType in, out, ref;
+  laplace.initialize_dof_vector(in);
+  out.reinit(in);
+  ref.reinit(in);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    in.local_element(i) = random_value<double>();
+
+  // the constrained entries of in are not zero, which checks that the
+  // treatment of constrained entries is done on the correct ranges
+  laplace.vmult(ref, in);
+
+  std::vector<unsigned int> n_before(in.locally_owned_size()),
+    n_after(in.locally_owned_size());
+  out = 1.;
+  laplace.vmult(
+    out,
+    in,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        ++n_before[i];
+    },
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          // the product must be complete on this entry
+          if (n_after[i] == 0 &&
+              std::abs(out.local_element(i) - ref.local_element(i)) > 1e-12)
+            deallog << "Entry " << i << " not final in operation after loop"
+                    << std::endl;
+          ++n_after[i];
+        }
+    });
+  out -= ref;
+  deallog << "Error vmult with operations before/after: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "ok" : "wrong")
+          << std::endl;
+  deallog << "Every entry visited once: "
+          << (*std::min_element(n_before.begin(), n_before.end()) == 1 &&
+              *std::max_element(n_before.begin(), n_before.end()) == 1 &&
+              *std::min_element(n_after.begin(), n_after.end()) == 1 &&
+              *std::max_element(n_after.begin(), n_after.end()) == 1)
+          << std::endl;
+
+  // compare the Chebyshev smoother with merged vector updates against the
+  // one operating on the plain matrix-vector product
+  using PreconditionerType = DiagonalMatrix<VectorType>;
+  PlainOperator<OperatorType> plain(laplace);
+
+  PreconditionChebyshev<OperatorType, VectorType, PreconditionerType>
+    chebyshev_fused;
+  PreconditionChebyshev<PlainOperator<OperatorType>,
+                        VectorType,
+                        PreconditionerType>
+    chebyshev_plain;
+
+  typename PreconditionChebyshev<OperatorType, VectorType, PreconditionerType>::
+    AdditionalData data;
+  data.smoothing_range     = 20.;
+  data.degree              = 5;
+  data.eig_cg_n_iterations = 15;
+  data.preconditioner      = laplace.get_matrix_diagonal_inverse();
+  chebyshev_fused.initialize(laplace, data);
+
+  typename PreconditionChebyshev<PlainOperator<OperatorType>,
+                                 VectorType,
+                                 PreconditionerType>::AdditionalData data_plain;
+  data_plain.smoothing_range     = 20.;
+  data_plain.degree              = 5;
+  data_plain.eig_cg_n_iterations = 15;
+  data_plain.preconditioner      = laplace.get_matrix_diagonal_inverse();
+  chebyshev_plain.initialize(plain, data_plain);
+
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    if (constraints.is_constrained(i))
+      in.local_element(i) = 0.;
+
+  chebyshev_fused.vmult(out, in);
+  chebyshev_plain.vmult(ref, in);
+  out -= ref;
+  deallog << "Error Chebyshev vmult: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "ok" : "wrong")
+          << std::endl;
+
+  out = 1.;
+  ref = 1.;
+  chebyshev_fused.step(out, in);
+  chebyshev_plain.step(ref, in);
+  out -= ref;
+  deallog << "Error Chebyshev step: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "ok" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 3>();
+  test<3, 2>();
+}
@@ -0,0 +1,249 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// test the MPI data exchange of block vectors in MatrixFree::loop() where all
+// blocks are sent with a single message per process, for continuous elements
+// in a cell loop and for DG elements with face integrals that only exchange a
+// subset of the ghost entries, against applying the operator to each block
+// separately
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename Number>
+class BlockOperator
+{
+public:
+  using VectorType = LinearAlgebra::distributed::BlockVector<Number>;
+
+  BlockOperator(const MatrixFree<dim, Number> &data)
+    : data(data)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    if (data.n_inner_face_batches() + data.n_boundary_face_batches() > 0)
+      data.loop(&BlockOperator::local_apply,
+                &BlockOperator::local_apply_face,
+                &BlockOperator::local_apply_boundary,
+                this,
+                dst,
+                src,
+                true,
+                MatrixFree<dim, Number>::DataAccessOnFaces::values,
+                MatrixFree<dim, Number>::DataAccessOnFaces::values);
+    else
+      data.cell_loop(&BlockOperator::local_apply, this, dst, src, true);
+  }
+
+private:
+  void
+  local_apply(const MatrixFree<dim, Number> &               data,
+              VectorType &                                  dst,
+              const VectorType &                            src,
+              const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+
+    for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+      {
+        phi.reinit(cell);
+        for (unsigned int block = 0; block < src.n_blocks(); ++block)
+          {
+            phi.gather_evaluate(src.block(block),
+                                EvaluationFlags::values |
+                                  EvaluationFlags::gradients);
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              {
+                phi.submit_value(Number(10) * phi.get_value(q), q);
+                phi.submit_gradient(phi.get_gradient(q), q);
+              }
+            phi.integrate_scatter(EvaluationFlags::values |
+                                    EvaluationFlags::gradients,
+                                  dst.block(block));
+          }
+      }
+  }
+
+  void
+  local_apply_face(
+    const MatrixFree<dim, Number> &               data,
+    VectorType &                                  dst,
+    const VectorType &                            src,
+    const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_m(data,
+                                                                     true);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_p(data,
+                                                                     false);
+
+    for (unsigned int face = face_range.first; face < face_range.second;
+         ++face)
+      {
+        phi_m.reinit(face);
+        phi_p.reinit(face);
+        for (unsigned int block = 0; block < src.n_blocks(); ++block)
+          {
+            phi_m.gather_evaluate(src.block(block), EvaluationFlags::values);
+            phi_p.gather_evaluate(src.block(block), EvaluationFlags::values);
+            for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+              {
+                const VectorizedArray<Number> jump =
+                  phi_m.get_value(q) - phi_p.get_value(q);
+                phi_m.submit_value(jump, q);
+                phi_p.submit_value(-jump, q);
+              }
+            phi_m.integrate_scatter(EvaluationFlags::values,
+                                    dst.block(block));
+            phi_p.integrate_scatter(EvaluationFlags::values,
+                                    dst.block(block));
+          }
+      }
+  }
+
+  void
+  local_apply_boundary(const MatrixFree<dim, Number> &,
+                       VectorType &,
+                       const VectorType &,
+                       const std::pair<unsigned int, unsigned int> &) const
+  {}
+
+  const MatrixFree<dim, Number> &data;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test(const FiniteElement<dim> &fe)
+{
+  using number = double;
+
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned() && cell->center().norm() < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  IndexSet relevant_set;
+  DoFTools::extract_locally_relevant_dofs(dof, relevant_set);
+  AffineConstraints<double> constraints(relevant_set);
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  MatrixFree<dim, number> mf_data;
+  {
+    typename MatrixFree<dim, number>::AdditionalData data;
+    data.tasks_parallel_scheme = MatrixFree<dim, number>::AdditionalData::none;
+    if (fe.n_dofs_per_vertex() == 0)
+      data.mapping_update_flags_inner_faces = update_values | update_JxW_values;
+    mf_data.reinit(
+      MappingQ1<dim>(), dof, constraints, QGauss<1>(fe_degree + 1), data);
+  }
+
+  BlockOperator<dim, fe_degree, number> op(mf_data);
+
+  // use more blocks than BlockVector::communication_block_size, where the
+  // blocks were previously exchanged without overlap
+  for (const unsigned int n_blocks : {3U, 30U})
+    {
+      LinearAlgebra::distributed::BlockVector<number> in(n_blocks), out, ref;
+      for (unsigned int block = 0; block < n_blocks; ++block)
+        {
+          mf_data.initialize_dof_vector(in.block(block));
+          for (unsigned int i = 0; i < in.block(block).locally_owned_size();
+               ++i)
+            in.block(block).local_element(i) = random_value<number>();
+          constraints.set_zero(in.block(block));
+        }
+      in.collect_sizes();
+      out.reinit(in);
+      ref.reinit(in);
+
+      // reference: apply the operator to one block at a time
+      for (unsigned int block = 0; block < n_blocks; ++block)
+        {
+          LinearAlgebra::distributed::BlockVector<number> in_block(1),
+            ref_block(1);
+          in_block.block(0).reinit(in.block(block));
+          in_block.block(0) = in.block(block);
+          ref_block.block(0).reinit(in.block(block));
+          in_block.collect_sizes();
+          ref_block.collect_sizes();
+          op.vmult(ref_block, in_block);
+          ref.block(block) = ref_block.block(0);
+        }
+
+      op.vmult(out, in);
+
+      deallog << "Ghosts zeroed after loop: "
+              << (in.has_ghost_elements() == false) << std::endl;
+
+      out -= ref;
+      deallog << "Error with " << n_blocks << " blocks: "
+              << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "ok" :
+                                                                   "wrong")
+              << std::endl;
+    }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  mpi_initlog();
+
+  deallog.push("2d");
+  test<2, 2>(FE_Q<2>(2));
+  test<2, 2>(FE_DGQ<2>(2));
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3, 1>(FE_Q<3>(1));
+  test<3, 2>(FE_DGQ<3>(2));
+  deallog.pop();
+}
@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check FEPointEvaluation with many points per cell (not a multiple of the
+// vectorization width) for several calls to evaluate() and integrate() after
+// a single reinit(), which re-use the 1D polynomials computed in reinit(),
+// against FEValues
+
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+
+template <int dim, typename Number>
+void
+test(const unsigned int degree, const unsigned int n_points)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1, 6);
+
+  MappingQ<dim> mapping(2);
+  FE_Q<dim>     fe(degree);
+
+  deallog << "Testing " << fe.get_name() << " with " << n_points
+          << " points, Number=" << (std::is_same<Number, float>::value ?
+                                      "float" :
+                                      "double")
+          << std::endl;
+
+  std::vector<Point<dim>> unit_points(n_points);
+  for (Point<dim> &p : unit_points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = random_value<double>();
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          Quadrature<dim>(unit_points),
+                          update_values | update_gradients);
+
+  FEPointEvaluation<1, dim, dim, Number> evaluator(mapping,
+                                                   fe,
+                                                   update_values |
+                                                     update_gradients);
+
+  std::vector<Number> solution_values(fe.dofs_per_cell);
+  std::vector<Number> integrated_values(fe.dofs_per_cell);
+
+  double error_evaluate = 0, norm_evaluate = 0;
+  double error_integrate = 0, norm_integrate = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      evaluator.reinit(cell, unit_points);
+
+      // several evaluations on the same points
+      for (unsigned int run = 0; run < 3; ++run)
+        {
+          for (Number &v : solution_values)
+            v = random_value<Number>();
+
+          evaluator.evaluate(solution_values,
+                             EvaluationFlags::values |
+                               EvaluationFlags::gradients);
+
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              double         value = 0;
+              Tensor<1, dim> gradient;
+              for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                {
+                  value += fe_values.shape_value(i, q) * solution_values[i];
+                  gradient += fe_values.shape_grad(i, q) * solution_values[i];
+                }
+              error_evaluate += std::abs(evaluator.get_value(q) - value);
+              norm_evaluate += std::abs(value);
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  error_evaluate +=
+                    std::abs(evaluator.get_gradient(q)[d] - gradient[d]);
+                  norm_evaluate += std::abs(gradient[d]);
+                }
+            }
+
+          // submit some values and gradients and integrate
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              evaluator.submit_value(evaluator.get_value(q) * Number(q + 1),
+                                     q);
+              evaluator.submit_gradient(evaluator.get_gradient(q), q);
+            }
+          std::vector<Tensor<1, dim, Number>> submitted_gradients(n_points);
+          std::vector<Number>                 submitted_values(n_points);
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              submitted_values[q]    = evaluator.get_value(q);
+              submitted_gradients[q] = evaluator.get_gradient(q);
+            }
+
+          evaluator.integrate(integrated_values,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              double result = 0;
+              for (unsigned int q = 0; q < n_points; ++q)
+                result +=
+                  fe_values.shape_value(i, q) * submitted_values[q] +
+                  fe_values.shape_grad(i, q) * submitted_gradients[q];
+              error_integrate += std::abs(integrated_values[i] - result);
+              norm_integrate += std::abs(result);
+            }
+        }
+    }
+
+  const double tolerance = 100. * std::numeric_limits<Number>::epsilon();
+  deallog << "Error evaluate:  "
+          << (error_evaluate < tolerance * norm_evaluate ? "ok" : "wrong")
+          << std::endl;
+  deallog << "Error integrate: "
+          << (error_integrate < tolerance * norm_integrate ? "ok" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, double>(1, 37);
+  test<2, double>(3, 101);
+  test<2, float>(4, 29);
+  test<3, double>(2, 53);
+  test<3, float>(3, 77);
+}
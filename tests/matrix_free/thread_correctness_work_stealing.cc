@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// this function tests the correctness of the work stealing scheduler of the
+// matrix-free loop with cell, face and boundary integrals against the serial
+// loop. Several sweeps are performed to also run with the priorities
+// computed from the measured times of the previous loops.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include "../tests.h"
+
+#include "matrix_vector_faces_common.h"
+
+
+template <int dim, int fe_degree, typename number>
+void
+sub_test()
+{
+  // use a Cartesian mesh: on deformed cells, the penalty parameter of the
+  // test operator depends on which cell of a face is the interior one, which
+  // differs between the layouts of the two MatrixFree objects
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  tria.refine_global(1);
+
+  FE_DGQ<dim>     fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  // run test for several different meshes
+  for (unsigned int i = 0; i < 5 - dim; ++i)
+    {
+      unsigned int counter = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (counter++ % (9 - i) == 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+
+      dof.distribute_dofs(fe);
+      AffineConstraints<double> constraints;
+      constraints.close();
+
+      MatrixFree<dim, number> mf_data, mf_data_stealing;
+      {
+        const QGauss<1> quad(fe_degree + 1);
+        typename MatrixFree<dim, number>::AdditionalData data;
+        data.tasks_parallel_scheme =
+          MatrixFree<dim, number>::AdditionalData::none;
+        data.mapping_update_flags_inner_faces =
+          (update_gradients | update_JxW_values);
+        data.mapping_update_flags_boundary_faces =
+          (update_gradients | update_JxW_values);
+        mf_data.reinit(dof, constraints, quad, data);
+
+        // choose block size of 3 which introduces some irregularity to the
+        // blocks
+        data.tasks_parallel_scheme =
+          MatrixFree<dim, number>::AdditionalData::work_stealing;
+        data.tasks_block_size = 3;
+        mf_data_stealing.reinit(dof, constraints, quad, data);
+      }
+      // the scheme falls back to serial execution with a single thread
+      deallog << "Scheme as expected: "
+              << (mf_data_stealing.get_task_info().scheme ==
+                  (MultithreadInfo::n_threads() > 1 ?
+                     internal::MatrixFreeFunctions::TaskInfo::work_stealing :
+                     internal::MatrixFreeFunctions::TaskInfo::none))
+              << std::endl;
+
+      MatrixFreeTest<dim, fe_degree, fe_degree + 1, number> mf_ref(mf_data);
+      MatrixFreeTest<dim, fe_degree, fe_degree + 1, number> mf_stealing(
+        mf_data_stealing);
+      Vector<number> in_dist(dof.n_dofs());
+      Vector<number> out_dist(in_dist), out_stealing(in_dist);
+
+      for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+        in_dist(i) = random_value<number>();
+
+      mf_ref.vmult(out_dist, in_dist);
+
+      // make 5 sweeps in order to get in some variation to the threaded
+      // program and to use the priorities from the measured times
+      double max_error = 0;
+      for (unsigned int sweep = 0; sweep < 5; ++sweep)
+        {
+          mf_stealing.vmult(out_stealing, in_dist);
+          out_stealing -= out_dist;
+          max_error = std::max<double>(max_error, out_stealing.linfty_norm());
+        }
+      deallog << "Error work stealing vs serial: "
+              << (max_error < 1000. * std::numeric_limits<number>::epsilon() *
+                                out_dist.linfty_norm() ?
+                    "ok" :
+                    "wrong")
+              << std::endl;
+    }
+  deallog << std::endl;
+}
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  deallog << "Test doubles" << std::endl;
+  sub_test<dim, fe_degree, double>();
+  deallog << "Test floats" << std::endl;
+  sub_test<dim, fe_degree, float>();
+}
@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that measures the number of instructions for the
+// sum-factorization kernels with sizes only known at run time, comparing
+// the general variant with the even-odd decomposition. The kernels
+// interpolate the values and gradients of a 3D DG element of degree k to
+// 2k quadrature points per direction (over-integration) and perform the
+// transpose operation, as done by FEEvaluation::evaluate() and
+// FEEvaluation::integrate() for a polynomial degree that is not
+// pre-compiled.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include "performance_test_driver.h"
+#include "valgrind_instrumentation.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+constexpr unsigned int n_cell_batches = 100;
+
+
+template <internal::EvaluatorVariant variant>
+std::uint64_t
+run_kernels(const unsigned int degree)
+{
+  using Number = VectorizedArray<double>;
+  using Eval =
+    internal::EvaluatorTensorProduct<variant, 3, 0, 0, Number, double>;
+
+  const unsigned int n_q_points_1d = 2 * degree;
+  // the univariate shape data is the same for all dimensions
+  const QGauss<1>                                  quadrature(n_q_points_1d);
+  const FE_DGQ<1>                                  fe(degree);
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info(quadrature, fe);
+  const auto &data = shape_info.data.front();
+
+  const bool use_eo = (variant == internal::evaluate_evenodd);
+  const Eval eval(use_eo ? data.shape_values_eo : data.shape_values,
+                  use_eo ? data.shape_gradients_eo : data.shape_gradients,
+                  AlignedVector<double>(),
+                  degree + 1,
+                  n_q_points_1d);
+
+  const unsigned int n_dofs = Utilities::pow(degree + 1, 3);
+  const unsigned int n_q    = Utilities::pow(n_q_points_1d, 3);
+  AlignedVector<Number> dofs(n_dofs), values(n_q), gradients(3 * n_q),
+    tmp1(n_q), tmp2(n_q);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    dofs[i] = 1. / (i + 1);
+
+  CallgrindWrapper::start_instrumentation();
+  for (unsigned int cell = 0; cell < n_cell_batches; ++cell)
+    {
+      // evaluate values and gradients
+      eval.template values<0, true, false>(dofs.data(), tmp1.data());
+      eval.template values<1, true, false>(tmp1.data(), tmp2.data());
+      eval.template values<2, true, false>(tmp2.data(), values.data());
+      eval.template gradients<2, true, false>(tmp2.data(),
+                                              gradients.data() + 2 * n_q);
+      eval.template gradients<1, true, false>(tmp1.data(), tmp2.data());
+      eval.template values<2, true, false>(tmp2.data(),
+                                           gradients.data() + n_q);
+      eval.template gradients<0, true, false>(dofs.data(), tmp1.data());
+      eval.template values<1, true, false>(tmp1.data(), tmp2.data());
+      eval.template values<2, true, false>(tmp2.data(), gradients.data());
+
+      // integrate values and gradients
+      eval.template values<2, false, false>(values.data(), tmp1.data());
+      eval.template gradients<2, false, true>(gradients.data() + 2 * n_q,
+                                              tmp1.data());
+      eval.template values<1, false, false>(tmp1.data(), tmp2.data());
+      eval.template values<2, false, false>(gradients.data() + n_q,
+                                            tmp1.data());
+      eval.template gradients<1, false, true>(tmp1.data(), tmp2.data());
+      eval.template values<0, false, false>(tmp2.data(), dofs.data());
+      eval.template values<2, false, false>(gradients.data(), tmp1.data());
+      eval.template values<1, false, false>(tmp1.data(), tmp2.data());
+      eval.template gradients<0, false, true>(tmp2.data(), dofs.data());
+    }
+  const std::uint64_t count = CallgrindWrapper::stop_instrumentation();
+
+  debug_output << "degree " << degree << ": " << dofs[0][0] << std::endl;
+
+  return count;
+}
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::instruction_count,
+          1,
+          {"general_k3",
+           "evenodd_k3",
+           "general_k5",
+           "evenodd_k5",
+           "general_k7",
+           "evenodd_k7"}};
+}
+
+
+Measurement
+perform_single_measurement()
+{
+  return {run_kernels<internal::evaluate_general>(3),
+          run_kernels<internal::evaluate_evenodd>(3),
+          run_kernels<internal::evaluate_general>(5),
+          run_kernels<internal::evaluate_evenodd>(5),
+          run_kernels<internal::evaluate_general>(7),
+          run_kernels<internal::evaluate_evenodd>(7)};
+}
@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that measures the time to compute the values and
+// gradients on the inner faces of a 3D DG discretization with a basis that
+// is not nodal at the cell boundaries (FE_DGQLegendre), for polynomial
+// degrees 2 to 8. It compares FEFaceEvaluation::gather_evaluate(), which
+// interpolates the vector entries to the face while reading them, with
+// FEFaceEvaluation::read_dof_values() followed by
+// FEFaceEvaluation::evaluate(), which first copies all degrees of freedom
+// of the cell to a local array.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+constexpr unsigned int dim = 3;
+
+
+template <int fe_degree>
+std::pair<double, double>
+run_degree()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  // choose the mesh size such that the number of unknowns is roughly the
+  // same for all degrees
+  const types::global_dof_index n_dofs_target =
+    get_testing_environment() == TestingEnvironment::light ? 1000000 :
+                                                             4000000;
+  const unsigned int n_subdivisions = std::max<unsigned int>(
+    2,
+    static_cast<unsigned int>(std::cbrt(static_cast<double>(n_dofs_target)) /
+                              (fe_degree + 1)));
+
+  Triangulation<dim> triangulation;
+  GridGenerator::subdivided_hyper_cube(triangulation, n_subdivisions);
+
+  FE_DGQLegendre<dim> fe(fe_degree);
+  DoFHandler<dim>     dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::none;
+  additional_data.mapping_update_flags_inner_faces =
+    update_gradients | update_JxW_values;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  VectorType src;
+  matrix_free.initialize_dof_vector(src);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = 1. / (i + 1);
+
+  debug_output << "Degree " << fe_degree << ": " << dof_handler.n_dofs()
+               << " degrees of freedom" << std::endl;
+
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, double> phi_m(matrix_free,
+                                                                    true);
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, double> phi_p(matrix_free,
+                                                                    false);
+
+  constexpr unsigned int n_sweeps = 5;
+  const auto             flags =
+    EvaluationFlags::values | EvaluationFlags::gradients;
+
+  // sum up the computed values to keep the compiler from removing the
+  // evaluation
+  VectorizedArray<double> sum = 0.;
+  const auto              accumulate = [&]() {
+    for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+      sum += phi_m.get_value(q) - phi_p.get_normal_derivative(q);
+  };
+
+  Timer timer;
+  for (unsigned int sweep = 0; sweep < n_sweeps; ++sweep)
+    for (unsigned int face = 0; face < matrix_free.n_inner_face_batches();
+         ++face)
+      {
+        phi_m.reinit(face);
+        phi_m.read_dof_values(src);
+        phi_m.evaluate(flags);
+        phi_p.reinit(face);
+        phi_p.read_dof_values(src);
+        phi_p.evaluate(flags);
+        accumulate();
+      }
+  const double time_read_evaluate = timer.wall_time();
+
+  timer.restart();
+  for (unsigned int sweep = 0; sweep < n_sweeps; ++sweep)
+    for (unsigned int face = 0; face < matrix_free.n_inner_face_batches();
+         ++face)
+      {
+        phi_m.reinit(face);
+        phi_m.gather_evaluate(src, flags);
+        phi_p.reinit(face);
+        phi_p.gather_evaluate(src, flags);
+        accumulate();
+      }
+  const double time_gather_evaluate = timer.wall_time();
+
+  debug_output << "Sum: " << sum[0] << std::endl;
+
+  return {time_read_evaluate, time_gather_evaluate};
+}
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  std::vector<std::string> names;
+  for (unsigned int degree = 2; degree <= 8; ++degree)
+    {
+      names.emplace_back("read_evaluate_k" + std::to_string(degree));
+      names.emplace_back("gather_evaluate_k" + std::to_string(degree));
+    }
+  return {Metric::timing, 4, names};
+}
+
+
+Measurement
+perform_single_measurement()
+{
+  const auto k2 = run_degree<2>();
+  const auto k3 = run_degree<3>();
+  const auto k4 = run_degree<4>();
+  const auto k5 = run_degree<5>();
+  const auto k6 = run_degree<6>();
+  const auto k7 = run_degree<7>();
+  const auto k8 = run_degree<8>();
+
+  return {k2.first,
+          k2.second,
+          k3.first,
+          k3.second,
+          k4.first,
+          k4.second,
+          k5.first,
+          k5.second,
+          k6.first,
+          k6.second,
+          k7.first,
+          k7.second,
+          k8.first,
+          k8.second};
+}
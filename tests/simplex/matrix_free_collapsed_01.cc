@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check QStroudSimplex and QStroudWedge, and the evaluation of gradients by
+// sum factorization in collapsed coordinates in FEEvaluation for simplex and
+// wedge elements, comparing against FEValues
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_wedge_p.h>
+#include <deal.II/fe/mapping_fe.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+#include "./simplex_grids.h"
+
+
+
+template <int dim>
+void
+check_quadrature(const unsigned int n_points_1d)
+{
+  // integrate all monomials up to degree 2n-1 on the reference simplex,
+  // where the integral of x^i y^j z^k is i! j! k! / (i+j+k+dim)!
+  const QStroudSimplex<dim> quad(n_points_1d);
+  const auto factorial = [](const unsigned int n) {
+    double result = 1.;
+    for (unsigned int i = 2; i <= n; ++i)
+      result *= i;
+    return result;
+  };
+
+  double             error  = 0;
+  const unsigned int degree = 2 * n_points_1d - 1;
+  const unsigned int max_k  = (dim == 3 ? degree : 0);
+  for (unsigned int i = 0; i <= degree; ++i)
+    for (unsigned int j = 0; i + j <= degree; ++j)
+      for (unsigned int k = 0; k <= max_k && i + j + k <= degree; ++k)
+        {
+          double sum = 0;
+          for (unsigned int q = 0; q < quad.size(); ++q)
+            {
+              const Point<dim> &p = quad.point(q);
+              sum += std::pow(p[0], i) * std::pow(p[1], j) *
+                     (dim == 3 ? std::pow(p[dim - 1], k) : 1.) *
+                     quad.weight(q);
+            }
+          error += std::abs(sum - factorial(i) * factorial(j) * factorial(k) /
+                                    factorial(i + j + k + dim));
+        }
+
+  deallog << "QStroudSimplex<" << dim << ">(" << n_points_1d
+          << "): " << quad.size() << " points, "
+          << (error < 1e-13 ? "exact" : "inexact") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const Triangulation<dim> & tria,
+     const FiniteElement<dim> & fe,
+     const Quadrature<dim> &    quad,
+     const FiniteElement<dim> & fe_mapping)
+{
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  const MappingFE<dim> mapping(fe_mapping);
+  DoFHandler<dim>      dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MatrixFree<dim, double>                          matrix_free;
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+  matrix_free.reinit(mapping, dof, constraints, quad, additional_data);
+
+  deallog << "Collapsed points per direction: "
+          << matrix_free.get_shape_info().n_q_points_1d_collapsed << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> src, dst, dst_ref;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  matrix_free.initialize_dof_vector(dst_ref);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quad,
+                          update_values | update_gradients |
+                            update_JxW_values);
+  std::vector<Tensor<1, dim>> gradients(quad.size());
+  std::vector<double>         values(quad.size());
+  Vector<double>              local_vector(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  // the test of the gradients only evaluates the gradients, whereas the
+  // integration test combines values and gradients
+  FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free);
+  double                              error_gradients = 0, norm = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      phi.evaluate(EvaluationFlags::gradients);
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          fe_values.reinit(matrix_free.get_cell_iterator(cell, v));
+          fe_values.get_function_gradients(src, gradients);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                error_gradients +=
+                  std::abs(phi.get_gradient(q)[d][v] - gradients[q][d]);
+                norm += std::abs(gradients[q][d]);
+              }
+        }
+
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        {
+          phi.submit_value(phi.get_value(q), q);
+          phi.submit_gradient(phi.get_gradient(q), q);
+        }
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+      phi.distribute_local_to_global(dst);
+    }
+
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(src, values);
+      fe_values.get_function_gradients(src, gradients);
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          double sum = 0;
+          for (unsigned int q = 0; q < quad.size(); ++q)
+            sum += (fe_values.shape_value(i, q) * values[q] +
+                    fe_values.shape_grad(i, q) * gradients[q]) *
+                   fe_values.JxW(q);
+          local_vector(i) = sum;
+        }
+      cell->get_dof_indices(dof_indices);
+      constraints.distribute_local_to_global(local_vector,
+                                             dof_indices,
+                                             dst_ref);
+    }
+
+  deallog << "Error gradients: "
+          << (error_gradients < 1e-12 * norm ? "ok" : "wrong") << std::endl;
+
+  dst -= dst_ref;
+  deallog << "Error integration: "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm() ? "ok" :
+                                                                   "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check_quadrature<2>(1);
+  check_quadrature<2>(3);
+  check_quadrature<3>(2);
+  check_quadrature<3>(4);
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 3);
+    GridTools::distort_random(0.2, tria);
+    test(tria, FE_SimplexP<2>(2), QStroudSimplex<2>(3), FE_SimplexP<2>(1));
+    test(tria, FE_SimplexDGP<2>(2), QStroudSimplex<2>(4), FE_SimplexP<2>(1));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+    GridTools::distort_random(0.2, tria);
+    test(tria, FE_SimplexP<3>(2), QStroudSimplex<3>(3), FE_SimplexP<3>(1));
+    test(tria, FE_SimplexDGP<3>(1), QStroudSimplex<3>(2), FE_SimplexP<3>(1));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_wedges(tria, 2);
+    GridTools::distort_random(0.2, tria);
+    test(tria, FE_WedgeP<3>(2), QStroudWedge<3>(3), FE_WedgeP<3>(1));
+  }
+  {
+    // QGaussSimplex is no tensor product in collapsed coordinates, so the
+    // general path must be selected
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+    test(tria, FE_SimplexP<3>(2), QGaussSimplex<3>(3), FE_SimplexP<3>(1));
+  }
+}
@@ -0,0 +1,90 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// SparsityPattern::copy_from(DynamicSparsityPattern) and
+// SparsityPattern::compress() work on row ranges in parallel. Check that the
+// result for a pattern large enough to be split into many ranges is the same
+// as the one from adding the entries one by one, both for square and
+// rectangular patterns and for a DynamicSparsityPattern storing only a
+// subset of the rows.
+
+#include <deal.II/base/index_set.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+void
+check(const unsigned int n_rows,
+      const unsigned int n_cols,
+      const bool         use_row_subset)
+{
+  IndexSet rows(n_rows);
+  if (use_row_subset)
+    rows.add_range(n_rows / 4, 3 * n_rows / 4);
+  else
+    rows.add_range(0, n_rows);
+
+  DynamicSparsityPattern    dsp(n_rows, n_cols, rows);
+  std::vector<unsigned int> row_lengths(n_rows, 1);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    if (rows.is_element(row))
+      for (unsigned int j = 0; j < row % 13; ++j)
+        {
+          dsp.add(row, Testing::rand() % n_cols);
+          ++row_lengths[row];
+        }
+
+  SparsityPattern sp1;
+  sp1.copy_from(dsp);
+
+  SparsityPattern sp2(n_rows, n_cols, row_lengths);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    if (rows.is_element(row))
+      for (unsigned int j = 0; j < dsp.row_length(row); ++j)
+        sp2.add(row, dsp.column_number(row, j));
+  sp2.compress();
+
+  AssertThrow(sp1.n_nonzero_elements() == sp2.n_nonzero_elements(),
+              ExcInternalError());
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      AssertThrow(sp1.row_length(row) == sp2.row_length(row),
+                  ExcInternalError());
+      for (unsigned int j = 0; j < sp1.row_length(row); ++j)
+        AssertThrow(sp1.column_number(row, j) == sp2.column_number(row, j),
+                    ExcInternalError());
+    }
+
+  deallog << n_rows << 'x' << n_cols << " subset=" << use_row_subset
+          << " nnz=" << sp1.n_nonzero_elements() << " OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check(20000, 20000, false);
+  check(20000, 20000, true);
+  check(20000, 500, false);
+  check(20000, 500, true);
+}